@@ -0,0 +1,120 @@
+/* Measures the image decoder: decoding a file, serving it from the cache and a working set
+ * larger than the cache.
+ *
+ *   lvgl_raylib_decoder_bench [size]
+ *
+ * The PNG files are generated into the working directory first, size x size pixels each
+ * (512 by default). The cache is set to hold half of them for the last run, which opens
+ * them in a random but repeatable order and reports the hit rate. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_BENCH_FILES    8
+#define LVGL_RAYLIB_BENCH_SIZE     512
+#define LVGL_RAYLIB_BENCH_COLD     16
+#define LVGL_RAYLIB_BENCH_WARM     100000
+#define LVGL_RAYLIB_BENCH_MIXED    2000
+
+/* private prototypes */
+
+static bool open_image(const char * src);
+static void print_stats(const char * name, double s, uint32_t cnt);
+
+/* static variables */
+
+static char _paths[LVGL_RAYLIB_BENCH_FILES][32];
+static char _srcs[LVGL_RAYLIB_BENCH_FILES][36];
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    int size = argc > 1 ? atoi(argv[1]) : LVGL_RAYLIB_BENCH_SIZE;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "lvgl_raylib_decoder_bench");
+    lvgl_raylib_init(320, 240);
+
+    // Noise compresses poorly, the decode time is close to a photo's
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_FILES; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "lvgl_raylib_bench_%d.png", i);
+        snprintf(_srcs[i], sizeof(_srcs[i]), "%c:%s", LVGL_RAYLIB_FS_LETTER, _paths[i]);
+        Image image = GenImagePerlinNoise(size, size, i * size, 0, 4.0f);
+        bool ok = ExportImage(image, _paths[i]);
+        UnloadImage(image);
+        if (!ok) {
+            printf("failed to write %s\n", _paths[i]);
+            return 1;
+        }
+    }
+
+    double start = GetTime();
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_COLD; i++) {
+        lvgl_raylib_decoder_drop(_srcs[0]);
+        open_image(_srcs[0]);
+    }
+    print_stats("cold", GetTime() - start, LVGL_RAYLIB_BENCH_COLD);
+
+    start = GetTime();
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_WARM; i++) {
+        open_image(_srcs[0]);
+    }
+    print_stats("warm", GetTime() - start, LVGL_RAYLIB_BENCH_WARM);
+
+    lvgl_raylib_decoder_drop(NULL);
+    lvgl_raylib_decoder_set_cache_size((uint32_t)size * (uint32_t)size * 4 * LVGL_RAYLIB_BENCH_FILES / 2);
+    uint32_t state = 1;
+    start = GetTime();
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_MIXED; i++) {
+        state = state * 1664525u + 1013904223u;
+        open_image(_srcs[(state >> 16) % LVGL_RAYLIB_BENCH_FILES]);
+    }
+    print_stats("mixed", GetTime() - start, LVGL_RAYLIB_BENCH_MIXED);
+
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_FILES; i++) {
+        remove(_paths[i]);
+    }
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool open_image(const char * src)
+{
+    // What lv_image does for every draw: header, open, close
+    lv_image_header_t header;
+    if (lv_image_decoder_get_info(src, &header) != LV_RESULT_OK) {
+        return false;
+    }
+    lv_image_decoder_dsc_t dsc;
+    if (lv_image_decoder_open(&dsc, src, NULL) != LV_RESULT_OK) {
+        return false;
+    }
+    lv_image_decoder_close(&dsc);
+    return true;
+}
+
+static void print_stats(const char * name, double s, uint32_t cnt)
+{
+    static lvgl_raylib_decoder_stats_t last = {0};
+    lvgl_raylib_decoder_stats_t stats;
+    lvgl_raylib_decoder_get_stats(&stats);
+    uint32_t hits = stats.hits - last.hits;
+    uint32_t misses = stats.misses - last.misses;
+    printf("%-6s %10.3f ms per open, %u hits, %u misses (%.1f%%), %u evictions, %.2f ms per decode\n",
+           name, s * 1000.0 / cnt, hits, misses, hits + misses > 0 ? hits * 100.0 / (hits + misses) : 0.0,
+           stats.evictions - last.evictions,
+           stats.decodes > last.decodes ? (stats.decode_ms_total - last.decode_ms_total) / (stats.decodes - last.decodes) : 0.0f);
+    last = stats;
+}
@@ -0,0 +1,106 @@
+/* Measures the TTF glyph cache: rasterizing glyphs on first use and serving them afterwards.
+ *
+ *   lvgl_raylib_font_bench <font.ttf> [size]
+ *
+ * Every run looks up the glyphs the way a label draws them, descriptor then bitmap then
+ * release. "cold" empties the cache before each pass, "warm" keeps it, "thrash" makes the
+ * cache hold about half of the glyphs so every pass evicts. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_BENCH_SIZE     18
+#define LVGL_RAYLIB_BENCH_FIRST    0x20       // printable ASCII and Latin-1
+#define LVGL_RAYLIB_BENCH_LAST     0xff
+#define LVGL_RAYLIB_BENCH_PASSES   200
+
+/* private prototypes */
+
+static uint32_t draw_glyphs(const lv_font_t * font);
+static void run(const char * name, const lv_font_t * font, bool cold);
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    if (argc < 2) {
+        printf("usage: %s <font.ttf> [size]\n", argv[0]);
+        return 1;
+    }
+    int32_t size = argc > 2 ? atoi(argv[2]) : LVGL_RAYLIB_BENCH_SIZE;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "lvgl_raylib_font_bench");
+    lvgl_raylib_init(320, 240);
+
+    lv_font_t * font = lvgl_raylib_font_create(argv[1], size);
+    if (font == NULL) {
+        printf("failed to load %s\n", argv[1]);
+        return 1;
+    }
+
+    run("cold", font, true);
+    run("warm", font, false);
+
+    lvgl_raylib_font_stats_t stats;
+    lvgl_raylib_font_get_stats(&stats);
+    lvgl_raylib_font_set_cache_size(stats.size / 2);
+    run("thrash", font, false);
+
+    lvgl_raylib_font_delete(font);
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static uint32_t draw_glyphs(const lv_font_t * font)
+{
+    uint32_t cnt = 0;
+    for (uint32_t letter = LVGL_RAYLIB_BENCH_FIRST; letter <= LVGL_RAYLIB_BENCH_LAST; letter++) {
+        lv_font_glyph_dsc_t dsc;
+        if (!lv_font_get_glyph_dsc(font, &dsc, letter, letter + 1)) {
+            continue;
+        }
+        if (lv_font_get_glyph_bitmap(&dsc, NULL) != NULL) {
+            lv_font_glyph_release_draw_data(&dsc);
+        }
+        cnt++;
+    }
+    return cnt;
+}
+
+static void run(const char * name, const lv_font_t * font, bool cold)
+{
+    lvgl_raylib_font_stats_t before;
+    lvgl_raylib_font_get_stats(&before);
+    uint32_t max_size = before.max_size;
+
+    double start = GetTime();
+    uint32_t cnt = 0;
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_PASSES; i++) {
+        if (cold) {
+            lvgl_raylib_font_set_cache_size(0);
+            lvgl_raylib_font_set_cache_size(max_size);
+        }
+        cnt += draw_glyphs(font);
+    }
+    double s = GetTime() - start;
+
+    lvgl_raylib_font_stats_t stats;
+    lvgl_raylib_font_get_stats(&stats);
+    uint32_t hits = stats.hits - before.hits;
+    uint32_t misses = stats.misses - before.misses;
+    printf("%-6s %8.3f us per glyph, %u hits, %u misses, %u evictions, %.3f ms per raster, %u KB cached\n",
+           name, s * 1e6 / (cnt > 0 ? cnt : 1), hits, misses, stats.evictions - before.evictions,
+           misses > 0 ? (stats.raster_ms_total - before.raster_ms_total) / misses : 0.0f, stats.size / 1024);
+}
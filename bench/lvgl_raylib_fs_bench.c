@@ -0,0 +1,139 @@
+/* Compares the mapped file drive with LVGL's stdio driver: opening a file and reading it.
+ *
+ *   lvgl_raylib_fs_bench [megabytes]
+ *
+ * A file of random bytes is generated into the working directory first (16 MB by default).
+ * Opens are timed as open + close of the same file, what the image decoder does for a
+ * header. Reads go through lv_fs_read() in 64 KB chunks on both drives; the mapped drive
+ * is also read through lvgl_raylib_fs_get_data(), the zero-copy path its users take. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_BENCH_PATH   "lvgl_raylib_bench.bin"
+#define LVGL_RAYLIB_BENCH_MB     16
+#define LVGL_RAYLIB_BENCH_CHUNK  (64 * 1024)
+#define LVGL_RAYLIB_BENCH_OPENS  10000
+#define LVGL_RAYLIB_BENCH_PASSES 8
+
+/* private prototypes */
+
+static void bench_drive(const char * name, char letter, bool zero_copy);
+static uint32_t checksum(const uint8_t * data, uint32_t size);
+
+/* static variables */
+
+static uint8_t _chunk[LVGL_RAYLIB_BENCH_CHUNK];
+static uint32_t _size;
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    int mb = argc > 1 ? atoi(argv[1]) : LVGL_RAYLIB_BENCH_MB;
+    _size = (uint32_t)(mb > 0 ? mb : LVGL_RAYLIB_BENCH_MB) * 1024 * 1024;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "lvgl_raylib_fs_bench");
+    lvgl_raylib_init(320, 240);
+
+    // Random bytes, so nothing below can shortcut the reads
+    uint8_t * data = malloc(_size);
+    if (data == NULL) {
+        printf("failed to allocate %u bytes\n", (unsigned)_size);
+        return 1;
+    }
+    uint32_t state = 1;
+    for (uint32_t i = 0; i < _size; i++) {
+        state = state * 1664525u + 1013904223u;
+        data[i] = (uint8_t)(state >> 24);
+    }
+    bool ok = SaveFileData(LVGL_RAYLIB_BENCH_PATH, data, (int)_size);
+    free(data);
+    if (!ok) {
+        printf("failed to write %s\n", LVGL_RAYLIB_BENCH_PATH);
+        return 1;
+    }
+
+#if LV_USE_FS_STDIO
+    bench_drive("stdio", LV_FS_STDIO_LETTER, false);
+#else
+    printf("stdio  LV_USE_FS_STDIO is off, nothing to compare with\n");
+#endif
+    bench_drive("mmap", LVGL_RAYLIB_FS_LETTER, false);
+    bench_drive("zcopy", LVGL_RAYLIB_FS_LETTER, true);
+
+    lvgl_raylib_fs_stats_t stats;
+    lvgl_raylib_fs_get_stats(&stats);
+    printf("mapped drive: %u opens, %u map hits, %u misses, %.3f ms per mapping\n",
+           (unsigned)stats.opens, (unsigned)stats.map_hits, (unsigned)stats.map_misses,
+           stats.map_misses > 0 ? stats.open_ms_total / stats.map_misses : 0.0f);
+
+    remove(LVGL_RAYLIB_BENCH_PATH);
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static void bench_drive(const char * name, char letter, bool zero_copy)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "%c:%s", letter, LVGL_RAYLIB_BENCH_PATH);
+
+    lv_fs_file_t file;
+    double start = GetTime();
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_OPENS; i++) {
+        if (lv_fs_open(&file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            printf("%-6s failed to open %s\n", name, path);
+            return;
+        }
+        lv_fs_close(&file);
+    }
+    double open_s = GetTime() - start;
+
+    // A plain byte sum keeps the reads from being dropped and doesn't depend on the chunking,
+    // so every line has to print the same one
+    uint32_t sum = 0;
+    start = GetTime();
+    for (int pass = 0; pass < LVGL_RAYLIB_BENCH_PASSES; pass++) {
+        if (lv_fs_open(&file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            printf("%-6s failed to open %s\n", name, path);
+            return;
+        }
+        uint32_t size = 0;
+        const uint8_t * mapped = zero_copy ? lvgl_raylib_fs_get_data(&file, &size) : NULL;
+        if (mapped != NULL) {
+            sum += checksum(mapped, size);
+        } else {
+            uint32_t read = 0;
+            while (lv_fs_read(&file, _chunk, sizeof(_chunk), &read) == LV_FS_RES_OK && read > 0) {
+                sum += checksum(_chunk, read);
+            }
+        }
+        lv_fs_close(&file);
+    }
+    double read_s = GetTime() - start;
+
+    double mb = (double)_size * LVGL_RAYLIB_BENCH_PASSES / (1024.0 * 1024.0);
+    printf("%-6s %8.2f us per open+close, %8.1f MB/s read, checksum %08x\n",
+           name, open_s * 1e6 / LVGL_RAYLIB_BENCH_OPENS, read_s > 0.0 ? mb / read_s : 0.0, (unsigned)sum);
+}
+
+static uint32_t checksum(const uint8_t * data, uint32_t size)
+{
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
@@ -0,0 +1,119 @@
+/* Measures hit-testing a container with many children, LVGL's walk against the grid index.
+ *
+ *   lvgl_raylib_hit_bench [children]
+ *
+ * The children (10000 by default) are small clickable boxes in a scrolled container larger
+ * than the display. The same random points are searched with lv_indev_search_obj() and
+ * lvgl_raylib_hit_search(), before and after scrolling; both have to find the same object. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_BENCH_WIDTH    480
+#define LVGL_RAYLIB_BENCH_HEIGHT   320
+#define LVGL_RAYLIB_BENCH_CHILDREN 10000
+#define LVGL_RAYLIB_BENCH_BOX      24
+#define LVGL_RAYLIB_BENCH_QUERIES  20000
+
+/* private prototypes */
+
+static double search(lv_obj_t * scr, bool indexed, lv_obj_t ** found);
+static uint32_t compare(const lv_obj_t * const * a, const lv_obj_t * const * b);
+
+/* static variables */
+
+static lv_point_t _points[LVGL_RAYLIB_BENCH_QUERIES];
+static lv_obj_t * _walked[LVGL_RAYLIB_BENCH_QUERIES];
+static lv_obj_t * _indexed[LVGL_RAYLIB_BENCH_QUERIES];
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    int children = argc > 1 ? atoi(argv[1]) : LVGL_RAYLIB_BENCH_CHILDREN;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(LVGL_RAYLIB_BENCH_WIDTH, LVGL_RAYLIB_BENCH_HEIGHT, "lvgl_raylib_hit_bench");
+    lvgl_raylib_init(LVGL_RAYLIB_BENCH_WIDTH, LVGL_RAYLIB_BENCH_HEIGHT);
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_t * cont = lv_obj_create(scr);
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, LV_PCT(100), LV_PCT(100));
+    int cols = 1;
+    while (cols * cols < children) {
+        cols++;
+    }
+    for (int i = 0; i < children; i++) {
+        lv_obj_t * obj = lv_obj_create(cont);
+        lv_obj_remove_style_all(obj);
+        lv_obj_add_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_pos(obj, (i % cols) * LVGL_RAYLIB_BENCH_BOX, (i / cols) * LVGL_RAYLIB_BENCH_BOX);
+        lv_obj_set_size(obj, LVGL_RAYLIB_BENCH_BOX - 2, LVGL_RAYLIB_BENCH_BOX - 2);
+    }
+    lv_obj_update_layout(scr);
+
+    uint32_t state = 1;
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_QUERIES; i++) {
+        state = state * 1664525u + 1013904223u;
+        _points[i].x = (int32_t)((state >> 8) % LVGL_RAYLIB_BENCH_WIDTH);
+        state = state * 1664525u + 1013904223u;
+        _points[i].y = (int32_t)((state >> 8) % LVGL_RAYLIB_BENCH_HEIGHT);
+    }
+
+    double start = GetTime();
+    lvgl_raylib_hit_index(cont, 0);
+    lv_point_t origin = { 0, 0 };
+    lvgl_raylib_hit_search(scr, &origin);
+    printf("index  %10.3f ms for %d children\n", (GetTime() - start) * 1000.0, children);
+
+    for (int pass = 0; pass < 2; pass++) {
+        double walked = search(scr, false, _walked);
+        double indexed = search(scr, true, _indexed);
+        printf("%-6s %10.3f us walked, %.3f us indexed, %u mismatches\n", pass == 0 ? "top" : "scroll",
+               walked * 1e6 / LVGL_RAYLIB_BENCH_QUERIES, indexed * 1e6 / LVGL_RAYLIB_BENCH_QUERIES,
+               compare((const lv_obj_t * const *)_walked, (const lv_obj_t * const *)_indexed));
+        lv_obj_scroll_to(cont, cols * LVGL_RAYLIB_BENCH_BOX / 2, cols * LVGL_RAYLIB_BENCH_BOX / 2, LV_ANIM_OFF);
+        lv_obj_update_layout(scr);
+    }
+
+    lvgl_raylib_hit_stats_t stats;
+    lvgl_raylib_hit_get_stats(&stats);
+    printf("stats  %u queries, %.1f candidates per query, %u loose\n", stats.queries,
+           stats.queries > 0 ? (double)stats.candidates / stats.queries : 0.0, stats.loose);
+
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static double search(lv_obj_t * scr, bool indexed, lv_obj_t ** found)
+{
+    double start = GetTime();
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_QUERIES; i++) {
+        lv_point_t p = _points[i];
+        found[i] = indexed ? lvgl_raylib_hit_search(scr, &p) : lv_indev_search_obj(scr, &p);
+    }
+    return GetTime() - start;
+}
+
+static uint32_t compare(const lv_obj_t * const * a, const lv_obj_t * const * b)
+{
+    uint32_t mismatches = 0;
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_QUERIES; i++) {
+        if (a[i] != b[i]) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
@@ -0,0 +1,212 @@
+/* Compares LVGL's heap with the C library's malloc on the same allocation pattern.
+ *
+ *   lvgl_raylib_mem_bench [ops]
+ *
+ * A fixed set of slots is filled and emptied in a random but repeatable order with sizes
+ * like a UI's: mostly small objects and styles, some label texts, a few large buffers.
+ * Reported are the operations per second and, with half of the slots still in use, how
+ * fragmented the free memory is. The last run builds and deletes screens with and without
+ * an arena. Build with LV_USE_STDLIB_MALLOC set to LV_STDLIB_CUSTOM, otherwise lv_malloc()
+ * is the C library's and both columns measure the same allocator. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_BENCH_SLOTS        4096
+#define LVGL_RAYLIB_BENCH_OPS          2000000
+#define LVGL_RAYLIB_BENCH_SCREENS      20
+#define LVGL_RAYLIB_BENCH_SCREEN_OBJS  2000
+#define LVGL_RAYLIB_BENCH_ARENA_SIZE   (4 * 1024 * 1024)
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#define LVGL_RAYLIB_BENCH_MALLINFO 1
+#include <malloc.h>
+#else
+#define LVGL_RAYLIB_BENCH_MALLINFO 0
+#endif
+
+/* private types */
+
+typedef struct {
+    const char * name;
+    void * (*alloc)(size_t size);
+    void (*free)(void * p);
+} allocator_t;
+
+/* private prototypes */
+
+static void * lv_alloc(size_t size);
+static void lv_release(void * p);
+static uint32_t next_random(uint32_t * state);
+static size_t next_size(uint32_t * state);
+static double churn(const allocator_t * allocator, void ** slots, uint32_t ops);
+static void report_lv_fragmentation(void);
+static void report_libc_fragmentation(void);
+static double build_screens(bool arena);
+
+/* static variables */
+
+static const allocator_t _allocators[] = {
+    { "lv_malloc", lv_alloc, lv_release },
+    { "malloc", malloc, free },
+};
+static void * _slots[LVGL_RAYLIB_BENCH_SLOTS];
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    uint32_t ops = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : LVGL_RAYLIB_BENCH_OPS;
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(320, 240, "lvgl_raylib_mem_bench");
+    lvgl_raylib_init(320, 240);
+
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_CUSTOM
+    printf("LV_USE_STDLIB_MALLOC is not LV_STDLIB_CUSTOM, lv_malloc is the C library's\n");
+#endif
+
+    for (size_t i = 0; i < sizeof(_allocators) / sizeof(_allocators[0]); i++) {
+        double s = churn(&_allocators[i], _slots, ops);
+        printf("%-10s %8.2f Mops/s\n", _allocators[i].name, ops / s / 1e6);
+
+        // Half of the slots stay in use while the fragmentation is measured
+        for (uint32_t j = 0; j < LVGL_RAYLIB_BENCH_SLOTS; j += 2) {
+            _allocators[i].free(_slots[j]);
+            _slots[j] = NULL;
+        }
+        if (i == 0) {
+            report_lv_fragmentation();
+        } else {
+            report_libc_fragmentation();
+        }
+        for (uint32_t j = 0; j < LVGL_RAYLIB_BENCH_SLOTS; j++) {
+            _allocators[i].free(_slots[j]);
+            _slots[j] = NULL;
+        }
+    }
+
+    double plain = build_screens(false);
+    double arena = build_screens(true);
+    printf("screens    %8.2f ms without arena, %.2f ms with (%d screens of %d objects)\n",
+           plain * 1000.0 / LVGL_RAYLIB_BENCH_SCREENS, arena * 1000.0 / LVGL_RAYLIB_BENCH_SCREENS,
+           LVGL_RAYLIB_BENCH_SCREENS, LVGL_RAYLIB_BENCH_SCREEN_OBJS);
+
+    lvgl_raylib_mem_stats_t stats;
+    lvgl_raylib_mem_get_stats(&stats);
+    printf("arenas     %u released, %u pinned, %u fallbacks\n", stats.arena_releases, stats.arenas_pinned, stats.arena_fallbacks);
+
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static void * lv_alloc(size_t size)
+{
+    return lv_malloc(size);
+}
+
+static void lv_release(void * p)
+{
+    lv_free(p);
+}
+
+static uint32_t next_random(uint32_t * state)
+{
+    // xorshift32, the same sequence for every allocator
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static size_t next_size(uint32_t * state)
+{
+    uint32_t r = next_random(state);
+    uint32_t kind = r % 100;
+    r >>= 8;
+    if (kind < 80) {
+        return 16 + r % 112;
+    }
+    if (kind < 98) {
+        return 128 + r % 1920;
+    }
+    return 2048 + r % (62 * 1024);
+}
+
+static double churn(const allocator_t * allocator, void ** slots, uint32_t ops)
+{
+    uint32_t state = 0x9e3779b9;
+    double start = GetTime();
+    for (uint32_t i = 0; i < ops; i++) {
+        uint32_t slot = next_random(&state) % LVGL_RAYLIB_BENCH_SLOTS;
+        if (slots[slot] != NULL) {
+            allocator->free(slots[slot]);
+            slots[slot] = NULL;
+        } else {
+            slots[slot] = allocator->alloc(next_size(&state));
+        }
+    }
+    return GetTime() - start;
+}
+
+static void report_lv_fragmentation(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    printf("           %zu KB used, %zu KB free, largest free %zu KB, %u%% fragmented\n",
+           (size_t)(mon.total_size - mon.free_size) / 1024, (size_t)mon.free_size / 1024,
+           (size_t)mon.free_biggest_size / 1024, mon.frag_pct);
+}
+
+static void report_libc_fragmentation(void)
+{
+#if LVGL_RAYLIB_BENCH_MALLINFO
+    // glibc doesn't report its largest free chunk, only how much it holds on to unused
+    struct mallinfo2 info = mallinfo2();
+    size_t total = info.arena + info.hblkhd;
+    printf("           %zu KB used, %zu KB free, %u%% of the heap held unused\n",
+           (info.uordblks + info.hblkhd) / 1024, info.fordblks / 1024,
+           total > 0 ? (unsigned)(info.fordblks * 100 / total) : 0);
+#else
+    printf("           fragmentation needs glibc 2.33 or later\n");
+#endif
+}
+
+static double build_screens(bool arena)
+{
+    double total = 0.0;
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_SCREENS; i++) {
+        double start = GetTime();
+        lv_obj_t * scr = lv_obj_create(NULL);
+        if (arena) {
+            lvgl_raylib_mem_arena_begin(scr, LVGL_RAYLIB_BENCH_ARENA_SIZE);
+        }
+        for (int j = 0; j < LVGL_RAYLIB_BENCH_SCREEN_OBJS; j++) {
+            lv_obj_t * obj = lv_obj_create(scr);
+            lv_obj_set_pos(obj, (j % 40) * 8, (j / 40) * 8);
+            lv_obj_set_size(obj, 8, 8);
+        }
+        if (arena) {
+            lvgl_raylib_mem_arena_end();
+        }
+        lv_obj_delete(scr);
+
+        // Deleted arenas are released by the next frame
+        lvgl_raylib_process_events();
+        total += GetTime() - start;
+    }
+    return total;
+}
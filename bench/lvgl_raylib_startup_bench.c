@@ -0,0 +1,173 @@
+/* Measures the time to the first frame with loose asset files and with an asset pack.
+ *
+ *   lvgl_raylib_startup_bench <font.ttf> [lvgl_raylib_pack]
+ *
+ * PNG icons are generated into the working directory and packed together with the font by
+ * the packer (./lvgl_raylib_pack by default, built next to this benchmark). Every round
+ * initializes lvgl_raylib, builds the same screen of icons and labels from either source
+ * and renders until lvgl_raylib_get_first_frame_ms() reports the frame. The two sources
+ * take turns, so the OS file cache treats them alike; the first round of each is reported
+ * apart as it may still read from disk. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_BENCH_WIDTH    800
+#define LVGL_RAYLIB_BENCH_HEIGHT   600
+#define LVGL_RAYLIB_BENCH_ICONS    24
+#define LVGL_RAYLIB_BENCH_ICON     96
+#define LVGL_RAYLIB_BENCH_ROUNDS   6
+#define LVGL_RAYLIB_BENCH_FRAMES   100        // give up on a round after this many frames
+#define LVGL_RAYLIB_BENCH_PACK     "lvgl_raylib_bench.pack"
+#define LVGL_RAYLIB_BENCH_TEXT     "The quick brown fox jumps over the lazy dog 0123456789"
+
+/* private prototypes */
+
+static float run(bool pack);
+static void build(bool pack, lv_font_t ** fonts);
+
+/* static variables */
+
+static const int32_t _sizes[] = { 16, 24 };
+static const char * _font_path;
+static char _icons[LVGL_RAYLIB_BENCH_ICONS][32];
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    if (argc < 2) {
+        printf("usage: %s <font.ttf> [lvgl_raylib_pack]\n", argv[0]);
+        return 1;
+    }
+    _font_path = argv[1];
+    const char * packer = argc > 2 ? argv[2] : "./lvgl_raylib_pack";
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(LVGL_RAYLIB_BENCH_WIDTH, LVGL_RAYLIB_BENCH_HEIGHT, "lvgl_raylib_startup_bench");
+
+    // Packer arguments become the entry names, so the icons are named the same both ways
+    char command[4096];
+    int len = snprintf(command, sizeof(command), "%s %s", packer, LVGL_RAYLIB_BENCH_PACK);
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_ICONS; i++) {
+        snprintf(_icons[i], sizeof(_icons[i]), "lvgl_raylib_bench_%d.png", i);
+        Image image = GenImageGradientRadial(LVGL_RAYLIB_BENCH_ICON, LVGL_RAYLIB_BENCH_ICON, 0.2f * (i % 4),
+                                             ColorFromHSV(i * 15.0f, 0.8f, 0.9f), BLANK);
+        bool ok = ExportImage(image, _icons[i]);
+        UnloadImage(image);
+        if (!ok) {
+            printf("failed to write %s\n", _icons[i]);
+            return 1;
+        }
+        len += snprintf(command + len, sizeof(command) - len, " %s", _icons[i]);
+    }
+    for (size_t i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        len += snprintf(command + len, sizeof(command) - len, " %s@%d", _font_path, (int)_sizes[i]);
+    }
+    if (len >= (int)sizeof(command) || system(command) != 0) {
+        printf("failed to run %s\n", packer);
+        return 1;
+    }
+
+    float first[2] = { 0.0f, 0.0f };
+    float total[2] = { 0.0f, 0.0f };
+    float best[2] = { 0.0f, 0.0f };
+    for (int round = 0; round < LVGL_RAYLIB_BENCH_ROUNDS * 2; round++) {
+        int mode = round % 2;
+        float ms = run(mode == 1);
+        if (round < 2) {
+            first[mode] = ms;
+            continue;
+        }
+        total[mode] += ms;
+        if (best[mode] == 0.0f || ms < best[mode]) {
+            best[mode] = ms;
+        }
+    }
+
+    const char * names[2] = { "files", "pack" };
+    for (int mode = 0; mode < 2; mode++) {
+        printf("%-6s first round %8.2f ms, then %8.2f ms mean, %8.2f ms best to the first frame\n",
+               names[mode], first[mode], total[mode] / (LVGL_RAYLIB_BENCH_ROUNDS - 1), best[mode]);
+    }
+
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_ICONS; i++) {
+        remove(_icons[i]);
+    }
+    remove(LVGL_RAYLIB_BENCH_PACK);
+    CloseWindow();
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static float run(bool pack)
+{
+    lv_font_t * fonts[sizeof(_sizes) / sizeof(_sizes[0])] = { 0 };
+
+    lvgl_raylib_init(LVGL_RAYLIB_BENCH_WIDTH, LVGL_RAYLIB_BENCH_HEIGHT);
+    build(pack, fonts);
+    for (int frame = 0; frame < LVGL_RAYLIB_BENCH_FRAMES && lvgl_raylib_get_first_frame_ms() == 0.0f; frame++) {
+        lvgl_raylib_process_events();
+        BeginDrawing();
+        ClearBackground(DARKGRAY);
+        lvgl_raylib_render();
+        EndDrawing();
+    }
+    float ms = lvgl_raylib_get_first_frame_ms();
+
+    // TTF fonts are the application's, they go once no label uses them; the pack closes itself
+    lv_obj_clean(lv_screen_active());
+    for (size_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        lvgl_raylib_font_delete(fonts[i]);
+    }
+    lvgl_raylib_deinit();
+    return ms;
+}
+
+static void build(bool pack, lv_font_t ** fonts)
+{
+    if (pack && !lvgl_raylib_pack_open(LVGL_RAYLIB_BENCH_PACK)) {
+        printf("failed to open %s\n", LVGL_RAYLIB_BENCH_PACK);
+        return;
+    }
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_set_flex_flow(scr, LV_FLEX_FLOW_ROW_WRAP);
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_ICONS; i++) {
+        lv_obj_t * img = lv_image_create(scr);
+        if (pack) {
+            lv_image_set_src(img, lvgl_raylib_pack_get_image(_icons[i]));
+        } else {
+            char src[40];
+            snprintf(src, sizeof(src), "%c:%s", LVGL_RAYLIB_FS_LETTER, _icons[i]);
+            lv_image_set_src(img, src);
+        }
+    }
+
+    for (size_t i = 0; i < sizeof(_sizes) / sizeof(_sizes[0]); i++) {
+        const lv_font_t * font;
+        char name[512];
+        if (pack) {
+            snprintf(name, sizeof(name), "%s@%d", _font_path, (int)_sizes[i]);
+            font = lvgl_raylib_pack_get_font(name);
+        } else {
+            snprintf(name, sizeof(name), "%c:%s", LVGL_RAYLIB_FS_LETTER, _font_path);
+            fonts[i] = lvgl_raylib_font_create(name, _sizes[i]);
+            font = fonts[i];
+        }
+        lv_obj_t * label = lv_label_create(scr);
+        lv_label_set_text(label, LVGL_RAYLIB_BENCH_TEXT);
+        if (font != NULL) {
+            lv_obj_set_style_text_font(label, font, 0);
+        }
+    }
+}
@@ -0,0 +1,131 @@
+/* Measures inserting typed text into a textarea one character at a time against one string
+ * per frame, the way the binding inserts what was typed in a frame.
+ *
+ *   lvgl_raylib_text_bench [chars per frame]
+ *
+ * The textarea already holds a few thousand characters of wrapped text, so every insert
+ * re-measures a long label. A frame ends with a layout update like lv_timer_handler() does. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_BENCH_WIDTH    480
+#define LVGL_RAYLIB_BENCH_HEIGHT   320
+#define LVGL_RAYLIB_BENCH_CHARS    8
+#define LVGL_RAYLIB_BENCH_FRAMES   200
+#define LVGL_RAYLIB_BENCH_TEXT     4000
+#define LVGL_RAYLIB_BENCH_PASTE    4096
+
+/* private prototypes */
+
+static lv_obj_t * textarea_create(void);
+static double type_text(bool batched, int chars);
+static double paste_text(bool batched);
+
+/* static variables */
+
+static const char _sample[] = "The quick brown fox jumps over the lazy dog. ";
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    int chars = argc > 1 ? atoi(argv[1]) : LVGL_RAYLIB_BENCH_CHARS;
+    if (chars < 1) {
+        chars = 1;
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(LVGL_RAYLIB_BENCH_WIDTH, LVGL_RAYLIB_BENCH_HEIGHT, "lvgl_raylib_text_bench");
+    lvgl_raylib_init(LVGL_RAYLIB_BENCH_WIDTH, LVGL_RAYLIB_BENCH_HEIGHT);
+
+    double each = type_text(false, chars);
+    double batched = type_text(true, chars);
+    printf("type   %10.3f ms per frame one by one, %.3f ms as one string (%d chars per frame)\n",
+           each * 1000.0 / LVGL_RAYLIB_BENCH_FRAMES, batched * 1000.0 / LVGL_RAYLIB_BENCH_FRAMES, chars);
+
+    each = paste_text(false);
+    batched = paste_text(true);
+    printf("paste  %10.3f ms one by one, %.3f ms as one string (%d chars)\n",
+           each * 1000.0, batched * 1000.0, LVGL_RAYLIB_BENCH_PASTE);
+
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lv_obj_t * textarea_create(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_obj_t * textarea = lv_textarea_create(lv_screen_active());
+    lv_obj_set_size(textarea, LV_PCT(100), LV_PCT(100));
+
+    char * text = malloc(LVGL_RAYLIB_BENCH_TEXT + 1);
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_TEXT; i++) {
+        text[i] = _sample[i % (sizeof(_sample) - 1)];
+    }
+    text[LVGL_RAYLIB_BENCH_TEXT] = '\0';
+    lv_textarea_set_text(textarea, text);
+    free(text);
+
+    // Typing happens in the middle, everything after the cursor is laid out again
+    lv_textarea_set_cursor_pos(textarea, LVGL_RAYLIB_BENCH_TEXT / 2);
+    lv_obj_update_layout(textarea);
+    return textarea;
+}
+
+static double type_text(bool batched, int chars)
+{
+    lv_obj_t * textarea = textarea_create();
+    char * text = malloc((size_t)chars + 1);
+    double start = GetTime();
+    for (int frame = 0; frame < LVGL_RAYLIB_BENCH_FRAMES; frame++) {
+        for (int i = 0; i < chars; i++) {
+            text[i] = _sample[(frame * chars + i) % (sizeof(_sample) - 1)];
+            if (!batched) {
+                lv_textarea_add_char(textarea, (uint32_t)text[i]);
+            }
+        }
+        text[chars] = '\0';
+        if (batched) {
+            lv_textarea_add_text(textarea, text);
+        }
+        lv_obj_update_layout(textarea);
+    }
+    double s = GetTime() - start;
+    free(text);
+    return s;
+}
+
+static double paste_text(bool batched)
+{
+    lv_obj_t * textarea = textarea_create();
+    char * text = malloc(LVGL_RAYLIB_BENCH_PASTE + 1);
+    for (int i = 0; i < LVGL_RAYLIB_BENCH_PASTE; i++) {
+        text[i] = _sample[i % (sizeof(_sample) - 1)];
+    }
+    text[LVGL_RAYLIB_BENCH_PASTE] = '\0';
+
+    double start = GetTime();
+    if (batched) {
+        lv_textarea_add_text(textarea, text);
+    } else {
+        for (int i = 0; i < LVGL_RAYLIB_BENCH_PASTE; i++) {
+            lv_textarea_add_char(textarea, (uint32_t)text[i]);
+        }
+    }
+    lv_obj_update_layout(textarea);
+    double s = GetTime() - start;
+    free(text);
+    return s;
+}
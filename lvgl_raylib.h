@@ -1,9 +1,404 @@
 #ifndef LVGL_RAYLIB_H
 #define LVGL_RAYLIB_H
 
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+
 void lvgl_raylib_init(int width, int height);
 void lvgl_raylib_process_events(void);
 void lvgl_raylib_render(void);
 void lvgl_raylib_deinit(void);
 
-#endif
\ No newline at end of file
+/* startup: milliseconds from lvgl_raylib_init() until the first LVGL frame reached the
+ * screen, 0 before that. Also logged once; bench/lvgl_raylib_startup_bench compares
+ * loose asset files against an asset pack with it. */
+
+float lvgl_raylib_get_first_frame_ms(void);
+
+/* GPU draw unit: large rectangles, borders and rounded corners are rendered through
+ * rlgl, everything else by LVGL's software renderer. Enabled by default; disabling it
+ * is useful to compare against the software output. The stats count the tasks the unit
+ * drew, so a test can tell that it actually ran. */
+
+typedef struct {
+    uint32_t fills;             // tasks drawn by the unit, by type
+    uint32_t borders;
+    uint32_t shadows;
+    uint32_t labels;
+    uint32_t images;
+    uint32_t vectors;
+    uint32_t batches;           // layer read backs, one per run of consecutive tasks
+} lvgl_raylib_draw_gpu_stats_t;
+
+void lvgl_raylib_draw_gpu_set_enabled(bool enabled);
+void lvgl_raylib_draw_gpu_get_stats(lvgl_raylib_draw_gpu_stats_t * stats);
+
+/* Box shadows are drawn by the GPU unit too. An object can also blur the content behind
+ * its background, e.g. for modals; the background needs a non-zero bg_opa to be drawn at
+ * all. radius 0 removes the blur. Only what is behind the object itself is blurred, so
+ * the edges don't pick up the content around it. Gradient backgrounds and a disabled GPU
+ * unit have no blur, the background is drawn as is. */
+
+void lvgl_raylib_draw_gpu_set_backdrop_blur(lv_obj_t * obj, int32_t radius);
+
+/* lv_vector paths (and so SVG) are tessellated on the CPU once and cached by content,
+ * then filled and stroked through a supersampled winding mask on the GPU. This is the
+ * only vector renderer: ThorVG is not built in, so paths are drawn on the GPU also when
+ * the unit is disabled, and image-pattern fills and strokes are not drawn at all. */
+
+typedef struct {
+    uint32_t entries;
+    uint32_t size;              // bytes of cached triangles
+    uint32_t hits;
+    uint32_t misses;            // paths tessellated
+} lvgl_raylib_draw_gpu_path_stats_t;
+
+void lvgl_raylib_draw_gpu_get_path_stats(lvgl_raylib_draw_gpu_path_stats_t * stats);
+
+/* Labels using LVGL's built-in bitmap fonts are drawn from a glyph atlas texture. Glyphs
+ * are keyed by the font's address: drop a font freed by the application, e.g. after
+ * lv_binfont_destroy(), before its memory can hold another one. NULL drops everything. */
+
+typedef struct {
+    uint32_t glyphs_per_sec;    // glyphs drawn during the last full second
+    uint32_t glyphs_drawn;
+    uint32_t atlas_hits;
+    uint32_t atlas_misses;
+    uint32_t atlas_evictions;   // times the atlas filled up and was cleared
+    uint32_t atlas_glyphs;      // glyphs currently in the atlas
+} lvgl_raylib_draw_gpu_text_stats_t;
+
+void lvgl_raylib_draw_gpu_get_text_stats(lvgl_raylib_draw_gpu_text_stats_t * stats);
+void lvgl_raylib_draw_gpu_font_drop(const lv_font_t * font);
+
+/* ARGB8888 and XRGB8888 images are uploaded once to a texture cache and scaled, rotated
+ * and recolored in a shader. The cache is bounded in bytes, least recently used images
+ * are unloaded first. Drop a source after changing its pixels, NULL drops everything. */
+
+typedef struct {
+    uint32_t entries;
+    uint32_t size;              // bytes of texture memory in use
+    uint32_t max_size;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+} lvgl_raylib_draw_gpu_image_stats_t;
+
+void lvgl_raylib_draw_gpu_set_image_cache_size(uint32_t max_size);
+void lvgl_raylib_draw_gpu_get_image_stats(lvgl_raylib_draw_gpu_image_stats_t * stats);
+void lvgl_raylib_draw_gpu_image_drop(const void * src);
+
+/* viewport: a layout placeholder composited with a raylib render texture. LVGL leaves
+ * a transparent hole where the viewport is and the content is drawn under the LVGL
+ * texture, so objects above the viewport blend over it with their real shape. The
+ * content is treated as opaque: where it is transparent the window shows through, not
+ * what LVGL drew behind the viewport. Inside an object LVGL draws through a layer of its
+ * own (opacity, transforms, blend modes) the hole only reaches through that object, what
+ * is drawn under the object covers the viewport. */
+
+typedef void (*lvgl_raylib_viewport_draw_cb_t)(lv_obj_t * viewport, Rectangle dst, void * user_data);
+
+lv_obj_t * lvgl_raylib_viewport_create(lv_obj_t * parent);
+void lvgl_raylib_viewport_set_texture(lv_obj_t * viewport, const RenderTexture2D * target);
+void lvgl_raylib_viewport_set_draw_cb(lv_obj_t * viewport, lvgl_raylib_viewport_draw_cb_t draw_cb, void * user_data);
+
+/* video: YUV 4:2:0 frames converted by a shader at composition time, LVGL never
+ * rasterizes the video rectangle. Files play at their own frame rate and loop. */
+
+lv_obj_t * lvgl_raylib_video_create(lv_obj_t * parent);
+bool lvgl_raylib_video_open_y4m(lv_obj_t * video, const char * path);
+bool lvgl_raylib_video_open_raw(lv_obj_t * video, const char * path, int width, int height, float fps);
+void lvgl_raylib_video_push_frame(lv_obj_t * video, int width, int height, const uint8_t * y, const uint8_t * u, const uint8_t * v);
+
+/* input events: button edges, pointer motion, wheel steps and keys are queued with their
+ * time as they arrive and LVGL reads them one by one, so a click shorter than a frame still
+ * registers and drags move in every sample the mouse reported. On desktop builds they are
+ * captured from GLFW's callbacks (raylib's still run), elsewhere sampled once per frame;
+ * there keys and characters keep their order as long as each printable key typed one.
+ * The pointer is only read in frames where it changed, is held down or a scroll throw
+ * is still running, idle frames cost no hit-testing. Characters typed into a focused
+ * textarea in one frame, and Ctrl+V / Cmd+V pastes, are inserted as one string with one
+ * relayout; the textarea gets LV_EVENT_INSERT but no LV_EVENT_KEY for them. */
+
+typedef struct {
+    uint32_t events;            // events queued
+    uint32_t coalesced;         // motion samples merged into the previous one, queue half full
+    uint32_t dropped;           // events lost to a full queue
+    uint32_t max_depth;
+    uint32_t skipped_reads;     // frames the pointer had nothing new for LVGL
+    uint32_t reads_per_sec;     // pointer reads over the last second
+    uint32_t skipped_reads_per_sec;
+    uint32_t hover_skips;       // motion dropped, it stayed over the same object (hit-test index)
+    uint32_t keystrokes_per_sec;
+    uint32_t text_batches;      // character runs inserted into a textarea as one string
+    uint32_t text_bytes;
+    uint32_t pastes;
+    bool captured;              // events come from callbacks, not per frame sampling
+} lvgl_raylib_input_stats_t;
+
+void lvgl_raylib_input_get_stats(lvgl_raylib_input_stats_t * stats);
+
+/* hit-test index: a uniform grid over the children of a container, in content coordinates
+ * so scrolling never touches it; moved children are re-filed one by one as layouts run.
+ * The cursor shape and the pointer resolve the object under the pointer through it, and
+ * motion that stays over the same object only updates lv_indev_get_point(), LVGL doesn't
+ * search or send events for it. When a press starts, or a drag crosses objects without
+ * LV_OBJ_FLAG_PRESS_LOCK, LVGL's own search only walks the path the index found. Meant
+ * for containers with thousands of children. Index
+ * again after changing a child's transform or extended click area. cell_size 0 uses 64 px. */
+
+typedef struct {
+    uint32_t indexes;
+    uint32_t entries;           // children indexed
+    uint32_t loose;             // children tried by every query: floating, transformed, large
+    uint32_t rebuilds;
+    uint32_t updates;           // children re-filed after a move
+    uint32_t queries;
+    uint32_t candidates;        // children tried by the queries
+} lvgl_raylib_hit_stats_t;
+
+void lvgl_raylib_hit_index(lv_obj_t * obj, int32_t cell_size);
+void lvgl_raylib_hit_unindex(lv_obj_t * obj);
+lv_obj_t * lvgl_raylib_hit_search(lv_obj_t * obj, const lv_point_t * point);
+void lvgl_raylib_hit_get_stats(lvgl_raylib_hit_stats_t * stats);
+
+/* cursor layer: a sprite drawn by lvgl_raylib_render() at the latest pointer position.
+ * Shapes are raylib MouseCursor values; shapes without a sprite use the system cursor.
+ * Objects (and their children) can request a shape, pointer motion never redraws LVGL. */
+
+void lvgl_raylib_cursor_set_texture(int shape, Texture2D texture, Vector2 hotspot);
+void lvgl_raylib_cursor_set_image(int shape, Image image, Vector2 hotspot);
+void lvgl_raylib_cursor_set_obj_shape(lv_obj_t * obj, int shape);
+
+/* accelerated scrolling: scroll steps of the container shift the already rendered
+ * pixels and LVGL only renders the newly exposed strip. Falls back to a full redraw
+ * whenever the background, overlays or floating children make shifting unsafe. */
+
+void lvgl_raylib_scroll_accelerate(lv_obj_t * obj);
+
+/* layer promotion: the object subtree is rasterized once into a texture that
+ * lvgl_raylib_render() composites with a GPU offset, scale and opacity. LVGL keeps
+ * laying out the objects and sending them input, only their draw tasks are dropped.
+ * It is re-rasterized when an area within it is invalidated or its size changes,
+ * moving it only moves the texture. While objects above it overlap the transformed
+ * layer, LVGL draws the texture itself in z-order instead, and redraws the area
+ * whenever the transform changes. The anim callbacks can be used directly as
+ * lv_anim exec callbacks (scale: 256 = 100%). */
+
+void lvgl_raylib_layer_promote(lv_obj_t * obj);
+void lvgl_raylib_layer_demote(lv_obj_t * obj);
+void lvgl_raylib_layer_set_offset(lv_obj_t * obj, float x, float y);
+void lvgl_raylib_layer_set_scale(lv_obj_t * obj, float scale);
+void lvgl_raylib_layer_set_opa(lv_obj_t * obj, lv_opa_t opa);
+void lvgl_raylib_layer_anim_x_cb(void * obj, int32_t value);
+void lvgl_raylib_layer_anim_y_cb(void * obj, int32_t value);
+void lvgl_raylib_layer_anim_scale_cb(void * obj, int32_t value);
+void lvgl_raylib_layer_anim_opa_cb(void * obj, int32_t value);
+
+/* screen transitions: both screens are rendered once into textures and the
+ * transition runs on the GPU, the new screen is active from the first frame.
+ * lv_layer_top() stays in place over both; viewports are left out until it ends.
+ * Shader transitions get `progress` (0..1) and sample the incoming screen as `textureIn`. */
+
+typedef enum {
+    LVGL_RAYLIB_TRANSITION_FADE,
+    LVGL_RAYLIB_TRANSITION_SLIDE_LEFT,
+    LVGL_RAYLIB_TRANSITION_SLIDE_RIGHT,
+    LVGL_RAYLIB_TRANSITION_SLIDE_UP,
+    LVGL_RAYLIB_TRANSITION_SLIDE_DOWN,
+    LVGL_RAYLIB_TRANSITION_ZOOM,
+    LVGL_RAYLIB_TRANSITION_SHADER,
+} lvgl_raylib_transition_type_t;
+
+void lvgl_raylib_screen_load_anim(lv_obj_t * scr, lvgl_raylib_transition_type_t type, uint32_t time, bool auto_del);
+void lvgl_raylib_screen_load_shader(lv_obj_t * scr, Shader shader, uint32_t time, bool auto_del);
+bool lvgl_raylib_transition_is_running(void);
+
+/* speculative pre-rendering: a screen that isn't active yet is rendered off-screen
+ * during idle time, at most `budget_ms` per frame. Loading it presents the cached
+ * pixels immediately while LVGL re-renders it in bands over the following frames. */
+
+void lvgl_raylib_prerender_start(lv_obj_t * scr, uint32_t budget_ms);
+void lvgl_raylib_prerender_invalidate(lv_obj_t * scr);
+bool lvgl_raylib_prerender_is_ready(lv_obj_t * scr);
+void lvgl_raylib_screen_load_prerendered(lv_obj_t * scr, bool auto_del);
+
+/* mapped files: an lv_fs driver serving files straight from mmap. A file opened by
+ * several users is mapped once, and get_data() hands out the mapping itself for
+ * zero-copy reads; the image decoder and TTF fonts use it for paths on this drive. */
+
+#ifndef LVGL_RAYLIB_FS_LETTER
+#define LVGL_RAYLIB_FS_LETTER 'M'
+#endif
+
+typedef struct {
+    uint32_t mappings;
+    uint32_t mapped_size;
+    uint32_t opens;
+    uint32_t map_hits;          // opens served by an existing mapping
+    uint32_t map_misses;
+    float open_ms_last;
+    float open_ms_total;
+} lvgl_raylib_fs_stats_t;
+
+const void * lvgl_raylib_fs_get_data(lv_fs_file_t * file, uint32_t * size);
+void lvgl_raylib_fs_get_stats(lvgl_raylib_fs_stats_t * stats);
+
+/* asset packs: images and pre-rasterized fonts built by the lvgl_raylib_pack tool, opened
+ * with a single mapping. Images are premultiplied ARGB8888 descriptors pointing into the
+ * mapping and are drawn without decoding or copying. Names are the packer arguments, e.g.
+ * "icons/home.png" or "fonts/ui.ttf@18". Everything handed out is gone once closed. */
+
+bool lvgl_raylib_pack_open(const char * path);
+const lv_image_dsc_t * lvgl_raylib_pack_get_image(const char * name);
+const lv_font_t * lvgl_raylib_pack_get_font(const char * name);
+void lvgl_raylib_pack_close(const char * path);
+
+/* image decoder: PNG, BMP, TGA, JPG, GIF, QOI, PSD and HDR files (or RAW image descriptors
+ * holding such a file) are decoded by raylib once, converted to premultiplied ARGB8888 and
+ * kept in an LRU cache bounded in bytes. Drop a source after its file changed. */
+
+typedef struct {
+    uint32_t entries;
+    uint32_t size;              // bytes of decoded pixels
+    uint32_t max_size;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t decodes;
+    float decode_ms_last;
+    float decode_ms_total;
+} lvgl_raylib_decoder_stats_t;
+
+void lvgl_raylib_decoder_set_cache_size(uint32_t max_size);
+void lvgl_raylib_decoder_get_stats(lvgl_raylib_decoder_stats_t * stats);
+void lvgl_raylib_decoder_drop(const void * src);
+
+/* async images: the file is decoded on a background thread while the image shows a
+ * placeholder color, then only the image area redraws. Decoding starts once the image
+ * is near the viewport, looking ahead in the scroll direction of its parent, and work
+ * for images scrolled away before their turn is cancelled. Requires LV_USE_OS. */
+
+typedef struct {
+    uint32_t pending;           // images still waiting for their pixels
+    uint32_t queued;
+    uint32_t decoded;
+    uint32_t cancelled;
+    uint32_t failed;
+} lvgl_raylib_loader_stats_t;
+
+void lvgl_raylib_loader_set_src(lv_obj_t * img, const char * path, lv_color_t placeholder);
+void lvgl_raylib_loader_get_stats(lvgl_raylib_loader_stats_t * stats);
+
+/* TTF fonts: any size of a TrueType file as an lv_font_t, glyphs rasterized by raylib on
+ * first use. Glyphs of every font and size share one LRU cache bounded in bytes. Delete
+ * a font only once no label uses it. */
+
+typedef struct {
+    uint32_t glyphs;
+    uint32_t size;              // bytes of bitmaps and entries
+    uint32_t max_size;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    float raster_ms_last;
+    float raster_ms_total;
+} lvgl_raylib_font_stats_t;
+
+lv_font_t * lvgl_raylib_font_create(const char * path, int32_t size);
+void lvgl_raylib_font_delete(lv_font_t * font);
+void lvgl_raylib_font_set_cache_size(uint32_t max_size);
+void lvgl_raylib_font_get_stats(lvgl_raylib_font_stats_t * stats);
+
+/* draw buffers: LVGL's draw buffers and layers come from a pool of size classes instead of
+ * malloc, so the layers of opacity and transform effects are recycled frame to frame.
+ * Buffers start on 64 byte boundaries and screen sized ones are advised onto transparent
+ * huge pages where the OS supports it. */
+
+typedef struct {
+    uint32_t allocs;
+    uint32_t pool_hits;         // allocations served by a recycled buffer
+    uint32_t pool_misses;
+    uint32_t live;              // buffers handed out
+    uint32_t live_size;
+    uint32_t idle;              // buffers kept for reuse
+    uint32_t idle_size;
+    uint32_t max_idle_size;
+    uint32_t huge;              // buffers on huge pages, live or idle
+} lvgl_raylib_draw_buf_stats_t;
+
+void lvgl_raylib_draw_buf_set_pool_size(uint32_t max_size);
+void lvgl_raylib_draw_buf_get_stats(lvgl_raylib_draw_buf_stats_t * stats);
+
+/* LVGL heap: with LV_USE_STDLIB_MALLOC set to LV_STDLIB_CUSTOM, LVGL allocates from a TLSF
+ * heap of the binding over one reserved region instead of the C library's malloc, in O(1)
+ * and away from the application's own churn. lv_mem_monitor() reports its fragmentation.
+ * A screen can get an arena: what is allocated between begin() and end() while building it
+ * comes from the arena, which keeps the screen's objects together and is unmapped in one
+ * step once the screen is deleted and everything in it has been freed. The binding's own
+ * caches (decoded images, fonts, files) always use the main heap; anything else allocated
+ * in between that outlives the screen, e.g. LVGL's image header cache or a global style,
+ * keeps the arena mapped until it is freed, counted as pinned. Without LV_STDLIB_CUSTOM
+ * these calls do nothing. */
+
+typedef struct {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t reallocs;
+    uint32_t failed;
+    uint32_t arenas;            // arenas of screens alive
+    uint32_t arena_allocs;
+    uint32_t arena_fallbacks;   // arena full, served by the main heap
+    uint32_t arena_releases;    // arenas released after their screen
+    uint32_t arenas_pinned;     // screen deleted, allocations that outlived it still in the arena
+} lvgl_raylib_mem_stats_t;
+
+void lvgl_raylib_mem_arena_begin(lv_obj_t * scr, uint32_t size);
+void lvgl_raylib_mem_arena_end(void);
+void lvgl_raylib_mem_get_stats(lvgl_raylib_mem_stats_t * stats);
+
+/* memory budget: one byte limit shared by the caches above, the GPU image textures and
+ * vector paths, pre-rendered screens and promoted layers. Once a frame entries are evicted
+ * across all of them, the one unused the longest relative to what it costs to bring back
+ * goes first: a texture re-upload before a glyph, a glyph before a file decode. trim()
+ * does the same right away, e.g. on a low memory warning. Layers count but stay. */
+
+#define LVGL_RAYLIB_BUDGET_CACHE_CNT 8
+
+typedef struct {
+    const char * name;
+    uint32_t size;              // bytes in use
+    uint32_t evictions;         // entries evicted for the shared limit
+} lvgl_raylib_budget_cache_stats_t;
+
+typedef struct {
+    uint32_t limit;
+    uint32_t size;
+    uint32_t peak_size;
+    uint32_t trims;             // passes that had to evict
+    uint32_t cache_cnt;
+    lvgl_raylib_budget_cache_stats_t caches[LVGL_RAYLIB_BUDGET_CACHE_CNT];
+} lvgl_raylib_budget_stats_t;
+
+void lvgl_raylib_budget_set_limit(uint32_t limit);
+uint32_t lvgl_raylib_budget_trim(uint32_t max_size);
+void lvgl_raylib_budget_get_stats(lvgl_raylib_budget_stats_t * stats);
+
+/* shared images: a raylib Image used in place as an LVGL image source, no copies.
+ * Wrap raylib drawing into the image with begin_edit()/changed() for the touched area
+ * (NULL means the whole image); only that area is invalidated on screen.
+ *
+ * Sharing takes the image over: it is converted to R8G8B8A8 (image->data may move) and
+ * its red and blue bytes are swapped in place into LVGL's byte order. Until unshare()
+ * swaps them back, reading, exporting or uploading the image with raylib (ExportImage,
+ * LoadTextureFromImage, UpdateTexture, GetImageColor...) sees swapped colors, except
+ * inside the area of a begin_edit()/changed() pair. Don't UnloadImage() it while shared. */
+
+const lv_image_dsc_t * lvgl_raylib_image_share(Image * image);
+void lvgl_raylib_image_begin_edit(Image * image, const lv_area_t * area);
+void lvgl_raylib_image_changed(Image * image, const lv_area_t * area);
+void lvgl_raylib_image_unshare(Image * image);
+
+#endif
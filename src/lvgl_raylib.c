@@ -3,6 +3,25 @@
 #include "lvgl_raylib.h"
 #include "lvgl_raylib_display.h"
 #include "lvgl_raylib_input.h"
+#include "lvgl_raylib_hit.h"
+#include "lvgl_raylib_budget.h"
+#include "lvgl_raylib_draw_buf.h"
+#include "lvgl_raylib_mem.h"
+#include "lvgl_raylib_draw_gpu.h"
+#include "lvgl_raylib_fs.h"
+#include "lvgl_raylib_decoder.h"
+#include "lvgl_raylib_loader.h"
+#include "lvgl_raylib_font.h"
+#include "lvgl_raylib_pack.h"
+#include "lvgl_raylib_prerender.h"
+#include "lvgl_raylib_transition.h"
+#include "lvgl_raylib_layer.h"
+#include "lvgl_raylib_scroll.h"
+#include "lvgl_raylib_cursor.h"
+#include "lvgl_raylib_image.h"
+#include "lvgl_raylib_video.h"
+#include "lvgl_raylib_viewport.h"
+#include "lvgl_raylib_compose.h"
 
 /* private prototypes */
 
@@ -12,21 +31,52 @@ static uint32_t lvgl_raylib_tick_cb(void);
 
 static lvgl_raylib_display_t _default_display = {0};
 static lvgl_raylib_input_t _default_input = {0};
+static double _init_time = 0.0;
+static float _first_frame_ms = 0.0f;
 
 /* PUBLIC IMPLEMENTATION */
 
 void lvgl_raylib_init(int width, int height)
 {
+    _init_time = GetTime();
+    _first_frame_ms = 0.0f;
     lv_init();
     lv_tick_set_cb(&lvgl_raylib_tick_cb);
+    lvgl_raylib_budget_init();
+    lvgl_raylib_draw_buf_init();
+    lvgl_raylib_draw_gpu_init();
+    lvgl_raylib_compose_init();
+    lvgl_raylib_fs_init();
+    lvgl_raylib_decoder_init();
+    lvgl_raylib_loader_init();
+    lvgl_raylib_font_init();
+    lvgl_raylib_pack_init();
     lvgl_raylib_display_create(&_default_display, width, height);
+    lvgl_raylib_hit_init();
     lvgl_raylib_input_create(&_default_input);
+    lvgl_raylib_viewport_init();
+    lvgl_raylib_image_init();
+    lvgl_raylib_video_init();
+    lvgl_raylib_cursor_init();
+    lvgl_raylib_scroll_init(&_default_display);
+    lvgl_raylib_layer_init(&_default_display);
+    lvgl_raylib_transition_init(&_default_display);
+    lvgl_raylib_prerender_init(&_default_display);
 }
 
 void lvgl_raylib_process_events(void)
 {
-    lv_indev_read(_default_input.keyboard_indev);
+    lvgl_raylib_input_poll();
+    lvgl_raylib_input_update(&_default_input);
     lv_task_handler();
+    lvgl_raylib_mem_update();
+    lvgl_raylib_video_update();
+    lvgl_raylib_loader_update();
+    lvgl_raylib_layer_update();
+    lvgl_raylib_cursor_update();
+    lvgl_raylib_scroll_frame_end();
+    lvgl_raylib_prerender_update();
+    lvgl_raylib_budget_update();
 }
 
 void lvgl_raylib_render(void)
@@ -35,19 +85,56 @@ void lvgl_raylib_render(void)
     if (_default_display.texture_updated && _default_display.texture_created) {
         UpdateTexture(_default_display.raylib_texture, _default_display.raylib_img.data);
         _default_display.texture_updated = false;
+        if (_first_frame_ms == 0.0f) {
+            _first_frame_ms = (float)((GetTime() - _init_time) * 1000.0);
+            TraceLog(LOG_INFO, "LVGL Raylib: first frame %.1f ms after init", _first_frame_ms);
+        }
     }
     
-    // Draw the texture on screen if it exists
-    if (_default_display.texture_created) {
-        DrawTexture(_default_display.raylib_texture, 0, 0, WHITE);
+    // A running screen transition replaces the whole UI composition
+    if (!lvgl_raylib_transition_render()) {
+        // Raylib content goes first, into the holes viewports leave in the LVGL texture
+        lvgl_raylib_viewport_render();
+
+        // Draw the texture on screen if it exists, blended over the viewports
+        if (_default_display.texture_created) {
+            DrawTexture(_default_display.raylib_texture, 0, 0, WHITE);
+        }
+
+        // Promoted layers are composited with their GPU transform
+        lvgl_raylib_layer_render(&_default_display);
     }
+
+    // The cursor sprite goes on top of everything
+    lvgl_raylib_cursor_render();
+}
+
+float lvgl_raylib_get_first_frame_ms(void)
+{
+    return _first_frame_ms;
 }
 
 void lvgl_raylib_deinit()
 {
+    lvgl_raylib_scroll_deinit();
+    lvgl_raylib_layer_deinit();
+    lvgl_raylib_transition_deinit();
+    lvgl_raylib_prerender_deinit();
     lvgl_raylib_display_destroy(&_default_display);
     lvgl_raylib_input_destroy(&_default_input);
+    lvgl_raylib_hit_deinit();
+    lvgl_raylib_viewport_deinit();
+    lvgl_raylib_image_deinit();
+    lvgl_raylib_video_deinit();
+    lvgl_raylib_cursor_deinit();
+    lvgl_raylib_loader_deinit();
+    lvgl_raylib_decoder_deinit();
+    lvgl_raylib_font_deinit();
+    lvgl_raylib_pack_deinit();
+    lvgl_raylib_fs_deinit();
     lv_deinit();
+    lvgl_raylib_draw_buf_deinit();
+    lvgl_raylib_budget_deinit();
 }
 
 /* PRIVATE IMPLEMENTATION */
@@ -0,0 +1,148 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_budget.h"
+
+/* private prototypes */
+
+static uint32_t lvgl_raylib_budget_get_size(void);
+static uint32_t lvgl_raylib_budget_evict(uint32_t max_size);
+
+/* static variables */
+
+static lvgl_raylib_budget_cache_t * _caches[LVGL_RAYLIB_BUDGET_CACHE_CNT];
+static uint32_t _cache_cnt = 0;
+static uint32_t _use_counter = 0;
+static lvgl_raylib_budget_stats_t _stats = {0};
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_budget_init(void)
+{
+    memset(_caches, 0, sizeof(_caches));
+    _cache_cnt = 0;
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.limit = LVGL_RAYLIB_BUDGET_SIZE;
+}
+
+void lvgl_raylib_budget_register(lvgl_raylib_budget_cache_t * cache)
+{
+    if (_cache_cnt >= LVGL_RAYLIB_BUDGET_CACHE_CNT) {
+        TraceLog(LOG_WARNING, "Memory budget is full, %s is not accounted", cache->name);
+        return;
+    }
+    cache->evictions = 0;
+    _caches[_cache_cnt++] = cache;
+}
+
+void lvgl_raylib_budget_unregister(lvgl_raylib_budget_cache_t * cache)
+{
+    for (uint32_t i = 0; i < _cache_cnt; i++) {
+        if (_caches[i] == cache) {
+            memmove(&_caches[i], &_caches[i + 1], (_cache_cnt - i - 1) * sizeof(_caches[0]));
+            _cache_cnt--;
+            return;
+        }
+    }
+}
+
+uint32_t lvgl_raylib_budget_touch(void)
+{
+    return ++_use_counter;
+}
+
+uint32_t lvgl_raylib_budget_now(void)
+{
+    return _use_counter;
+}
+
+void lvgl_raylib_budget_set_limit(uint32_t limit)
+{
+    _stats.limit = limit;
+    lvgl_raylib_budget_update();
+}
+
+uint32_t lvgl_raylib_budget_trim(uint32_t max_size)
+{
+    return lvgl_raylib_budget_evict(max_size);
+}
+
+void lvgl_raylib_budget_get_stats(lvgl_raylib_budget_stats_t * stats)
+{
+    _stats.size = lvgl_raylib_budget_get_size();
+    _stats.peak_size = LV_MAX(_stats.peak_size, _stats.size);
+    _stats.cache_cnt = _cache_cnt;
+    for (uint32_t i = 0; i < _cache_cnt; i++) {
+        _stats.caches[i].name = _caches[i]->name;
+        _stats.caches[i].size = _caches[i]->get_size_cb();
+        _stats.caches[i].evictions = _caches[i]->evictions;
+    }
+    *stats = _stats;
+}
+
+void lvgl_raylib_budget_update(void)
+{
+    uint32_t size = lvgl_raylib_budget_get_size();
+    _stats.peak_size = LV_MAX(_stats.peak_size, size);
+    if (size > _stats.limit) {
+        lvgl_raylib_budget_evict(_stats.limit);
+    }
+}
+
+void lvgl_raylib_budget_deinit(void)
+{
+    _cache_cnt = 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static uint32_t lvgl_raylib_budget_get_size(void)
+{
+    uint32_t size = 0;
+    for (uint32_t i = 0; i < _cache_cnt; i++) {
+        size += _caches[i]->get_size_cb();
+    }
+    return size;
+}
+
+static uint32_t lvgl_raylib_budget_evict(uint32_t max_size)
+{
+    uint32_t start_size = lvgl_raylib_budget_get_size();
+    uint32_t size = start_size;
+    if (size <= max_size) {
+        return 0;
+    }
+    _stats.trims++;
+
+    while (size > max_size) {
+        // The entry unused for the longest time per cost of bringing it back goes first
+        lvgl_raylib_budget_cache_t * victim = NULL;
+        float victim_score = -1.0f;
+        for (uint32_t i = 0; i < _cache_cnt; i++) {
+            lvgl_raylib_budget_cache_t * cache = _caches[i];
+            uint32_t last_used;
+            if (cache->get_oldest_cb == NULL || !cache->get_oldest_cb(&last_used)) {
+                continue;
+            }
+            float score = (float)(_use_counter - last_used) / (float)cache->cost;
+            if (score > victim_score) {
+                victim = cache;
+                victim_score = score;
+            }
+        }
+        if (victim == NULL) {
+            break;
+        }
+
+        uint32_t cache_size = victim->get_size_cb();
+        victim->evict_oldest_cb();
+        victim->evictions++;
+        uint32_t freed = cache_size - LV_MIN(cache_size, victim->get_size_cb());
+        if (freed == 0) {
+            break;
+        }
+        size -= LV_MIN(size, freed);
+    }
+    return start_size - size;
+}
@@ -0,0 +1,51 @@
+#ifndef LVGL_RAYLIB_BUDGET_H
+#define LVGL_RAYLIB_BUDGET_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Default limit of all caches together in bytes */
+#define LVGL_RAYLIB_BUDGET_SIZE (64 * 1024 * 1024)
+
+/** Relative cost of regenerating a byte, cheap caches give up their entries first */
+#define LVGL_RAYLIB_BUDGET_COST_UPLOAD  1       // texture upload from pixels still in memory
+#define LVGL_RAYLIB_BUDGET_COST_RASTER  2       // glyph rasterization, path tessellation
+#define LVGL_RAYLIB_BUDGET_COST_DECODE  4       // image file decode
+#define LVGL_RAYLIB_BUDGET_COST_RENDER  8       // a whole screen rendered by LVGL
+
+/* public types */
+
+/** A cache registered with the budget, owned by its module */
+typedef struct {
+    const char * name;
+    uint32_t cost;
+    uint32_t (*get_size_cb)(void);
+    /** Stamp of the least recently used entry that can go, false when none can.
+     *  NULL for memory that is counted but never evicted. */
+    bool (*get_oldest_cb)(uint32_t * last_used);
+    void (*evict_oldest_cb)(void);
+    uint32_t evictions;
+} lvgl_raylib_budget_cache_t;
+
+/* public functions */
+
+void lvgl_raylib_budget_init(void);
+void lvgl_raylib_budget_register(lvgl_raylib_budget_cache_t * cache);
+void lvgl_raylib_budget_unregister(lvgl_raylib_budget_cache_t * cache);
+
+/** Next use stamp, shared by every cache so their LRU orders compare */
+uint32_t lvgl_raylib_budget_touch(void);
+
+/** The latest stamp, stamps wrap so LRU scans compare `now - last_used` */
+uint32_t lvgl_raylib_budget_now(void);
+
+/** Evict down to the limit, once per frame on the UI thread */
+void lvgl_raylib_budget_update(void);
+void lvgl_raylib_budget_deinit(void);
+
+#endif
@@ -0,0 +1,247 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib_compose.h"
+
+/* private defines */
+
+#if LV_VERSION_CHECK(9, 3, 0)
+    #define LVGL_RAYLIB_DRAW_GET_TASK(layer, id) lv_draw_get_available_task(layer, NULL, id)
+    #define LVGL_RAYLIB_DRAW_TASK_DONE           LV_DRAW_TASK_STATE_FINISHED
+#else
+    #define LVGL_RAYLIB_DRAW_GET_TASK(layer, id) lv_draw_get_next_available_task(layer, NULL, id)
+    #define LVGL_RAYLIB_DRAW_TASK_DONE           LV_DRAW_TASK_STATE_READY
+#endif
+
+#define LVGL_RAYLIB_COMPOSE_PART_HOLE LV_PART_CUSTOM_FIRST
+
+/* private prototypes */
+
+static int32_t lvgl_raylib_compose_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * t);
+static int32_t lvgl_raylib_compose_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+static int32_t lvgl_raylib_compose_delete(lv_draw_unit_t * draw_unit);
+static bool lvgl_raylib_compose_is_skipped(const lv_obj_t * obj);
+static void lvgl_raylib_compose_cut(lv_draw_task_t * t, lv_layer_t * layer);
+static bool lvgl_raylib_compose_visit_children(const lv_obj_t * parent, int32_t first, const lv_area_t * area, lvgl_raylib_compose_above_cb_t cb, void * user_data);
+static bool lvgl_raylib_compose_covered_cb(const lv_obj_t * obj, const lv_area_t * overlap, void * user_data);
+
+/* static variables */
+
+static lv_draw_unit_t * _unit = NULL;
+static bool _adding_hole = false;
+static lvgl_raylib_compose_skip_cb_t _skip_cb = NULL;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_compose_init(void)
+{
+    _unit = lv_draw_create_unit(sizeof(lv_draw_unit_t));
+    _unit->evaluate_cb = &lvgl_raylib_compose_evaluate;
+    _unit->dispatch_cb = &lvgl_raylib_compose_dispatch;
+    _unit->delete_cb = &lvgl_raylib_compose_delete;
+}
+
+void lvgl_raylib_compose_draw_hole(lv_layer_t * layer, const lv_obj_t * obj, const lv_area_t * area)
+{
+    if (_unit == NULL) {
+        return;
+    }
+
+    // A fill task keeps the ordering and dependency tracking of LVGL's own tasks,
+    // lvgl_raylib_compose_evaluate() takes it while it's being added
+    lv_draw_fill_dsc_t dsc;
+    lv_draw_fill_dsc_init(&dsc);
+    dsc.base.obj = (lv_obj_t *)obj;
+    dsc.base.part = LVGL_RAYLIB_COMPOSE_PART_HOLE;
+    dsc.color = lv_color_black();
+    dsc.opa = LV_OPA_COVER;
+    _adding_hole = true;
+    lv_draw_fill(layer, &dsc, area);
+    _adding_hole = false;
+}
+
+void lvgl_raylib_compose_set_skip_cb(lvgl_raylib_compose_skip_cb_t skip_cb)
+{
+    _skip_cb = skip_cb;
+}
+
+bool lvgl_raylib_compose_get_clip(const lv_obj_t * obj, lv_area_t * clip)
+{
+    const lv_obj_t * screen = lv_obj_get_screen(obj);
+    if (screen != lv_screen_active() && screen != lv_layer_top() && screen != lv_layer_sys()) {
+        return false;
+    }
+
+    if (!lv_obj_is_visible(obj)) {
+        return false;
+    }
+
+    lv_obj_get_coords(obj, clip);
+
+    // Children are clipped to every ancestor that doesn't let them overflow
+    const lv_obj_t * parent = lv_obj_get_parent(obj);
+    while (parent != NULL) {
+        if (!lv_obj_has_flag(parent, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+            lv_area_t parent_coords;
+            lv_obj_get_coords(parent, &parent_coords);
+            if (!lv_area_intersect(clip, clip, &parent_coords)) {
+                return false;
+            }
+        }
+        parent = lv_obj_get_parent(parent);
+    }
+
+    lv_display_t * disp = lv_obj_get_display(obj);
+    lv_area_t disp_area = {
+        0, 0,
+        lv_display_get_horizontal_resolution(disp) - 1,
+        lv_display_get_vertical_resolution(disp) - 1
+    };
+    return lv_area_intersect(clip, clip, &disp_area);
+}
+
+bool lvgl_raylib_compose_for_each_above(const lv_obj_t * obj, const lv_area_t * area, lvgl_raylib_compose_above_cb_t cb, void * user_data)
+{
+    // Younger siblings of the object and of each of its ancestors are drawn after it
+    const lv_obj_t * cur = obj;
+    const lv_obj_t * parent = lv_obj_get_parent(cur);
+    while (parent != NULL) {
+        if (!lvgl_raylib_compose_visit_children(parent, lv_obj_get_index(cur) + 1, area, cb, user_data)) {
+            return false;
+        }
+        cur = parent;
+        parent = lv_obj_get_parent(cur);
+    }
+
+    // `cur` is now the screen; the top and system layers are drawn over it
+    if (cur != lv_layer_top() && cur != lv_layer_sys()) {
+        if (!lvgl_raylib_compose_visit_children(lv_layer_top(), 0, area, cb, user_data)) {
+            return false;
+        }
+    }
+    if (cur != lv_layer_sys()) {
+        if (!lvgl_raylib_compose_visit_children(lv_layer_sys(), 0, area, cb, user_data)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool lvgl_raylib_compose_is_covered(const lv_obj_t * obj, const lv_area_t * area)
+{
+    return !lvgl_raylib_compose_for_each_above(obj, area, &lvgl_raylib_compose_covered_cb, NULL);
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool lvgl_raylib_compose_visit_children(const lv_obj_t * parent, int32_t first, const lv_area_t * area, lvgl_raylib_compose_above_cb_t cb, void * user_data)
+{
+    if (parent == NULL) {
+        return true;
+    }
+
+    int32_t child_cnt = (int32_t)lv_obj_get_child_count(parent);
+    for (int32_t i = first; i < child_cnt; i++) {
+        const lv_obj_t * child = lv_obj_get_child(parent, i);
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+            continue;
+        }
+
+        // Include shadows and outlines drawn outside of the object's coordinates
+        lv_area_t obj_area;
+        lv_obj_get_coords(child, &obj_area);
+        int32_t ext = lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&obj_area, ext, ext);
+
+        lv_area_t overlap;
+        if (lv_area_intersect(&overlap, &obj_area, area) && !cb(child, &overlap, user_data)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool lvgl_raylib_compose_covered_cb(const lv_obj_t * obj, const lv_area_t * overlap, void * user_data)
+{
+    LV_UNUSED(obj);
+    LV_UNUSED(overlap);
+    LV_UNUSED(user_data);
+    return false;
+}
+
+static int32_t lvgl_raylib_compose_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * t)
+{
+    // Nothing else may draw holes or skipped tasks, a score of 0 beats every other unit
+    const lv_draw_dsc_base_t * base = (const lv_draw_dsc_base_t *)t->draw_dsc;
+    if (_adding_hole || lvgl_raylib_compose_is_skipped(base->obj)) {
+        t->preference_score = 0;
+        t->preferred_draw_unit_id = draw_unit->idx;
+    }
+    return 0;
+}
+
+static int32_t lvgl_raylib_compose_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    lv_draw_task_t * t = LVGL_RAYLIB_DRAW_GET_TASK(layer, draw_unit->idx);
+    if (t == NULL || t->preferred_draw_unit_id != draw_unit->idx) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    if (lv_draw_layer_alloc_buf(layer) == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    // Cutting is a few memsets, done right away on the dispatching thread. Skipped tasks,
+    // also holes of skipped objects, are only marked done.
+    int32_t cnt = 0;
+    while (t != NULL && t->preferred_draw_unit_id == draw_unit->idx) {
+        t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+        const lv_draw_dsc_base_t * base = (const lv_draw_dsc_base_t *)t->draw_dsc;
+        if (t->type == LV_DRAW_TASK_TYPE_FILL && base->part == LVGL_RAYLIB_COMPOSE_PART_HOLE
+            && !lvgl_raylib_compose_is_skipped(base->obj)) {
+            lvgl_raylib_compose_cut(t, layer);
+        }
+        t->state = LVGL_RAYLIB_DRAW_TASK_DONE;
+        cnt++;
+        t = LVGL_RAYLIB_DRAW_GET_TASK(layer, draw_unit->idx);
+    }
+
+    lv_draw_dispatch_request();
+    return cnt;
+}
+
+static int32_t lvgl_raylib_compose_delete(lv_draw_unit_t * draw_unit)
+{
+    if (draw_unit == _unit) {
+        _unit = NULL;
+    }
+    return 0;
+}
+
+static bool lvgl_raylib_compose_is_skipped(const lv_obj_t * obj)
+{
+    return _skip_cb != NULL && obj != NULL && _skip_cb(obj);
+}
+
+static void lvgl_raylib_compose_cut(lv_draw_task_t * t, lv_layer_t * layer)
+{
+    lv_draw_buf_t * buf = layer->draw_buf;
+    if (buf == NULL || buf->header.cf != LV_COLOR_FORMAT_ARGB8888) {
+        return;
+    }
+
+    lv_area_t area;
+    if (!lv_area_intersect(&area, &t->area, &t->clip_area) || !lv_area_intersect(&area, &area, &layer->buf_area)) {
+        return;
+    }
+
+    // Transparent black, whatever was drawn under the hole so far is gone
+    size_t len = (size_t)lv_area_get_width(&area) * 4;
+    uint8_t * row = buf->data + (area.y1 - layer->buf_area.y1) * buf->header.stride + (area.x1 - layer->buf_area.x1) * 4;
+    for (int32_t y = area.y1; y <= area.y2; y++) {
+        lv_memzero(row, len);
+        row += buf->header.stride;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef LVGL_RAYLIB_COMPOSE_H
+#define LVGL_RAYLIB_COMPOSE_H
+
+#include "lvgl.h"
+#include "raylib.h"
+#include <stdbool.h>
+
+/* public types */
+
+/** Called for every visible object above another one whose drawn area overlaps `overlap`. Return false to stop. */
+typedef bool (*lvgl_raylib_compose_above_cb_t)(const lv_obj_t * obj, const lv_area_t * overlap, void * user_data);
+
+/** Return true to drop the draw tasks of `obj`, e.g. when its pixels come from a texture instead. */
+typedef bool (*lvgl_raylib_compose_skip_cb_t)(const lv_obj_t * obj);
+
+/* public functions */
+
+/** Create the draw unit that cuts the holes composited content shows through. */
+void lvgl_raylib_compose_init(void);
+
+/**
+ * Make `area` of the layer transparent, in z-order with the other draw tasks: what
+ * lvgl_raylib_render() draws before the LVGL texture shows through it and objects
+ * drawn later in the frame blend over it. Only 32 bit layers are cut.
+ */
+void lvgl_raylib_compose_draw_hole(lv_layer_t * layer, const lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Drop the draw tasks of the objects `skip_cb` picks. LVGL still lays them out, sends
+ * their draw events and redraws what is around them, only their pixels are left out.
+ */
+void lvgl_raylib_compose_set_skip_cb(lvgl_raylib_compose_skip_cb_t skip_cb);
+
+/**
+ * Compute the part of an object that is visible on the display, clipped by all
+ * of its ancestors (the way LVGL clips it while drawing).
+ * Returns false when the object is hidden, not on a shown screen or fully clipped.
+ */
+bool lvgl_raylib_compose_get_clip(const lv_obj_t * obj, lv_area_t * clip);
+
+/**
+ * Visit the objects drawn after `obj` (younger siblings of it and its ancestors,
+ * then the top and system layers) that overlap `area`.
+ * Returns false if the callback stopped the walk.
+ */
+bool lvgl_raylib_compose_for_each_above(const lv_obj_t * obj, const lv_area_t * area, lvgl_raylib_compose_above_cb_t cb, void * user_data);
+
+/** Check whether anything is drawn above `obj` inside `area`. */
+bool lvgl_raylib_compose_is_covered(const lv_obj_t * obj, const lv_area_t * area);
+
+#endif
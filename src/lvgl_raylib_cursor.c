@@ -0,0 +1,198 @@
+#include <stdbool.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_cursor.h"
+#include "lvgl_raylib_hit.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_CURSOR_SHAPE_CNT (MOUSE_CURSOR_NOT_ALLOWED + 1)
+
+/* private prototypes */
+
+static lvgl_raylib_cursor_hint_t * lvgl_raylib_cursor_find_hint(const lv_obj_t * obj);
+static int lvgl_raylib_cursor_resolve_shape(Vector2 pos);
+static void lvgl_raylib_cursor_apply_shape(int shape);
+static void lvgl_raylib_cursor_unload_sprite(int shape);
+static void lvgl_raylib_cursor_delete_cb(lv_event_t * e);
+
+/* static variables */
+
+static lv_ll_t _hints;
+static lvgl_raylib_cursor_sprite_t _sprites[LVGL_RAYLIB_CURSOR_SHAPE_CNT];
+static Vector2 _last_pos = { -1, -1 };
+static lv_obj_t * _last_screen = NULL;
+static bool _hints_changed = false;
+static int _shape = MOUSE_CURSOR_DEFAULT;
+static bool _os_cursor_hidden = false;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_cursor_init(void)
+{
+    lv_ll_init(&_hints, sizeof(lvgl_raylib_cursor_hint_t));
+    memset(_sprites, 0, sizeof(_sprites));
+}
+
+void lvgl_raylib_cursor_set_texture(int shape, Texture2D texture, Vector2 hotspot)
+{
+    if (shape < 0 || shape >= LVGL_RAYLIB_CURSOR_SHAPE_CNT) {
+        TraceLog(LOG_WARNING, "Invalid cursor shape %d", shape);
+        return;
+    }
+
+    lvgl_raylib_cursor_unload_sprite(shape);
+    _sprites[shape].texture = texture;
+    _sprites[shape].hotspot = hotspot;
+    _sprites[shape].owned = false;
+    _hints_changed = true;
+}
+
+void lvgl_raylib_cursor_set_image(int shape, Image image, Vector2 hotspot)
+{
+    if (shape < 0 || shape >= LVGL_RAYLIB_CURSOR_SHAPE_CNT) {
+        TraceLog(LOG_WARNING, "Invalid cursor shape %d", shape);
+        return;
+    }
+
+    lvgl_raylib_cursor_unload_sprite(shape);
+    _sprites[shape].texture = LoadTextureFromImage(image);
+    _sprites[shape].hotspot = hotspot;
+    _sprites[shape].owned = true;
+    _hints_changed = true;
+}
+
+void lvgl_raylib_cursor_set_obj_shape(lv_obj_t * obj, int shape)
+{
+    lvgl_raylib_cursor_hint_t * hint = lvgl_raylib_cursor_find_hint(obj);
+    if (hint == NULL) {
+        hint = lv_ll_ins_tail(&_hints);
+        if (hint == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate cursor hint");
+            return;
+        }
+        hint->obj = obj;
+        lv_obj_add_event_cb(obj, &lvgl_raylib_cursor_delete_cb, LV_EVENT_DELETE, NULL);
+    }
+
+    hint->shape = shape;
+    _hints_changed = true;
+}
+
+void lvgl_raylib_cursor_update(void)
+{
+    // Resolve the shape only when the pointer, the screen or the hints changed;
+    // the LVGL display is never touched by cursor motion
+    Vector2 pos = GetMousePosition();
+    lv_obj_t * screen = lv_screen_active();
+    if (pos.x == _last_pos.x && pos.y == _last_pos.y && screen == _last_screen && !_hints_changed) {
+        return;
+    }
+
+    _last_pos = pos;
+    _last_screen = screen;
+    _hints_changed = false;
+
+    lvgl_raylib_cursor_apply_shape(lvgl_raylib_cursor_resolve_shape(pos));
+}
+
+void lvgl_raylib_cursor_render(void)
+{
+    const lvgl_raylib_cursor_sprite_t * sprite = &_sprites[_shape];
+    if (sprite->texture.id == 0 || !IsCursorOnScreen()) {
+        return;
+    }
+
+    // Sample the position at composition time so the sprite never lags a frame
+    Vector2 pos = GetMousePosition();
+    DrawTextureV(sprite->texture, (Vector2){ pos.x - sprite->hotspot.x, pos.y - sprite->hotspot.y }, WHITE);
+}
+
+void lvgl_raylib_cursor_deinit(void)
+{
+    for (int i = 0; i < LVGL_RAYLIB_CURSOR_SHAPE_CNT; i++) {
+        lvgl_raylib_cursor_unload_sprite(i);
+    }
+    lv_ll_clear(&_hints);
+
+    if (_os_cursor_hidden) {
+        ShowCursor();
+        _os_cursor_hidden = false;
+    }
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_cursor_hint_t * lvgl_raylib_cursor_find_hint(const lv_obj_t * obj)
+{
+    lvgl_raylib_cursor_hint_t * hint;
+    LV_LL_READ(&_hints, hint) {
+        if (hint->obj == obj) {
+            return hint;
+        }
+    }
+    return NULL;
+}
+
+static int lvgl_raylib_cursor_resolve_shape(Vector2 pos)
+{
+    if (lv_ll_is_empty(&_hints)) {
+        return MOUSE_CURSOR_DEFAULT;
+    }
+
+    lv_point_t point = { (int32_t)pos.x, (int32_t)pos.y };
+    lv_obj_t * obj = lvgl_raylib_hit_search_display(&point);
+
+    // The closest ancestor with a hint decides, like inherited CSS cursors
+    while (obj != NULL) {
+        lvgl_raylib_cursor_hint_t * hint = lvgl_raylib_cursor_find_hint(obj);
+        if (hint != NULL) {
+            return hint->shape;
+        }
+        obj = lv_obj_get_parent(obj);
+    }
+
+    return MOUSE_CURSOR_DEFAULT;
+}
+
+static void lvgl_raylib_cursor_apply_shape(int shape)
+{
+    if (shape < 0 || shape >= LVGL_RAYLIB_CURSOR_SHAPE_CNT) {
+        shape = MOUSE_CURSOR_DEFAULT;
+    }
+
+    bool sprite = _sprites[shape].texture.id != 0;
+    if (sprite && !_os_cursor_hidden) {
+        HideCursor();
+        _os_cursor_hidden = true;
+    } else if (!sprite && _os_cursor_hidden) {
+        ShowCursor();
+        _os_cursor_hidden = false;
+    }
+
+    // Shapes without a sprite use the system cursor of the same kind
+    if (!sprite && shape != _shape) {
+        SetMouseCursor(shape);
+    }
+
+    _shape = shape;
+}
+
+static void lvgl_raylib_cursor_unload_sprite(int shape)
+{
+    if (_sprites[shape].owned && _sprites[shape].texture.id != 0) {
+        UnloadTexture(_sprites[shape].texture);
+    }
+    memset(&_sprites[shape], 0, sizeof(_sprites[shape]));
+}
+
+static void lvgl_raylib_cursor_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_cursor_hint_t * hint = lvgl_raylib_cursor_find_hint(lv_event_get_target(e));
+    if (hint != NULL) {
+        lv_ll_remove(&_hints, hint);
+        lv_free(hint);
+        _hints_changed = true;
+    }
+}
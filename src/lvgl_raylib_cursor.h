@@ -0,0 +1,28 @@
+#ifndef LVGL_RAYLIB_CURSOR_H
+#define LVGL_RAYLIB_CURSOR_H
+
+#include <stdbool.h>
+#include "lvgl.h"
+#include "raylib.h"
+
+/* public types */
+
+typedef struct {
+    Texture2D texture;
+    Vector2 hotspot;
+    bool owned;                 // loaded from an Image by the binding
+} lvgl_raylib_cursor_sprite_t;
+
+typedef struct {
+    lv_obj_t * obj;
+    int shape;
+} lvgl_raylib_cursor_hint_t;
+
+/* public functions */
+
+void lvgl_raylib_cursor_init(void);
+void lvgl_raylib_cursor_update(void);
+void lvgl_raylib_cursor_render(void);
+void lvgl_raylib_cursor_deinit(void);
+
+#endif
@@ -0,0 +1,452 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_decoder.h"
+#include "lvgl_raylib_budget.h"
+#include "lvgl_raylib_draw_gpu.h"
+#include "lvgl_raylib_fs.h"
+#include "lvgl_raylib_mem.h"
+
+/* private prototypes */
+
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_add(const void * src, lv_image_src_t src_type, Image * image, float decode_ms);
+static lv_result_t lvgl_raylib_decoder_info_cb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc, lv_image_header_t * header);
+static lv_result_t lvgl_raylib_decoder_open_cb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static void lvgl_raylib_decoder_close_cb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_get(const void * src, lv_image_src_t src_type);
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_find(const void * src, lv_image_src_t src_type);
+static const char * lvgl_raylib_decoder_file_type(const void * src, lv_image_src_t src_type);
+static uint8_t * lvgl_raylib_decoder_read_file(lv_fs_file_t * file, const char * path, uint32_t * size);
+static void lvgl_raylib_decoder_remove(lvgl_raylib_decoded_image_t * image);
+static void lvgl_raylib_decoder_trim(uint32_t max_size);
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_oldest(void);
+static uint32_t lvgl_raylib_decoder_budget_size_cb(void);
+static bool lvgl_raylib_decoder_budget_oldest_cb(uint32_t * last_used);
+static void lvgl_raylib_decoder_budget_evict_cb(void);
+static void lvgl_raylib_decoder_lock(void);
+static void lvgl_raylib_decoder_unlock(void);
+
+/* static variables */
+
+static lv_image_decoder_t * _decoder = NULL;
+static lv_ll_t _images;
+static lvgl_raylib_decoder_stats_t _stats = {0};
+#if LV_USE_OS != LV_OS_NONE
+// Images are opened and closed on the draw threads, headers read and loader results
+// inserted on the main thread
+static lv_mutex_t _mutex;
+#endif
+static lvgl_raylib_budget_cache_t _budget = {
+    .name = "decoded images",
+    .cost = LVGL_RAYLIB_BUDGET_COST_DECODE,
+    .get_size_cb = &lvgl_raylib_decoder_budget_size_cb,
+    .get_oldest_cb = &lvgl_raylib_decoder_budget_oldest_cb,
+    .evict_oldest_cb = &lvgl_raylib_decoder_budget_evict_cb,
+};
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_decoder_init(void)
+{
+    lv_ll_init(&_images, sizeof(lvgl_raylib_decoded_image_t));
+    _stats.max_size = LVGL_RAYLIB_DECODER_CACHE_SIZE;
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&_mutex);
+#endif
+    lvgl_raylib_budget_register(&_budget);
+
+    _decoder = lv_image_decoder_create();
+    if (_decoder == NULL) {
+        TraceLog(LOG_ERROR, "Failed to create LVGL Raylib image decoder");
+        return;
+    }
+    lv_image_decoder_set_info_cb(_decoder, lvgl_raylib_decoder_info_cb);
+    lv_image_decoder_set_open_cb(_decoder, lvgl_raylib_decoder_open_cb);
+    lv_image_decoder_set_close_cb(_decoder, lvgl_raylib_decoder_close_cb);
+}
+
+void lvgl_raylib_decoder_set_cache_size(uint32_t max_size)
+{
+    lvgl_raylib_decoder_lock();
+    _stats.max_size = max_size;
+    lvgl_raylib_decoder_trim(max_size);
+    lvgl_raylib_decoder_unlock();
+}
+
+void lvgl_raylib_decoder_get_stats(lvgl_raylib_decoder_stats_t * stats)
+{
+    lvgl_raylib_decoder_lock();
+    *stats = _stats;
+    lvgl_raylib_decoder_unlock();
+}
+
+void lvgl_raylib_decoder_drop(const void * src)
+{
+    bool is_file = src != NULL && lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE;
+    lvgl_raylib_decoder_lock();
+    lvgl_raylib_decoded_image_t * image = lv_ll_get_head(&_images);
+    while (image != NULL) {
+        lvgl_raylib_decoded_image_t * next = lv_ll_get_next(&_images, image);
+        bool match = src == NULL || image->src == src || (is_file && image->path != NULL && strcmp(image->path, src) == 0);
+        if (match && image->ref_cnt == 0) {
+            lvgl_raylib_decoder_remove(image);
+        }
+        image = next;
+    }
+    lvgl_raylib_decoder_unlock();
+    lvgl_raylib_draw_gpu_image_drop(src);
+}
+
+bool lvgl_raylib_decoder_load(const void * src, lv_image_src_t src_type, Image * image)
+{
+    const char * file_type = lvgl_raylib_decoder_file_type(src, src_type);
+    if (file_type == NULL) {
+        return false;
+    }
+
+    Image loaded = { 0 };
+    if (src_type == LV_IMAGE_SRC_FILE) {
+        // Read through lv_fs so drive letters work the same as for every other decoder,
+        // files on the mapped drive are decoded in place
+        lv_fs_file_t file;
+        if (lv_fs_open(&file, src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            TraceLog(LOG_WARNING, "Failed to open image file %s", (const char *)src);
+            return false;
+        }
+        uint32_t size = 0;
+        const uint8_t * mapped = lvgl_raylib_fs_get_data(&file, &size);
+        uint8_t * data = mapped == NULL ? lvgl_raylib_decoder_read_file(&file, src, &size) : NULL;
+        if (mapped != NULL || data != NULL) {
+            loaded = LoadImageFromMemory(file_type, mapped != NULL ? mapped : data, (int)size);
+        }
+        lv_free(data);
+        lv_fs_close(&file);
+    } else {
+        const lv_image_dsc_t * dsc = src;
+        loaded = LoadImageFromMemory(file_type, dsc->data, (int)dsc->data_size);
+    }
+    if (!IsImageValid(loaded)) {
+        TraceLog(LOG_WARNING, "raylib could not decode image");
+        return false;
+    }
+
+    // R,G,B,A to LVGL's B,G,R,A once, premultiplied so blending skips the multiply
+    ImageFormat(&loaded, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    uint8_t * px = loaded.data;
+    for (int32_t i = 0; i < loaded.width * loaded.height; i++) {
+        uint8_t r = px[0];
+        uint8_t a = px[3];
+        px[0] = (uint8_t)((px[2] * a) / 255);
+        px[1] = (uint8_t)((px[1] * a) / 255);
+        px[2] = (uint8_t)((r * a) / 255);
+        px += 4;
+    }
+    *image = loaded;
+    return true;
+}
+
+bool lvgl_raylib_decoder_insert(const void * src, lv_image_src_t src_type, Image * image, float decode_ms)
+{
+    // Cache entries outlive the screen being built, they never come from its arena
+    lvgl_raylib_decoder_lock();
+    lvgl_raylib_mem_main_begin();
+    bool ok = lvgl_raylib_decoder_add(src, src_type, image, decode_ms) != NULL;
+    lvgl_raylib_mem_main_end();
+    lvgl_raylib_decoder_unlock();
+    return ok;
+}
+
+bool lvgl_raylib_decoder_is_cached(const void * src, lv_image_src_t src_type)
+{
+    lvgl_raylib_decoder_lock();
+    bool cached = lvgl_raylib_decoder_find(src, src_type) != NULL;
+    lvgl_raylib_decoder_unlock();
+    return cached;
+}
+
+void lvgl_raylib_decoder_deinit(void)
+{
+    lvgl_raylib_budget_unregister(&_budget);
+    if (_decoder != NULL) {
+        lv_image_decoder_delete(_decoder);
+        _decoder = NULL;
+    }
+
+    lvgl_raylib_decoded_image_t * image = lv_ll_get_head(&_images);
+    while (image != NULL) {
+        lvgl_raylib_decoded_image_t * next = lv_ll_get_next(&_images, image);
+        lvgl_raylib_decoder_remove(image);
+        image = next;
+    }
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_delete(&_mutex);
+#endif
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_add(const void * src, lv_image_src_t src_type, Image * image, float decode_ms)
+{
+    // Decoded outside the lock, another thread may have cached the same source meanwhile
+    lvgl_raylib_decoded_image_t * entry = lvgl_raylib_decoder_find(src, src_type);
+    if (entry != NULL) {
+        UnloadImage(*image);
+        return entry;
+    }
+
+    lv_draw_buf_t * decoded = lv_draw_buf_create((uint32_t)image->width, (uint32_t)image->height, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if (decoded == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate %dx%d decoded image", image->width, image->height);
+        UnloadImage(*image);
+        return NULL;
+    }
+    for (int32_t y = 0; y < image->height; y++) {
+        memcpy(decoded->data + y * decoded->header.stride, (uint8_t *)image->data + y * image->width * 4, (size_t)image->width * 4);
+    }
+    decoded->header.flags |= LV_IMAGE_FLAGS_PREMULTIPLIED;
+    UnloadImage(*image);
+    _stats.decodes++;
+    _stats.decode_ms_last = decode_ms;
+    _stats.decode_ms_total += decode_ms;
+
+    // Make room first, the new entry must not be the one evicted
+    uint32_t size = decoded->data_size;
+    lvgl_raylib_decoder_trim(size < _stats.max_size ? _stats.max_size - size : 0);
+
+    entry = lv_ll_ins_head(&_images);
+    if (entry == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate decoded image cache entry");
+        lv_draw_buf_destroy(decoded);
+        return NULL;
+    }
+    entry->src = src_type == LV_IMAGE_SRC_FILE ? NULL : src;
+    entry->path = src_type == LV_IMAGE_SRC_FILE ? lv_strdup(src) : NULL;
+    entry->decoded = decoded;
+    entry->size = size;
+    entry->ref_cnt = 0;
+    entry->last_used = lvgl_raylib_budget_touch();
+    _stats.entries++;
+    _stats.size += entry->size;
+    return entry;
+}
+
+static lv_result_t lvgl_raylib_decoder_info_cb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc, lv_image_header_t * header)
+{
+    LV_UNUSED(decoder);
+    if (lvgl_raylib_decoder_file_type(dsc->src, dsc->src_type) == NULL) {
+        return LV_RESULT_INVALID;
+    }
+
+    // raylib can't read only the header, the whole image is decoded and kept for the open call
+    lvgl_raylib_decoder_lock();
+    lvgl_raylib_decoded_image_t * image = lvgl_raylib_decoder_get(dsc->src, dsc->src_type);
+    if (image != NULL) {
+        *header = image->decoded->header;
+        header->flags &= ~(LV_IMAGE_FLAGS_MODIFIABLE | LV_IMAGE_FLAGS_ALLOCATED);
+    }
+    lvgl_raylib_decoder_unlock();
+    return image != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+static lv_result_t lvgl_raylib_decoder_open_cb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    lvgl_raylib_decoder_lock();
+    lvgl_raylib_decoded_image_t * image = lvgl_raylib_decoder_get(dsc->src, dsc->src_type);
+    if (image == NULL) {
+        lvgl_raylib_decoder_unlock();
+        return LV_RESULT_INVALID;
+    }
+
+    // Held until close so the cache can't free it while it is being drawn
+    image->ref_cnt++;
+    lvgl_raylib_decoder_unlock();
+    dsc->user_data = image;
+    dsc->decoded = image->decoded;
+    return LV_RESULT_OK;
+}
+
+static void lvgl_raylib_decoder_close_cb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    lvgl_raylib_decoded_image_t * image = dsc->user_data;
+    lvgl_raylib_decoder_lock();
+    if (image != NULL && image->ref_cnt > 0) {
+        image->ref_cnt--;
+    }
+    lvgl_raylib_decoder_trim(_stats.max_size);
+    lvgl_raylib_decoder_unlock();
+}
+
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_get(const void * src, lv_image_src_t src_type)
+{
+    // Called and returns locked, the lock is released while decoding so other threads
+    // keep drawing cached images
+    lvgl_raylib_decoded_image_t * image = lvgl_raylib_decoder_find(src, src_type);
+    if (image != NULL) {
+        image->last_used = lvgl_raylib_budget_touch();
+        _stats.hits++;
+        return image;
+    }
+    _stats.misses++;
+    lvgl_raylib_decoder_unlock();
+
+    double start = GetTime();
+    Image decoded = { 0 };
+    bool ok = lvgl_raylib_decoder_load(src, src_type, &decoded);
+    lvgl_raylib_decoder_lock();
+    if (!ok) {
+        return NULL;
+    }
+    lvgl_raylib_mem_main_begin();
+    image = lvgl_raylib_decoder_add(src, src_type, &decoded, (float)((GetTime() - start) * 1000.0));
+    lvgl_raylib_mem_main_end();
+    return image;
+}
+
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_find(const void * src, lv_image_src_t src_type)
+{
+    lvgl_raylib_decoded_image_t * image;
+    LV_LL_READ(&_images, image) {
+        if (src_type == LV_IMAGE_SRC_FILE ? (image->path != NULL && strcmp(image->path, src) == 0) : image->src == src) {
+            return image;
+        }
+    }
+    return NULL;
+}
+
+static const char * lvgl_raylib_decoder_file_type(const void * src, lv_image_src_t src_type)
+{
+    if (src_type == LV_IMAGE_SRC_FILE) {
+        static const char * exts[] = { "png", "bmp", "tga", "jpg", "jpeg", "gif", "qoi", "psd", "hdr" };
+        static const char * types[] = { ".png", ".bmp", ".tga", ".jpg", ".jpg", ".gif", ".qoi", ".psd", ".hdr" };
+        const char * ext = lv_fs_get_ext(src);
+        for (size_t i = 0; i < sizeof(exts) / sizeof(exts[0]); i++) {
+            if (lv_strcmp(ext, exts[i]) == 0) {
+                return types[i];
+            }
+        }
+        return NULL;
+    }
+
+    // Encoded files embedded as RAW image descriptors are recognized by their magic bytes
+    if (src_type == LV_IMAGE_SRC_VARIABLE) {
+        const lv_image_dsc_t * dsc = src;
+        if ((dsc->header.cf != LV_COLOR_FORMAT_RAW && dsc->header.cf != LV_COLOR_FORMAT_RAW_ALPHA)
+            || dsc->data == NULL || dsc->data_size < 4) {
+            return NULL;
+        }
+        const uint8_t * d = dsc->data;
+        if (d[0] == 0x89 && d[1] == 'P' && d[2] == 'N' && d[3] == 'G') return ".png";
+        if (d[0] == 'q' && d[1] == 'o' && d[2] == 'i' && d[3] == 'f') return ".qoi";
+        if (d[0] == 0xFF && d[1] == 0xD8 && d[2] == 0xFF) return ".jpg";
+        if (d[0] == 'G' && d[1] == 'I' && d[2] == 'F') return ".gif";
+        if (d[0] == 'B' && d[1] == 'M') return ".bmp";
+    }
+    return NULL;
+}
+
+static uint8_t * lvgl_raylib_decoder_read_file(lv_fs_file_t * file, const char * path, uint32_t * size)
+{
+    uint8_t * data = NULL;
+    uint32_t file_size = 0;
+    if (lv_fs_seek(file, 0, LV_FS_SEEK_END) == LV_FS_RES_OK && lv_fs_tell(file, &file_size) == LV_FS_RES_OK
+        && file_size > 0 && lv_fs_seek(file, 0, LV_FS_SEEK_SET) == LV_FS_RES_OK) {
+        data = lv_malloc(file_size);
+        uint32_t read = 0;
+        if (data != NULL && (lv_fs_read(file, data, file_size, &read) != LV_FS_RES_OK || read != file_size)) {
+            lv_free(data);
+            data = NULL;
+        }
+    }
+
+    if (data == NULL) {
+        TraceLog(LOG_WARNING, "Failed to read image file %s", path);
+        return NULL;
+    }
+    *size = file_size;
+    return data;
+}
+
+static void lvgl_raylib_decoder_remove(lvgl_raylib_decoded_image_t * image)
+{
+    _stats.entries--;
+    _stats.size -= image->size;
+    lv_draw_buf_destroy(image->decoded);
+    lv_free(image->path);
+    lv_ll_remove(&_images, image);
+    lv_free(image);
+}
+
+static void lvgl_raylib_decoder_trim(uint32_t max_size)
+{
+    // Least recently used first; images still open are skipped and go once closed
+    while (_stats.size > max_size) {
+        lvgl_raylib_decoded_image_t * oldest = lvgl_raylib_decoder_oldest();
+        if (oldest == NULL) {
+            break;
+        }
+        lvgl_raylib_decoder_remove(oldest);
+        _stats.evictions++;
+    }
+}
+
+static lvgl_raylib_decoded_image_t * lvgl_raylib_decoder_oldest(void)
+{
+    uint32_t now = lvgl_raylib_budget_now();
+    lvgl_raylib_decoded_image_t * oldest = NULL;
+    lvgl_raylib_decoded_image_t * image;
+    LV_LL_READ(&_images, image) {
+        if (image->ref_cnt == 0 && (oldest == NULL || now - image->last_used > now - oldest->last_used)) {
+            oldest = image;
+        }
+    }
+    return oldest;
+}
+
+static uint32_t lvgl_raylib_decoder_budget_size_cb(void)
+{
+    lvgl_raylib_decoder_lock();
+    uint32_t size = _stats.size;
+    lvgl_raylib_decoder_unlock();
+    return size;
+}
+
+static bool lvgl_raylib_decoder_budget_oldest_cb(uint32_t * last_used)
+{
+    lvgl_raylib_decoder_lock();
+    lvgl_raylib_decoded_image_t * oldest = lvgl_raylib_decoder_oldest();
+    if (oldest != NULL) {
+        *last_used = oldest->last_used;
+    }
+    lvgl_raylib_decoder_unlock();
+    return oldest != NULL;
+}
+
+static void lvgl_raylib_decoder_budget_evict_cb(void)
+{
+    lvgl_raylib_decoder_lock();
+    lvgl_raylib_decoded_image_t * oldest = lvgl_raylib_decoder_oldest();
+    if (oldest != NULL) {
+        lvgl_raylib_decoder_remove(oldest);
+        _stats.evictions++;
+    }
+    lvgl_raylib_decoder_unlock();
+}
+
+static void lvgl_raylib_decoder_lock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_lock(&_mutex);
+#endif
+}
+
+static void lvgl_raylib_decoder_unlock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_unlock(&_mutex);
+#endif
+}
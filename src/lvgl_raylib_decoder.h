@@ -0,0 +1,39 @@
+#ifndef LVGL_RAYLIB_DECODER_H
+#define LVGL_RAYLIB_DECODER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Default budget of decoded images in bytes */
+#define LVGL_RAYLIB_DECODER_CACHE_SIZE (16 * 1024 * 1024)
+
+/* public types */
+
+/** A decoded image, premultiplied ARGB8888 in LVGL's layout */
+typedef struct {
+    const void * src;           // variable sources, NULL for files
+    char * path;                // file sources
+    lv_draw_buf_t * decoded;
+    uint32_t size;
+    uint32_t ref_cnt;           // open decoder descriptors using it
+    uint32_t last_used;
+} lvgl_raylib_decoded_image_t;
+
+/* public functions */
+
+void lvgl_raylib_decoder_init(void);
+
+/** Read and decode to premultiplied B,G,R,A in place, safe on any thread */
+bool lvgl_raylib_decoder_load(const void * src, lv_image_src_t src_type, Image * image);
+
+/** Move an image from lvgl_raylib_decoder_load into the cache */
+bool lvgl_raylib_decoder_insert(const void * src, lv_image_src_t src_type, Image * image, float decode_ms);
+bool lvgl_raylib_decoder_is_cached(const void * src, lv_image_src_t src_type);
+void lvgl_raylib_decoder_deinit(void);
+
+#endif
@@ -76,18 +76,26 @@ static void lvgl_raylib_display_flush_cb(lv_display_t * disp, const lv_area_t* a
     int32_t display_total_width = lv_display_get_horizontal_resolution(disp);
     unsigned char* img_data_buffer = (unsigned char*)display->raylib_img.data;
 
-    // px_map is from LVGL, format is LV_COLOR_FORMAT_ARGB8888.
+    unsigned char* dst = img_data_buffer + (y_start * display_total_width + x_start) * 4;
+    lvgl_raylib_display_convert_argb8888(dst, display_total_width * 4, px_map, area_width * 4, area_width, area_height);
+
+    display->texture_updated = true;
+    lv_display_flush_ready(disp);
+}
+
+void lvgl_raylib_display_convert_argb8888(uint8_t * dst, uint32_t dst_stride, const uint8_t * src, uint32_t src_stride, uint32_t width, uint32_t height) {
+    // src is LV_COLOR_FORMAT_ARGB8888.
     // On little-endian systems, this means memory layout is B, G, R, A for each pixel.
     // When read as a uint32_t, it's (A << 24) | (R << 16) | (G << 8) | B.
-    // Raylib's raylib_img.data is PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
+    // dst is Raylib's PIXELFORMAT_UNCOMPRESSED_R8G8B8A8,
     // meaning memory layout R, G, B, A for each pixel.
     // When writing as a uint32_t, it should be (A << 24) | (B << 16) | (G << 8) | R.
 
-    for (uint32_t y = 0; y < area_height; y++) {
-        uint32_t* src_row_ptr_32 = (uint32_t*)(px_map + (y * area_width * 4));
-        uint32_t* dst_row_ptr_32 = (uint32_t*)(img_data_buffer + ((y_start + y) * display_total_width + x_start) * 4);
+    for (uint32_t y = 0; y < height; y++) {
+        const uint32_t* src_row_ptr_32 = (const uint32_t*)(src + y * src_stride);
+        uint32_t* dst_row_ptr_32 = (uint32_t*)(dst + y * dst_stride);
 
-        for (uint32_t x = 0; x < area_width; x++) {
+        for (uint32_t x = 0; x < width; x++) {
             uint32_t src_pixel_value = src_row_ptr_32[x]; 
             // src_pixel_value on little-endian is (A_src << 24) | (R_src << 16) | (G_src << 8) | B_src
 
@@ -102,9 +110,6 @@ static void lvgl_raylib_display_flush_cb(lv_display_t * disp, const lv_area_t* a
             dst_row_ptr_32[x] = (a_comp << 24) | (b_comp << 16) | (g_comp << 8) | r_comp;
         }
     }
-
-    display->texture_updated = true;
-    lv_display_flush_ready(disp);
 }
 
 void lvgl_raylib_display_destroy(lvgl_raylib_display_t * display) {
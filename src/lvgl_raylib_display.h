@@ -4,6 +4,7 @@
 #include "lvgl.h"
 #include "raylib.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /* public types */
 
@@ -21,5 +22,6 @@ typedef struct {
 
 void lvgl_raylib_display_create(lvgl_raylib_display_t * display, int width, int height);
 void lvgl_raylib_display_destroy(lvgl_raylib_display_t * display);
+void lvgl_raylib_display_convert_argb8888(uint8_t * dst, uint32_t dst_stride, const uint8_t * src, uint32_t src_stride, uint32_t width, uint32_t height);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,342 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(_WIN32)
+    #include <malloc.h>
+#elif defined(__linux__)
+    #include <sys/mman.h>
+#endif
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_draw_buf.h"
+#include "lvgl_raylib_budget.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_DRAW_BUF_HEADER LVGL_RAYLIB_DRAW_BUF_ALIGN
+
+/* private prototypes */
+
+static void * lvgl_raylib_draw_buf_malloc_cb(size_t size, lv_color_format_t color_format);
+static void lvgl_raylib_draw_buf_free_cb(void * buf);
+static uint32_t lvgl_raylib_draw_buf_class(size_t size, size_t * class_size);
+static lvgl_raylib_draw_buf_block_t * lvgl_raylib_draw_buf_alloc_block(size_t size, uint32_t class_idx);
+static void lvgl_raylib_draw_buf_free_block(lvgl_raylib_draw_buf_block_t * block);
+static void lvgl_raylib_draw_buf_unlink(lvgl_raylib_draw_buf_block_t * block);
+static lvgl_raylib_draw_buf_block_t * lvgl_raylib_draw_buf_oldest(void);
+static void lvgl_raylib_draw_buf_trim(uint32_t max_size);
+static void lvgl_raylib_draw_buf_lock(void);
+static void lvgl_raylib_draw_buf_unlock(void);
+static uint32_t lvgl_raylib_draw_buf_budget_size_cb(void);
+static bool lvgl_raylib_draw_buf_budget_oldest_cb(uint32_t * last_used);
+static void lvgl_raylib_draw_buf_budget_evict_cb(void);
+
+/* static variables */
+
+static lvgl_raylib_draw_buf_block_t * _idle_head[LVGL_RAYLIB_DRAW_BUF_CLASS_CNT];
+static lvgl_raylib_draw_buf_block_t * _idle_tail[LVGL_RAYLIB_DRAW_BUF_CLASS_CNT];
+static lvgl_raylib_draw_buf_stats_t _stats = {0};
+static bool _pooling = false;
+#if LV_USE_OS != LV_OS_NONE
+// Layers are allocated by the draw threads, decoded images by theirs
+static lv_mutex_t _mutex;
+#endif
+
+// An idle buffer only costs a malloc to get back
+static lvgl_raylib_budget_cache_t _budget = {
+    .name = "idle draw buffers",
+    .cost = LVGL_RAYLIB_BUDGET_COST_UPLOAD,
+    .get_size_cb = &lvgl_raylib_draw_buf_budget_size_cb,
+    .get_oldest_cb = &lvgl_raylib_draw_buf_budget_oldest_cb,
+    .evict_oldest_cb = &lvgl_raylib_draw_buf_budget_evict_cb,
+};
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_draw_buf_init(void)
+{
+    LV_ASSERT(sizeof(lvgl_raylib_draw_buf_block_t) <= LVGL_RAYLIB_DRAW_BUF_HEADER);
+
+    memset(_idle_head, 0, sizeof(_idle_head));
+    memset(_idle_tail, 0, sizeof(_idle_tail));
+    memset(&_stats, 0, sizeof(_stats));
+    _stats.max_idle_size = LVGL_RAYLIB_DRAW_BUF_POOL_SIZE;
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&_mutex);
+#endif
+    _pooling = true;
+
+    // Every buffer LVGL creates with the default handlers, layers and display buffers included
+    lv_draw_buf_handlers_t * handlers = lv_draw_buf_get_handlers();
+    handlers->buf_malloc_cb = &lvgl_raylib_draw_buf_malloc_cb;
+    handlers->buf_free_cb = &lvgl_raylib_draw_buf_free_cb;
+
+    lvgl_raylib_budget_register(&_budget);
+}
+
+void lvgl_raylib_draw_buf_set_pool_size(uint32_t max_size)
+{
+    lvgl_raylib_draw_buf_lock();
+    _stats.max_idle_size = max_size;
+    lvgl_raylib_draw_buf_trim(max_size);
+    lvgl_raylib_draw_buf_unlock();
+}
+
+void lvgl_raylib_draw_buf_get_stats(lvgl_raylib_draw_buf_stats_t * stats)
+{
+    lvgl_raylib_draw_buf_lock();
+    *stats = _stats;
+    lvgl_raylib_draw_buf_unlock();
+}
+
+void lvgl_raylib_draw_buf_deinit(void)
+{
+    lvgl_raylib_budget_unregister(&_budget);
+
+    // Buffers still alive are freed directly whenever they come back
+    lvgl_raylib_draw_buf_lock();
+    lvgl_raylib_draw_buf_trim(0);
+    lvgl_raylib_draw_buf_unlock();
+    _pooling = false;
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_delete(&_mutex);
+#endif
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static void * lvgl_raylib_draw_buf_malloc_cb(size_t size, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+
+    size_t class_size;
+    uint32_t class_idx = lvgl_raylib_draw_buf_class(size, &class_size);
+
+    lvgl_raylib_draw_buf_lock();
+    _stats.allocs++;
+
+    // Most recently freed first, its pages are the likeliest to be warm
+    lvgl_raylib_draw_buf_block_t * block = class_idx < LVGL_RAYLIB_DRAW_BUF_CLASS_CNT ? _idle_head[class_idx] : NULL;
+    if (block != NULL) {
+        lvgl_raylib_draw_buf_unlink(block);
+        _stats.idle--;
+        _stats.idle_size -= (uint32_t)block->size;
+        _stats.pool_hits++;
+    } else {
+        _stats.pool_misses++;
+        lvgl_raylib_draw_buf_unlock();
+        block = lvgl_raylib_draw_buf_alloc_block(class_size, class_idx);
+        if (block == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate %u byte draw buffer", (unsigned)size);
+            return NULL;
+        }
+        lvgl_raylib_draw_buf_lock();
+        if (block->huge) {
+            _stats.huge++;
+        }
+    }
+
+    _stats.live++;
+    _stats.live_size += (uint32_t)block->size;
+    lvgl_raylib_draw_buf_unlock();
+    return (uint8_t *)block + LVGL_RAYLIB_DRAW_BUF_HEADER;
+}
+
+static void lvgl_raylib_draw_buf_free_cb(void * buf)
+{
+    if (buf == NULL) {
+        return;
+    }
+    lvgl_raylib_draw_buf_block_t * block = (lvgl_raylib_draw_buf_block_t *)((uint8_t *)buf - LVGL_RAYLIB_DRAW_BUF_HEADER);
+
+    lvgl_raylib_draw_buf_lock();
+    _stats.live--;
+    _stats.live_size -= (uint32_t)block->size;
+    if (!_pooling || block->class_idx >= LVGL_RAYLIB_DRAW_BUF_CLASS_CNT || block->size > _stats.max_idle_size) {
+        if (block->huge) {
+            _stats.huge--;
+        }
+        lvgl_raylib_draw_buf_unlock();
+        lvgl_raylib_draw_buf_free_block(block);
+        return;
+    }
+
+    // Make room by dropping the buffers idle the longest, in any class
+    lvgl_raylib_draw_buf_trim(_stats.max_idle_size - (uint32_t)block->size);
+
+    uint32_t class_idx = block->class_idx;
+    block->last_used = lvgl_raylib_budget_touch();
+    block->prev = NULL;
+    block->next = _idle_head[class_idx];
+    if (_idle_head[class_idx] != NULL) {
+        _idle_head[class_idx]->prev = block;
+    } else {
+        _idle_tail[class_idx] = block;
+    }
+    _idle_head[class_idx] = block;
+    _stats.idle++;
+    _stats.idle_size += (uint32_t)block->size;
+    lvgl_raylib_draw_buf_unlock();
+}
+
+static uint32_t lvgl_raylib_draw_buf_class(size_t size, size_t * class_size)
+{
+    if (size <= ((size_t)1 << LVGL_RAYLIB_DRAW_BUF_MIN_SHIFT)) {
+        *class_size = (size_t)1 << LVGL_RAYLIB_DRAW_BUF_MIN_SHIFT;
+        return 0;
+    }
+
+    // 2^shift < size <= 2^(shift + 1), rounded up to the next quarter step
+    uint32_t shift = 0;
+    while (((size - 1) >> (shift + 1)) != 0) {
+        shift++;
+    }
+    if (shift >= LVGL_RAYLIB_DRAW_BUF_MAX_SHIFT) {
+        *class_size = size;
+        return LVGL_RAYLIB_DRAW_BUF_CLASS_CNT;
+    }
+    size_t step = (size_t)1 << (shift - 2);
+    size_t quarters = (size - ((size_t)1 << shift) + step - 1) / step;
+    *class_size = ((size_t)1 << shift) + quarters * step;
+    return (shift - LVGL_RAYLIB_DRAW_BUF_MIN_SHIFT) * 4 + (uint32_t)quarters;
+}
+
+static lvgl_raylib_draw_buf_block_t * lvgl_raylib_draw_buf_alloc_block(size_t size, uint32_t class_idx)
+{
+    bool huge = size >= LVGL_RAYLIB_DRAW_BUF_HUGE_SIZE;
+    size_t align = huge ? LVGL_RAYLIB_DRAW_BUF_HUGE_SIZE : LVGL_RAYLIB_DRAW_BUF_ALIGN;
+    // Huge buffers start on a huge page boundary so the kernel can back them with whole ones
+    size_t total = LVGL_RAYLIB_DRAW_BUF_HEADER + size;
+
+    void * mem = NULL;
+#if defined(_WIN32)
+    mem = _aligned_malloc(total, align);
+#else
+    if (posix_memalign(&mem, align, total) != 0) {
+        mem = NULL;
+    }
+#endif
+    if (mem == NULL) {
+        return NULL;
+    }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // Only a hint, the kernel may still back it with small pages
+    if (huge && madvise(mem, total, MADV_HUGEPAGE) != 0) {
+        huge = false;
+    }
+#else
+    huge = false;
+#endif
+
+    lvgl_raylib_draw_buf_block_t * block = mem;
+    memset(block, 0, sizeof(*block));
+    block->size = total - LVGL_RAYLIB_DRAW_BUF_HEADER;
+    block->class_idx = class_idx;
+    block->huge = huge;
+    return block;
+}
+
+static void lvgl_raylib_draw_buf_free_block(lvgl_raylib_draw_buf_block_t * block)
+{
+#if defined(_WIN32)
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+static void lvgl_raylib_draw_buf_unlink(lvgl_raylib_draw_buf_block_t * block)
+{
+    uint32_t class_idx = block->class_idx;
+    if (block->prev != NULL) {
+        block->prev->next = block->next;
+    } else {
+        _idle_head[class_idx] = block->next;
+    }
+    if (block->next != NULL) {
+        block->next->prev = block->prev;
+    } else {
+        _idle_tail[class_idx] = block->prev;
+    }
+    block->prev = NULL;
+    block->next = NULL;
+}
+
+static lvgl_raylib_draw_buf_block_t * lvgl_raylib_draw_buf_oldest(void)
+{
+    uint32_t now = lvgl_raylib_budget_now();
+    lvgl_raylib_draw_buf_block_t * oldest = NULL;
+    for (uint32_t i = 0; i < LVGL_RAYLIB_DRAW_BUF_CLASS_CNT; i++) {
+        lvgl_raylib_draw_buf_block_t * block = _idle_tail[i];
+        if (block != NULL && (oldest == NULL || now - block->last_used > now - oldest->last_used)) {
+            oldest = block;
+        }
+    }
+    return oldest;
+}
+
+static void lvgl_raylib_draw_buf_trim(uint32_t max_size)
+{
+    while (_stats.idle_size > max_size) {
+        lvgl_raylib_draw_buf_block_t * oldest = lvgl_raylib_draw_buf_oldest();
+        if (oldest == NULL) {
+            break;
+        }
+        lvgl_raylib_draw_buf_unlink(oldest);
+        _stats.idle--;
+        _stats.idle_size -= (uint32_t)oldest->size;
+        if (oldest->huge) {
+            _stats.huge--;
+        }
+        lvgl_raylib_draw_buf_free_block(oldest);
+    }
+}
+
+static void lvgl_raylib_draw_buf_lock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    if (_pooling) {
+        lv_mutex_lock(&_mutex);
+    }
+#endif
+}
+
+static void lvgl_raylib_draw_buf_unlock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    if (_pooling) {
+        lv_mutex_unlock(&_mutex);
+    }
+#endif
+}
+
+static uint32_t lvgl_raylib_draw_buf_budget_size_cb(void)
+{
+    lvgl_raylib_draw_buf_lock();
+    uint32_t size = _stats.idle_size;
+    lvgl_raylib_draw_buf_unlock();
+    return size;
+}
+
+static bool lvgl_raylib_draw_buf_budget_oldest_cb(uint32_t * last_used)
+{
+    lvgl_raylib_draw_buf_lock();
+    lvgl_raylib_draw_buf_block_t * oldest = lvgl_raylib_draw_buf_oldest();
+    if (oldest != NULL) {
+        *last_used = oldest->last_used;
+    }
+    lvgl_raylib_draw_buf_unlock();
+    return oldest != NULL;
+}
+
+static void lvgl_raylib_draw_buf_budget_evict_cb(void)
+{
+    lvgl_raylib_draw_buf_lock();
+    lvgl_raylib_draw_buf_block_t * oldest = lvgl_raylib_draw_buf_oldest();
+    if (oldest != NULL) {
+        lvgl_raylib_draw_buf_trim(_stats.idle_size - (uint32_t)oldest->size);
+    }
+    lvgl_raylib_draw_buf_unlock();
+}
@@ -0,0 +1,47 @@
+#ifndef LVGL_RAYLIB_DRAW_BUF_H
+#define LVGL_RAYLIB_DRAW_BUF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Start address alignment of every buffer, a cache line for vector loads */
+#define LVGL_RAYLIB_DRAW_BUF_ALIGN 64
+
+/** Buffers from this size on are aligned to and advised onto transparent huge pages */
+#define LVGL_RAYLIB_DRAW_BUF_HUGE_SIZE (2 * 1024 * 1024)
+
+/** Default limit of idle buffers kept for reuse in bytes */
+#define LVGL_RAYLIB_DRAW_BUF_POOL_SIZE (32 * 1024 * 1024)
+
+/** Size classes step a quarter of a power of two from 4 KiB up to 1 GiB */
+#define LVGL_RAYLIB_DRAW_BUF_MIN_SHIFT 12
+#define LVGL_RAYLIB_DRAW_BUF_MAX_SHIFT 30
+#define LVGL_RAYLIB_DRAW_BUF_CLASS_CNT (1 + (LVGL_RAYLIB_DRAW_BUF_MAX_SHIFT - LVGL_RAYLIB_DRAW_BUF_MIN_SHIFT) * 4)
+
+/* public types */
+
+/** Header in front of every buffer, it keeps the buffer itself aligned */
+typedef struct lvgl_raylib_draw_buf_block {
+    struct lvgl_raylib_draw_buf_block * prev;   // idle list of the class, most recent first
+    struct lvgl_raylib_draw_buf_block * next;
+    size_t size;                                // usable bytes behind the header
+    uint32_t class_idx;                         // LVGL_RAYLIB_DRAW_BUF_CLASS_CNT when not pooled
+    uint32_t last_used;
+    bool huge;
+} lvgl_raylib_draw_buf_block_t;
+
+/* public functions */
+
+/** Install the draw buffer handlers, right after lv_init() */
+void lvgl_raylib_draw_buf_init(void);
+
+/** Release the idle buffers, after lv_deinit() freed LVGL's own */
+void lvgl_raylib_draw_buf_deinit(void);
+
+#endif
@@ -0,0 +1,647 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "rlgl.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_draw_gpu.h"
+
+// rlgl has no read back of a part of a framebuffer, so glReadPixels is called directly:
+// through the loader raylib links in on desktop, from the system headers on GLES platforms
+#if defined(PLATFORM_WEB) || defined(PLATFORM_ANDROID) || defined(PLATFORM_DRM)
+    #include <GLES2/gl2.h>
+#else
+    #include "external/glad.h"
+#endif
+
+/* private defines */
+
+#if LV_VERSION_CHECK(9, 3, 0)
+    #define LVGL_RAYLIB_DRAW_GET_TASK(layer, id) lv_draw_get_available_task(layer, NULL, id)
+    #define LVGL_RAYLIB_DRAW_TASK_DONE           LV_DRAW_TASK_STATE_FINISHED
+#else
+    #define LVGL_RAYLIB_DRAW_GET_TASK(layer, id) lv_draw_get_next_available_task(layer, NULL, id)
+    #define LVGL_RAYLIB_DRAW_TASK_DONE           LV_DRAW_TASK_STATE_READY
+#endif
+
+/* private prototypes */
+
+static int32_t lvgl_raylib_draw_gpu_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * t);
+static int32_t lvgl_raylib_draw_gpu_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+static int32_t lvgl_raylib_draw_gpu_delete(lv_draw_unit_t * draw_unit);
+static void lvgl_raylib_draw_gpu_execute(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer);
+static bool lvgl_raylib_draw_gpu_mirror_upload(lvgl_raylib_draw_gpu_unit_t * unit, const lv_area_t * area);
+static void lvgl_raylib_draw_gpu_mirror_flush(lvgl_raylib_draw_gpu_unit_t * unit);
+static void lvgl_raylib_draw_gpu_premultiply(uint8_t * px, int32_t cnt);
+static void lvgl_raylib_draw_gpu_unpremultiply(uint8_t * px, int32_t cnt);
+static bool lvgl_raylib_draw_gpu_area_subtract(lv_area_t * pieces, uint32_t * cnt, const lv_area_t * cut);
+static uint32_t lvgl_raylib_draw_gpu_image_budget_size_cb(void);
+static bool lvgl_raylib_draw_gpu_image_budget_oldest_cb(uint32_t * last_used);
+static void lvgl_raylib_draw_gpu_image_budget_evict_cb(void);
+static uint32_t lvgl_raylib_draw_gpu_path_budget_size_cb(void);
+static bool lvgl_raylib_draw_gpu_path_budget_oldest_cb(uint32_t * last_used);
+static void lvgl_raylib_draw_gpu_path_budget_evict_cb(void);
+
+/* static variables */
+
+static lvgl_raylib_draw_gpu_unit_t * _unit = NULL;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_draw_gpu_init(void)
+{
+    _unit = lv_draw_create_unit(sizeof(lvgl_raylib_draw_gpu_unit_t));
+    _unit->base_unit.evaluate_cb = &lvgl_raylib_draw_gpu_evaluate;
+    _unit->base_unit.dispatch_cb = &lvgl_raylib_draw_gpu_dispatch;
+    _unit->base_unit.delete_cb = &lvgl_raylib_draw_gpu_delete;
+    _unit->enabled = true;
+
+    lvgl_raylib_draw_gpu_rect_init(_unit);
+    lvgl_raylib_draw_gpu_label_init(_unit);
+    lvgl_raylib_draw_gpu_image_init(_unit);
+    lvgl_raylib_draw_gpu_blur_init(_unit);
+    lvgl_raylib_draw_gpu_vector_init(_unit);
+
+    // Textures come back from decoded pixels, paths need tessellating again
+    _unit->image_budget.name = "GPU images";
+    _unit->image_budget.cost = LVGL_RAYLIB_BUDGET_COST_UPLOAD;
+    _unit->image_budget.get_size_cb = &lvgl_raylib_draw_gpu_image_budget_size_cb;
+    _unit->image_budget.get_oldest_cb = &lvgl_raylib_draw_gpu_image_budget_oldest_cb;
+    _unit->image_budget.evict_oldest_cb = &lvgl_raylib_draw_gpu_image_budget_evict_cb;
+    lvgl_raylib_budget_register(&_unit->image_budget);
+
+    _unit->path_budget.name = "vector paths";
+    _unit->path_budget.cost = LVGL_RAYLIB_BUDGET_COST_RASTER;
+    _unit->path_budget.get_size_cb = &lvgl_raylib_draw_gpu_path_budget_size_cb;
+    _unit->path_budget.get_oldest_cb = &lvgl_raylib_draw_gpu_path_budget_oldest_cb;
+    _unit->path_budget.evict_oldest_cb = &lvgl_raylib_draw_gpu_path_budget_evict_cb;
+    lvgl_raylib_budget_register(&_unit->path_budget);
+}
+
+void lvgl_raylib_draw_gpu_set_enabled(bool enabled)
+{
+    // Only affects tasks created from now on, handy to compare against the software output.
+    // Vector tasks are still drawn here, there is no software vector renderer to compare with.
+    if (_unit != NULL) {
+        _unit->enabled = enabled;
+    }
+}
+
+void lvgl_raylib_draw_gpu_get_stats(lvgl_raylib_draw_gpu_stats_t * stats)
+{
+    if (_unit == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = _unit->stats;
+}
+
+void lvgl_raylib_draw_gpu_get_text_stats(lvgl_raylib_draw_gpu_text_stats_t * stats)
+{
+    if (_unit == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = _unit->text_stats;
+}
+
+void lvgl_raylib_draw_gpu_set_image_cache_size(uint32_t max_size)
+{
+    if (_unit == NULL) {
+        return;
+    }
+    _unit->image_stats.max_size = max_size;
+    lvgl_raylib_draw_gpu_image_trim(_unit, max_size);
+}
+
+void lvgl_raylib_draw_gpu_get_image_stats(lvgl_raylib_draw_gpu_image_stats_t * stats)
+{
+    if (_unit == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = _unit->image_stats;
+}
+
+void lvgl_raylib_draw_gpu_set_backdrop_blur(lv_obj_t * obj, int32_t radius)
+{
+    if (_unit == NULL) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_blur_set(_unit, obj, radius);
+    lv_obj_invalidate(obj);
+}
+
+void lvgl_raylib_draw_gpu_get_path_stats(lvgl_raylib_draw_gpu_path_stats_t * stats)
+{
+    if (_unit == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = _unit->path_stats;
+}
+
+void lvgl_raylib_draw_gpu_font_drop(const lv_font_t * font)
+{
+    if (_unit == NULL) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_label_drop_font(_unit, font);
+}
+
+void lvgl_raylib_draw_gpu_image_drop(const void * src)
+{
+    if (_unit == NULL) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_image_drop_src(_unit, src);
+}
+
+bool lvgl_raylib_draw_gpu_target_begin(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, lv_layer_t * layer, const lv_area_t * area)
+{
+    lvgl_raylib_draw_gpu_mirror_t * mirror = &unit->mirror;
+    if (mirror->layer != layer || !lv_area_intersect(&target->draw_area, area, &layer->buf_area)) {
+        return false;
+    }
+
+    // Bring in the layer's current pixels, the areas drawn earlier in the batch are newer in the texture
+    if (!lvgl_raylib_draw_gpu_mirror_upload(unit, &target->draw_area)) {
+        return false;
+    }
+
+    target->layer = layer;
+    target->area = layer->buf_area;
+    target->target = mirror->target;
+    lvgl_raylib_draw_gpu_target_resume(target);
+    return true;
+}
+
+void lvgl_raylib_draw_gpu_target_pause(lvgl_raylib_draw_gpu_target_t * target)
+{
+    LV_UNUSED(target);
+    EndScissorMode();
+    EndBlendMode();
+    EndTextureMode();
+}
+
+void lvgl_raylib_draw_gpu_target_resume(lvgl_raylib_draw_gpu_target_t * target)
+{
+    BeginTextureMode(target->target->rt);
+    lvgl_raylib_draw_gpu_target_blend();
+
+    // Glyph quads and the like may overhang the task's area, which can belong to another task
+    Rectangle clip = lvgl_raylib_draw_gpu_target_rect(target, &target->draw_area);
+    BeginScissorMode((int)clip.x, (int)clip.y, (int)clip.width, (int)clip.height);
+}
+
+void lvgl_raylib_draw_gpu_target_blend(void)
+{
+    // The mirror holds premultiplied pixels and shaders output straight alpha, so this is the
+    // "over" operator: rgb = src.rgb * src.a + dst.rgb * (1 - src.a), a = src.a + dst.a * (1 - src.a).
+    // Blending straight alpha pixels with these factors would be wrong under translucent ones.
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+}
+
+bool lvgl_raylib_draw_gpu_target_sample(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * area,
+                                        lv_area_t * sample_area)
+{
+    // Brings in pixels the task reads but doesn't change, e.g. the backdrop around a blur.
+    // Called while the target is paused.
+    if (!lv_area_intersect(sample_area, area, &target->layer->buf_area)) {
+        return false;
+    }
+    return lvgl_raylib_draw_gpu_mirror_upload(unit, sample_area);
+}
+
+void lvgl_raylib_draw_gpu_target_end(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target)
+{
+    lvgl_raylib_draw_gpu_target_pause(target);
+
+    lvgl_raylib_draw_gpu_mirror_t * mirror = &unit->mirror;
+    mirror->written[mirror->written_cnt++] = target->draw_area;
+    if (mirror->written_cnt == LVGL_RAYLIB_DRAW_GPU_BATCH_CNT) {
+        lvgl_raylib_draw_gpu_mirror_flush(unit);
+    }
+    target->target->last_used = ++unit->frame;
+}
+
+Rectangle lvgl_raylib_draw_gpu_target_rect(const lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * area)
+{
+    // The target area sits at the bottom of the texture in raylib's top-down coordinates
+    float base_y = (float)(target->target->rt.texture.height - lv_area_get_height(&target->area));
+    return (Rectangle){
+        (float)(area->x1 - target->area.x1),
+        base_y + (float)(area->y1 - target->area.y1),
+        (float)lv_area_get_width(area),
+        (float)lv_area_get_height(area)
+    };
+}
+
+Vector2 lvgl_raylib_draw_gpu_target_origin(const lvgl_raylib_draw_gpu_target_t * target)
+{
+    // Shaders get LVGL coordinates of a fragment as (origin.x + gl_FragCoord.x, origin.y - gl_FragCoord.y)
+    return (Vector2){ (float)target->area.x1, (float)(target->area.y1 + lv_area_get_height(&target->area)) };
+}
+
+Color lvgl_raylib_draw_gpu_color(lv_color_t color, lv_opa_t opa)
+{
+    return (Color){ color.blue, color.green, color.red, opa };
+}
+
+Shader lvgl_raylib_draw_gpu_load_shader(const char * fs_330, const char * fs_100)
+{
+    Shader shader = LoadShaderFromMemory(NULL, rlGetVersion() == RL_OPENGL_ES_20 ? fs_100 : fs_330);
+    if (!IsShaderValid(shader)) {
+        TraceLog(LOG_ERROR, "Failed to compile GPU draw shader");
+        shader.id = 0;
+    }
+    return shader;
+}
+
+bool lvgl_raylib_draw_gpu_reserve_scratch(lvgl_raylib_draw_gpu_unit_t * unit, size_t size)
+{
+    if (unit->scratch_size >= size) {
+        return true;
+    }
+
+    uint8_t * scratch = realloc(unit->scratch, size);
+    if (scratch == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate GPU draw scratch buffer");
+        return false;
+    }
+    unit->scratch = scratch;
+    unit->scratch_size = size;
+    return true;
+}
+
+lvgl_raylib_draw_gpu_rt_t * lvgl_raylib_draw_gpu_get_rt(lvgl_raylib_draw_gpu_unit_t * unit, int32_t w, int32_t h, const lvgl_raylib_draw_gpu_rt_t * exclude)
+{
+    // Use the smallest cached target that fits, otherwise replace the least recently used one.
+    // `exclude` is a target still in use, e.g. the source of a blur pass.
+    lvgl_raylib_draw_gpu_rt_t * best = NULL;
+    lvgl_raylib_draw_gpu_rt_t * oldest = NULL;
+    for (int i = 0; i < LVGL_RAYLIB_DRAW_GPU_TARGET_CNT; i++) {
+        lvgl_raylib_draw_gpu_rt_t * target = &unit->targets[i];
+        if (target == exclude) {
+            continue;
+        }
+        if (target->rt.id != 0 && target->rt.texture.width >= w && target->rt.texture.height >= h) {
+            if (best == NULL || target->rt.texture.width * target->rt.texture.height < best->rt.texture.width * best->rt.texture.height) {
+                best = target;
+            }
+        }
+        if (oldest == NULL || target->last_used < oldest->last_used) {
+            oldest = target;
+        }
+    }
+    if (best != NULL) {
+        return best;
+    }
+
+    if (oldest->rt.id != 0) {
+        UnloadRenderTexture(oldest->rt);
+    }
+
+    int32_t step = LVGL_RAYLIB_DRAW_GPU_TARGET_STEP;
+    oldest->rt = LoadRenderTexture((w + step - 1) / step * step, (h + step - 1) / step * step);
+    if (!IsRenderTextureValid(oldest->rt)) {
+        TraceLog(LOG_ERROR, "Failed to create GPU draw target");
+        oldest->rt.id = 0;
+        return NULL;
+    }
+    oldest->last_used = unit->frame;
+    return oldest;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static int32_t lvgl_raylib_draw_gpu_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * t)
+{
+    lvgl_raylib_draw_gpu_unit_t * unit = (lvgl_raylib_draw_gpu_unit_t *)draw_unit;
+
+    // ThorVG is not built in, so the software unit can't draw vector tasks at all: they are
+    // taken whatever their size and also while the unit is disabled
+    bool vector = t->type == LV_DRAW_TASK_TYPE_VECTOR;
+    if (!vector && !unit->enabled) {
+        return 0;
+    }
+
+    // Small tasks are cheaper in software, unless they are a backdrop blur only done here
+    if (!vector && lv_area_get_size(&t->area) < LVGL_RAYLIB_DRAW_GPU_MIN_AREA
+        && (t->type != LV_DRAW_TASK_TYPE_FILL || lvgl_raylib_draw_gpu_blur_get(unit, t) == 0)) {
+        return 0;
+    }
+
+    // Render targets mirror 32 bit layers only
+    const lv_draw_dsc_base_t * base = (const lv_draw_dsc_base_t *)t->draw_dsc;
+    if (base->layer == NULL || base->layer->color_format != LV_COLOR_FORMAT_ARGB8888) {
+        return 0;
+    }
+
+    bool supported = false;
+    switch (t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+        case LV_DRAW_TASK_TYPE_BORDER:
+            supported = lvgl_raylib_draw_gpu_rect_supported(t);
+            break;
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            supported = true;
+            break;
+        case LV_DRAW_TASK_TYPE_VECTOR:
+            supported = lvgl_raylib_draw_gpu_vector_supported(t);
+            break;
+        case LV_DRAW_TASK_TYPE_LABEL:
+            supported = lvgl_raylib_draw_gpu_label_supported(t);
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            supported = lvgl_raylib_draw_gpu_image_supported(t);
+            break;
+        default:
+            break;
+    }
+
+    // Everything else stays with the software unit
+    if (supported && t->preference_score > 70) {
+        t->preference_score = 70;
+        t->preferred_draw_unit_id = unit->base_unit.idx;
+    }
+    return 0;
+}
+
+static int32_t lvgl_raylib_draw_gpu_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    lvgl_raylib_draw_gpu_unit_t * unit = (lvgl_raylib_draw_gpu_unit_t *)draw_unit;
+
+    lv_draw_task_t * t = LVGL_RAYLIB_DRAW_GET_TASK(layer, unit->base_unit.idx);
+    if (t == NULL || t->preferred_draw_unit_id != unit->base_unit.idx) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    if (lv_draw_layer_alloc_buf(layer) == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    lvgl_raylib_draw_gpu_mirror_t * mirror = &unit->mirror;
+    mirror->target = lvgl_raylib_draw_gpu_get_rt(unit, lv_area_get_width(&layer->buf_area), lv_area_get_height(&layer->buf_area), NULL);
+    mirror->layer = mirror->target != NULL ? layer : NULL;
+    mirror->written_cnt = 0;
+
+    // Dispatching happens on the thread calling lv_task_handler(), which owns the GL context, so
+    // tasks are executed right away. No other unit is dispatched meanwhile: every task that becomes
+    // available, also by finishing the previous one, is drawn into the same mirror and the layer
+    // is read back once at the end.
+    int32_t cnt = 0;
+    while (t != NULL && t->preferred_draw_unit_id == unit->base_unit.idx) {
+        t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+        lvgl_raylib_draw_gpu_execute(unit, t, layer);
+        t->state = LVGL_RAYLIB_DRAW_TASK_DONE;
+        cnt++;
+        t = LVGL_RAYLIB_DRAW_GET_TASK(layer, unit->base_unit.idx);
+    }
+
+    lvgl_raylib_draw_gpu_mirror_flush(unit);
+    mirror->layer = NULL;
+    unit->stats.batches++;
+
+    lv_draw_dispatch_request();
+    return cnt;
+}
+
+static int32_t lvgl_raylib_draw_gpu_delete(lv_draw_unit_t * draw_unit)
+{
+    lvgl_raylib_draw_gpu_unit_t * unit = (lvgl_raylib_draw_gpu_unit_t *)draw_unit;
+
+    lvgl_raylib_budget_unregister(&unit->image_budget);
+    lvgl_raylib_budget_unregister(&unit->path_budget);
+    lvgl_raylib_draw_gpu_rect_deinit(unit);
+    lvgl_raylib_draw_gpu_label_deinit(unit);
+    lvgl_raylib_draw_gpu_image_deinit(unit);
+    lvgl_raylib_draw_gpu_blur_deinit(unit);
+    lvgl_raylib_draw_gpu_vector_deinit(unit);
+    for (int i = 0; i < LVGL_RAYLIB_DRAW_GPU_TARGET_CNT; i++) {
+        if (unit->targets[i].rt.id != 0) {
+            UnloadRenderTexture(unit->targets[i].rt);
+        }
+    }
+    free(unit->scratch);
+    unit->scratch = NULL;
+
+    if (unit == _unit) {
+        _unit = NULL;
+    }
+    return 0;
+}
+
+static void lvgl_raylib_draw_gpu_execute(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    switch (t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            unit->stats.fills++;
+            lvgl_raylib_draw_gpu_rect(unit, t, layer);
+            break;
+        case LV_DRAW_TASK_TYPE_BORDER:
+            unit->stats.borders++;
+            lvgl_raylib_draw_gpu_rect(unit, t, layer);
+            break;
+        case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+            unit->stats.shadows++;
+            lvgl_raylib_draw_gpu_shadow(unit, t, layer);
+            break;
+        case LV_DRAW_TASK_TYPE_VECTOR:
+            unit->stats.vectors++;
+            lvgl_raylib_draw_gpu_vector(unit, t, layer);
+            break;
+        case LV_DRAW_TASK_TYPE_LABEL:
+            unit->stats.labels++;
+            lvgl_raylib_draw_gpu_label(unit, t, layer);
+            break;
+        case LV_DRAW_TASK_TYPE_IMAGE:
+            unit->stats.images++;
+            lvgl_raylib_draw_gpu_image(unit, t, layer);
+            break;
+        default:
+            break;
+    }
+}
+
+static bool lvgl_raylib_draw_gpu_mirror_upload(lvgl_raylib_draw_gpu_unit_t * unit, const lv_area_t * area)
+{
+    lvgl_raylib_draw_gpu_mirror_t * mirror = &unit->mirror;
+    lv_area_t pieces[LVGL_RAYLIB_DRAW_GPU_PIECE_CNT];
+    uint32_t piece_cnt = 1;
+    pieces[0] = *area;
+    for (uint32_t i = 0; i < mirror->written_cnt && piece_cnt > 0; i++) {
+        if (!lvgl_raylib_draw_gpu_area_subtract(pieces, &piece_cnt, &mirror->written[i])) {
+            // Too fragmented, hand the batch over to the layer and take the whole area from there
+            lvgl_raylib_draw_gpu_mirror_flush(unit);
+            pieces[0] = *area;
+            piece_cnt = 1;
+            break;
+        }
+    }
+
+    // The B,G,R,A bytes are uploaded as if they were R,G,B,A: blending treats channels
+    // independently, so drawing with swapped colors (lvgl_raylib_draw_gpu_color) gives LVGL's
+    // layout back. GL stores the bottom row first, so rows are flipped. LVGL's straight alpha
+    // is premultiplied on the way in and back out in lvgl_raylib_draw_gpu_mirror_flush().
+    const lv_layer_t * layer = mirror->layer;
+    const lv_draw_buf_t * buf = layer->draw_buf;
+    for (uint32_t i = 0; i < piece_cnt; i++) {
+        const lv_area_t * piece = &pieces[i];
+        int32_t w = lv_area_get_width(piece);
+        int32_t h = lv_area_get_height(piece);
+        if (!lvgl_raylib_draw_gpu_reserve_scratch(unit, (size_t)w * h * 4)) {
+            return false;
+        }
+        const uint8_t * src = buf->data + (piece->y1 - layer->buf_area.y1) * buf->header.stride
+                              + (piece->x1 - layer->buf_area.x1) * 4;
+        for (int32_t row = 0; row < h; row++) {
+            uint8_t * dst = unit->scratch + (size_t)(h - 1 - row) * w * 4;
+            memcpy(dst, src + row * buf->header.stride, (size_t)w * 4);
+            lvgl_raylib_draw_gpu_premultiply(dst, w);
+        }
+        Rectangle rect = { (float)(piece->x1 - layer->buf_area.x1), (float)(layer->buf_area.y2 - piece->y2), (float)w, (float)h };
+        UpdateTextureRec(mirror->target->rt.texture, rect, unit->scratch);
+    }
+    return true;
+}
+
+static void lvgl_raylib_draw_gpu_mirror_flush(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    lvgl_raylib_draw_gpu_mirror_t * mirror = &unit->mirror;
+    if (mirror->written_cnt == 0) {
+        return;
+    }
+
+    // Only the areas the tasks drew are read back and copied into the layer: the software unit
+    // may be drawing the rest of it right now, and reading the whole texture costs a full copy
+    // over the bus for every batch. GL stores the bottom row first, so rows come back flipped.
+    const lv_layer_t * layer = mirror->layer;
+    lv_draw_buf_t * buf = layer->draw_buf;
+    rlEnableFramebuffer(mirror->target->rt.id);
+    for (uint32_t i = 0; i < mirror->written_cnt; i++) {
+        const lv_area_t * area = &mirror->written[i];
+        int32_t w = lv_area_get_width(area);
+        int32_t h = lv_area_get_height(area);
+        if (!lvgl_raylib_draw_gpu_reserve_scratch(unit, (size_t)w * h * 4)) {
+            break;
+        }
+        glReadPixels(area->x1 - layer->buf_area.x1, layer->buf_area.y2 - area->y2, w, h, GL_RGBA, GL_UNSIGNED_BYTE, unit->scratch);
+
+        uint8_t * dst = buf->data + (area->y1 - layer->buf_area.y1) * buf->header.stride + (area->x1 - layer->buf_area.x1) * 4;
+        for (int32_t row = 0; row < h; row++) {
+            memcpy(dst, unit->scratch + (size_t)(h - 1 - row) * w * 4, (size_t)w * 4);
+            lvgl_raylib_draw_gpu_unpremultiply(dst, w);
+            dst += buf->header.stride;
+        }
+    }
+    rlDisableFramebuffer();
+    mirror->written_cnt = 0;
+}
+
+static void lvgl_raylib_draw_gpu_premultiply(uint8_t * px, int32_t cnt)
+{
+    for (int32_t i = 0; i < cnt; i++, px += 4) {
+        uint32_t a = px[3];
+        if (a != 255) {
+            px[0] = (uint8_t)((px[0] * a + 127) / 255);
+            px[1] = (uint8_t)((px[1] * a + 127) / 255);
+            px[2] = (uint8_t)((px[2] * a + 127) / 255);
+        }
+    }
+}
+
+static void lvgl_raylib_draw_gpu_unpremultiply(uint8_t * px, int32_t cnt)
+{
+    for (int32_t i = 0; i < cnt; i++, px += 4) {
+        uint32_t a = px[3];
+        if (a == 0) {
+            px[0] = px[1] = px[2] = 0;
+        } else if (a != 255) {
+            px[0] = (uint8_t)LV_MIN((px[0] * 255 + a / 2) / a, 255);
+            px[1] = (uint8_t)LV_MIN((px[1] * 255 + a / 2) / a, 255);
+            px[2] = (uint8_t)LV_MIN((px[2] * 255 + a / 2) / a, 255);
+        }
+    }
+}
+
+static bool lvgl_raylib_draw_gpu_area_subtract(lv_area_t * pieces, uint32_t * cnt, const lv_area_t * cut)
+{
+    // Every piece overlapping `cut` is replaced by up to four pieces around it
+    lv_area_t out[LVGL_RAYLIB_DRAW_GPU_PIECE_CNT];
+    uint32_t out_cnt = 0;
+    for (uint32_t i = 0; i < *cnt; i++) {
+        const lv_area_t * p = &pieces[i];
+        lv_area_t common;
+        lv_area_t around[4];
+        uint32_t around_cnt = 0;
+        if (!lv_area_intersect(&common, p, cut)) {
+            around[around_cnt++] = *p;
+        } else {
+            if (p->y1 < common.y1) around[around_cnt++] = (lv_area_t){ p->x1, p->y1, p->x2, common.y1 - 1 };
+            if (p->y2 > common.y2) around[around_cnt++] = (lv_area_t){ p->x1, common.y2 + 1, p->x2, p->y2 };
+            if (p->x1 < common.x1) around[around_cnt++] = (lv_area_t){ p->x1, common.y1, common.x1 - 1, common.y2 };
+            if (p->x2 > common.x2) around[around_cnt++] = (lv_area_t){ common.x2 + 1, common.y1, p->x2, common.y2 };
+        }
+        if (out_cnt + around_cnt > LVGL_RAYLIB_DRAW_GPU_PIECE_CNT) {
+            return false;
+        }
+        for (uint32_t k = 0; k < around_cnt; k++) {
+            out[out_cnt++] = around[k];
+        }
+    }
+    memcpy(pieces, out, out_cnt * sizeof(lv_area_t));
+    *cnt = out_cnt;
+    return true;
+}
+
+static uint32_t lvgl_raylib_draw_gpu_image_budget_size_cb(void)
+{
+    return _unit != NULL ? _unit->image_stats.size : 0;
+}
+
+static bool lvgl_raylib_draw_gpu_image_budget_oldest_cb(uint32_t * last_used)
+{
+    lvgl_raylib_draw_gpu_image_t * oldest = _unit != NULL ? lvgl_raylib_draw_gpu_image_oldest(_unit) : NULL;
+    if (oldest == NULL) {
+        return false;
+    }
+    *last_used = oldest->last_used;
+    return true;
+}
+
+static void lvgl_raylib_draw_gpu_image_budget_evict_cb(void)
+{
+    lvgl_raylib_draw_gpu_image_t * oldest = _unit != NULL ? lvgl_raylib_draw_gpu_image_oldest(_unit) : NULL;
+    if (oldest != NULL) {
+        lvgl_raylib_draw_gpu_image_evict(_unit, oldest);
+    }
+}
+
+static uint32_t lvgl_raylib_draw_gpu_path_budget_size_cb(void)
+{
+    return _unit != NULL ? _unit->path_stats.size : 0;
+}
+
+static bool lvgl_raylib_draw_gpu_path_budget_oldest_cb(uint32_t * last_used)
+{
+    lvgl_raylib_draw_gpu_path_t * oldest = _unit != NULL ? lvgl_raylib_draw_gpu_vector_oldest(_unit) : NULL;
+    if (oldest == NULL) {
+        return false;
+    }
+    *last_used = oldest->last_used;
+    return true;
+}
+
+static void lvgl_raylib_draw_gpu_path_budget_evict_cb(void)
+{
+    lvgl_raylib_draw_gpu_path_t * oldest = _unit != NULL ? lvgl_raylib_draw_gpu_vector_oldest(_unit) : NULL;
+    if (oldest != NULL) {
+        lvgl_raylib_draw_gpu_vector_evict(_unit, oldest);
+    }
+}
@@ -0,0 +1,225 @@
+#ifndef LVGL_RAYLIB_DRAW_GPU_H
+#define LVGL_RAYLIB_DRAW_GPU_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_budget.h"
+
+/* public defines */
+
+/** Tasks smaller than this many pixels are cheaper to leave to the software unit */
+#define LVGL_RAYLIB_DRAW_GPU_MIN_AREA    (48 * 48)
+
+/** Number of render targets kept around, sized in steps of LVGL_RAYLIB_DRAW_GPU_TARGET_STEP */
+#define LVGL_RAYLIB_DRAW_GPU_TARGET_CNT  8
+#define LVGL_RAYLIB_DRAW_GPU_TARGET_STEP 32
+
+/** Tasks drawn into the mirror of a layer before it is read back */
+#define LVGL_RAYLIB_DRAW_GPU_BATCH_CNT   32
+
+/** Pieces a task's area may split into around the areas drawn earlier in the batch */
+#define LVGL_RAYLIB_DRAW_GPU_PIECE_CNT   64
+
+/** Glyph atlas size, the atlas is cleared when a glyph no longer fits */
+#define LVGL_RAYLIB_DRAW_GPU_ATLAS_SIZE  1024
+#define LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS 4096
+
+/** Default budget of the image texture cache in bytes */
+#define LVGL_RAYLIB_DRAW_GPU_IMAGE_CACHE_SIZE (32 * 1024 * 1024)
+
+/** Tessellated vector paths kept for reuse */
+#define LVGL_RAYLIB_DRAW_GPU_PATH_CACHE_CNT   64
+#define LVGL_RAYLIB_DRAW_GPU_VECTOR_LOC_CNT   13
+
+/* public types */
+
+typedef struct {
+    RenderTexture2D rt;
+    uint32_t last_used;
+} lvgl_raylib_draw_gpu_rt_t;
+
+/** A glyph bitmap packed into the atlas, `font == NULL` marks a free slot */
+typedef struct {
+    const lv_font_t * font;
+    uint32_t index;
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+} lvgl_raylib_draw_gpu_glyph_t;
+
+/** An object whose background blurs what is drawn behind it */
+typedef struct {
+    lv_obj_t * obj;
+    int32_t radius;
+} lvgl_raylib_draw_gpu_blur_t;
+
+/** An image source uploaded to a texture */
+typedef struct {
+    const void * src;           // variable sources, NULL for files
+    char * path;                // file sources
+    const void * data;          // variable data at upload time, catches reused descriptors
+    Texture2D texture;
+    uint32_t size;
+    uint32_t last_used;
+} lvgl_raylib_draw_gpu_image_t;
+
+/** Triangles of a flattened path in path coordinates, positive ones first */
+typedef struct {
+    uint32_t hash;
+    uint8_t * key;              // everything the mesh was built from, stored behind the vertices
+    uint32_t key_size;
+    float * vertices;
+    uint32_t pos_cnt;
+    uint32_t neg_cnt;
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    uint8_t quality;
+    uint32_t size;              // entry and vertices in bytes
+    uint32_t last_used;
+} lvgl_raylib_draw_gpu_path_t;
+
+/** The buffer of the layer being dispatched, mirrored into a render texture. Tasks draw into it
+ *  one after another and the written areas are read back once, when the unit has no more tasks to run. */
+typedef struct {
+    lv_layer_t * layer;
+    lvgl_raylib_draw_gpu_rt_t * target;
+    lv_area_t written[LVGL_RAYLIB_DRAW_GPU_BATCH_CNT];  // newer in the texture than in the layer
+    uint32_t written_cnt;
+} lvgl_raylib_draw_gpu_mirror_t;
+
+typedef struct {
+    lv_draw_unit_t base_unit;
+    bool enabled;
+    uint32_t frame;
+    lvgl_raylib_draw_gpu_stats_t stats;
+
+    lvgl_raylib_draw_gpu_rt_t targets[LVGL_RAYLIB_DRAW_GPU_TARGET_CNT];
+    lvgl_raylib_draw_gpu_mirror_t mirror;
+    uint8_t * scratch;
+    size_t scratch_size;
+
+    Shader rect_shader;
+    int rect_loc_origin;
+    int rect_loc_rect;
+    int rect_loc_radius;
+    int rect_loc_border;
+    int rect_loc_blur;
+    int rect_loc_hole;
+    int rect_loc_hole_radius;
+
+    Texture2D atlas;
+    lvgl_raylib_draw_gpu_glyph_t * glyphs;
+    uint32_t glyph_cnt;
+    int32_t shelf_x;
+    int32_t shelf_y;
+    int32_t shelf_h;
+    lvgl_raylib_draw_gpu_text_stats_t text_stats;
+    uint32_t text_glyphs_window;
+    double text_window_start;
+
+    Shader image_shader;
+    int image_loc_origin;
+    int image_loc_area;
+    int image_loc_pivot;
+    int image_loc_transform;
+    int image_loc_recolor;
+    int image_loc_params;
+    lv_ll_t images;
+    lvgl_raylib_draw_gpu_image_stats_t image_stats;
+    lvgl_raylib_budget_cache_t image_budget;
+
+    Shader blur_shader;
+    int blur_loc_size;
+    int blur_loc_region;
+    int blur_loc_dir;
+    int blur_loc_radius;
+    int blur_loc_origin;
+    int blur_loc_rect;
+    int blur_loc_corner;
+    int blur_loc_mask;
+    int blur_loc_src;
+    int blur_loc_dst;
+    lv_ll_t blurs;
+
+    Shader vector_shader;
+    int vector_locs[LVGL_RAYLIB_DRAW_GPU_VECTOR_LOC_CNT];
+    lv_ll_t paths;
+    lvgl_raylib_draw_gpu_path_stats_t path_stats;
+    lvgl_raylib_budget_cache_t path_budget;
+} lvgl_raylib_draw_gpu_unit_t;
+
+/** A region of an LVGL layer in a render texture while a task draws into it */
+typedef struct {
+    lv_layer_t * layer;
+    lv_area_t area;             // absolute coordinates of the region at the bottom left of the texture
+    lv_area_t draw_area;        // what the task may change, inside `area`
+    lvgl_raylib_draw_gpu_rt_t * target;
+} lvgl_raylib_draw_gpu_target_t;
+
+/* public functions */
+
+void lvgl_raylib_draw_gpu_init(void);
+
+/* shared by the task renderers */
+
+bool lvgl_raylib_draw_gpu_target_begin(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, lv_layer_t * layer, const lv_area_t * area);
+void lvgl_raylib_draw_gpu_target_pause(lvgl_raylib_draw_gpu_target_t * target);
+void lvgl_raylib_draw_gpu_target_resume(lvgl_raylib_draw_gpu_target_t * target);
+void lvgl_raylib_draw_gpu_target_blend(void);
+bool lvgl_raylib_draw_gpu_target_sample(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * area,
+                                        lv_area_t * sample_area);
+void lvgl_raylib_draw_gpu_target_end(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target);
+Rectangle lvgl_raylib_draw_gpu_target_rect(const lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * area);
+Vector2 lvgl_raylib_draw_gpu_target_origin(const lvgl_raylib_draw_gpu_target_t * target);
+Color lvgl_raylib_draw_gpu_color(lv_color_t color, lv_opa_t opa);
+Shader lvgl_raylib_draw_gpu_load_shader(const char * fs_330, const char * fs_100);
+bool lvgl_raylib_draw_gpu_reserve_scratch(lvgl_raylib_draw_gpu_unit_t * unit, size_t size);
+lvgl_raylib_draw_gpu_rt_t * lvgl_raylib_draw_gpu_get_rt(lvgl_raylib_draw_gpu_unit_t * unit, int32_t w, int32_t h, const lvgl_raylib_draw_gpu_rt_t * exclude);
+
+/* task renderers */
+
+bool lvgl_raylib_draw_gpu_rect_supported(const lv_draw_task_t * t);
+void lvgl_raylib_draw_gpu_rect_init(lvgl_raylib_draw_gpu_unit_t * unit);
+void lvgl_raylib_draw_gpu_rect(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer);
+void lvgl_raylib_draw_gpu_shadow(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer);
+void lvgl_raylib_draw_gpu_rect_draw(lvgl_raylib_draw_gpu_unit_t * unit, const lvgl_raylib_draw_gpu_target_t * target,
+                                    const lv_area_t * coords, const lv_area_t * draw_area, int32_t radius, float border, float blur,
+                                    const lv_area_t * hole, int32_t hole_radius, Color color);
+void lvgl_raylib_draw_gpu_rect_deinit(lvgl_raylib_draw_gpu_unit_t * unit);
+
+bool lvgl_raylib_draw_gpu_label_supported(const lv_draw_task_t * t);
+void lvgl_raylib_draw_gpu_label_init(lvgl_raylib_draw_gpu_unit_t * unit);
+void lvgl_raylib_draw_gpu_label(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer);
+void lvgl_raylib_draw_gpu_label_drop_font(lvgl_raylib_draw_gpu_unit_t * unit, const lv_font_t * font);
+void lvgl_raylib_draw_gpu_label_deinit(lvgl_raylib_draw_gpu_unit_t * unit);
+
+bool lvgl_raylib_draw_gpu_image_supported(const lv_draw_task_t * t);
+void lvgl_raylib_draw_gpu_image_init(lvgl_raylib_draw_gpu_unit_t * unit);
+void lvgl_raylib_draw_gpu_image(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer);
+void lvgl_raylib_draw_gpu_image_trim(lvgl_raylib_draw_gpu_unit_t * unit, uint32_t max_size);
+lvgl_raylib_draw_gpu_image_t * lvgl_raylib_draw_gpu_image_oldest(lvgl_raylib_draw_gpu_unit_t * unit);
+void lvgl_raylib_draw_gpu_image_evict(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_image_t * image);
+void lvgl_raylib_draw_gpu_image_drop_src(lvgl_raylib_draw_gpu_unit_t * unit, const void * src);
+void lvgl_raylib_draw_gpu_image_deinit(lvgl_raylib_draw_gpu_unit_t * unit);
+
+void lvgl_raylib_draw_gpu_blur_init(lvgl_raylib_draw_gpu_unit_t * unit);
+void lvgl_raylib_draw_gpu_blur_set(lvgl_raylib_draw_gpu_unit_t * unit, lv_obj_t * obj, int32_t radius);
+int32_t lvgl_raylib_draw_gpu_blur_get(lvgl_raylib_draw_gpu_unit_t * unit, const lv_draw_task_t * t);
+void lvgl_raylib_draw_gpu_blur(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * sample_area,
+                               const lv_area_t * coords, int32_t corner_radius, int32_t blur_radius);
+void lvgl_raylib_draw_gpu_blur_deinit(lvgl_raylib_draw_gpu_unit_t * unit);
+
+bool lvgl_raylib_draw_gpu_vector_supported(const lv_draw_task_t * t);
+void lvgl_raylib_draw_gpu_vector_init(lvgl_raylib_draw_gpu_unit_t * unit);
+void lvgl_raylib_draw_gpu_vector(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer);
+lvgl_raylib_draw_gpu_path_t * lvgl_raylib_draw_gpu_vector_oldest(lvgl_raylib_draw_gpu_unit_t * unit);
+void lvgl_raylib_draw_gpu_vector_evict(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_path_t * mesh);
+void lvgl_raylib_draw_gpu_vector_deinit(lvgl_raylib_draw_gpu_unit_t * unit);
+
+#endif
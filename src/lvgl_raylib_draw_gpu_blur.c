@@ -0,0 +1,266 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl_private.h"
+#include "rlgl.h"
+#include "lvgl_raylib_draw_gpu.h"
+
+/* private prototypes */
+
+static lvgl_raylib_draw_gpu_blur_t * lvgl_raylib_draw_gpu_blur_find(lvgl_raylib_draw_gpu_unit_t * unit, const lv_obj_t * obj);
+static void lvgl_raylib_draw_gpu_blur_pass(lvgl_raylib_draw_gpu_unit_t * unit, const Texture2D * src, Vector2 src_offset, Vector2 dir, int32_t blur_radius,
+                                           const lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * region, const lv_area_t * draw_area, bool mask);
+static Vector2 lvgl_raylib_draw_gpu_blur_offset(const lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * region);
+static void lvgl_raylib_draw_gpu_blur_delete_cb(lv_event_t * e);
+
+/* static variables */
+
+// One direction of a separable Gaussian over a region, which starts at `src` texels in the
+// source and at `dst` pixels in the destination. Samples are clamped to the region. The second pass discards fragments outside
+// the object's rounded box.
+static const char * _blur_fs_330 =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 size;\n"
+    "uniform vec2 region;\n"
+    "uniform vec2 dir;\n"
+    "uniform float radius;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec4 rect;\n"
+    "uniform float corner;\n"
+    "uniform float mask;\n"
+    "uniform vec2 src;\n"
+    "uniform vec2 dst;\n"
+    "out vec4 finalColor;\n"
+    "float box(vec2 p, vec4 r, float rad) {\n"
+    "    vec2 q = abs(p - (r.xy + r.zw) * 0.5) - (r.zw - r.xy) * 0.5 + rad;\n"
+    "    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - rad;\n"
+    "}\n"
+    "void main() {\n"
+    "    if (mask > 0.0 && box(vec2(origin.x + gl_FragCoord.x, origin.y - gl_FragCoord.y), rect, corner) > 0.0) discard;\n"
+    "    float sigma = max(radius * 0.5, 0.5);\n"
+    "    vec4 sum = vec4(0.0);\n"
+    "    float total = 0.0;\n"
+    "    for (int i = -16; i <= 16; i++) {\n"
+    "        float o = float(i) * radius / 16.0;\n"
+    "        float w = exp(-0.5 * o * o / (sigma * sigma));\n"
+    "        vec2 p = clamp(gl_FragCoord.xy - dst + dir * o, vec2(0.5), region - 0.5) + src;\n"
+    "        sum += texture(texture0, p / size) * w;\n"
+    "        total += w;\n"
+    "    }\n"
+    "    finalColor = sum / total;\n"
+    "}\n";
+
+static const char * _blur_fs_100 =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 size;\n"
+    "uniform vec2 region;\n"
+    "uniform vec2 dir;\n"
+    "uniform float radius;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec4 rect;\n"
+    "uniform float corner;\n"
+    "uniform float mask;\n"
+    "uniform vec2 src;\n"
+    "uniform vec2 dst;\n"
+    "float box(vec2 p, vec4 r, float rad) {\n"
+    "    vec2 q = abs(p - (r.xy + r.zw) * 0.5) - (r.zw - r.xy) * 0.5 + rad;\n"
+    "    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - rad;\n"
+    "}\n"
+    "void main() {\n"
+    "    if (mask > 0.0 && box(vec2(origin.x + gl_FragCoord.x, origin.y - gl_FragCoord.y), rect, corner) > 0.0) discard;\n"
+    "    float sigma = max(radius * 0.5, 0.5);\n"
+    "    vec4 sum = vec4(0.0);\n"
+    "    float total = 0.0;\n"
+    "    for (int i = -16; i <= 16; i++) {\n"
+    "        float o = float(i) * radius / 16.0;\n"
+    "        float w = exp(-0.5 * o * o / (sigma * sigma));\n"
+    "        vec2 p = clamp(gl_FragCoord.xy - dst + dir * o, vec2(0.5), region - 0.5) + src;\n"
+    "        sum += texture2D(texture0, p / size) * w;\n"
+    "        total += w;\n"
+    "    }\n"
+    "    gl_FragColor = sum / total;\n"
+    "}\n";
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_draw_gpu_blur_init(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    lv_ll_init(&unit->blurs, sizeof(lvgl_raylib_draw_gpu_blur_t));
+
+    unit->blur_shader = lvgl_raylib_draw_gpu_load_shader(_blur_fs_330, _blur_fs_100);
+    unit->blur_loc_size = GetShaderLocation(unit->blur_shader, "size");
+    unit->blur_loc_region = GetShaderLocation(unit->blur_shader, "region");
+    unit->blur_loc_dir = GetShaderLocation(unit->blur_shader, "dir");
+    unit->blur_loc_radius = GetShaderLocation(unit->blur_shader, "radius");
+    unit->blur_loc_origin = GetShaderLocation(unit->blur_shader, "origin");
+    unit->blur_loc_rect = GetShaderLocation(unit->blur_shader, "rect");
+    unit->blur_loc_corner = GetShaderLocation(unit->blur_shader, "corner");
+    unit->blur_loc_mask = GetShaderLocation(unit->blur_shader, "mask");
+    unit->blur_loc_src = GetShaderLocation(unit->blur_shader, "src");
+    unit->blur_loc_dst = GetShaderLocation(unit->blur_shader, "dst");
+}
+
+void lvgl_raylib_draw_gpu_blur_set(lvgl_raylib_draw_gpu_unit_t * unit, lv_obj_t * obj, int32_t radius)
+{
+    lvgl_raylib_draw_gpu_blur_t * blur = lvgl_raylib_draw_gpu_blur_find(unit, obj);
+    if (radius <= 0) {
+        if (blur != NULL) {
+            lv_obj_remove_event_cb_with_user_data(obj, lvgl_raylib_draw_gpu_blur_delete_cb, unit);
+            lv_ll_remove(&unit->blurs, blur);
+            lv_free(blur);
+        }
+        return;
+    }
+
+    if (blur == NULL) {
+        blur = lv_ll_ins_tail(&unit->blurs);
+        if (blur == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate backdrop blur");
+            return;
+        }
+        blur->obj = obj;
+        lv_obj_add_event_cb(obj, lvgl_raylib_draw_gpu_blur_delete_cb, LV_EVENT_DELETE, unit);
+    }
+    blur->radius = radius;
+}
+
+int32_t lvgl_raylib_draw_gpu_blur_get(lvgl_raylib_draw_gpu_unit_t * unit, const lv_draw_task_t * t)
+{
+    // Only the background fill of a registered object, not its other parts
+    const lv_draw_dsc_base_t * base = (const lv_draw_dsc_base_t *)t->draw_dsc;
+    if (unit->blur_shader.id == 0 || base->obj == NULL || base->part != LV_PART_MAIN) {
+        return 0;
+    }
+
+    lvgl_raylib_draw_gpu_blur_t * blur = lvgl_raylib_draw_gpu_blur_find(unit, base->obj);
+    if (blur == NULL || !lv_area_is_equal(&t->area, &base->obj->coords)) {
+        return 0;
+    }
+    return blur->radius;
+}
+
+void lvgl_raylib_draw_gpu_blur(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * sample_area,
+                               const lv_area_t * coords, int32_t corner_radius, int32_t blur_radius)
+{
+    lvgl_raylib_draw_gpu_target_pause(target);
+
+    // The region is read from the layer, only the object's part of it is written
+    lv_area_t region;
+    if (!lvgl_raylib_draw_gpu_target_sample(unit, target, sample_area, &region)) {
+        lvgl_raylib_draw_gpu_target_resume(target);
+        return;
+    }
+    lvgl_raylib_draw_gpu_rt_t * tmp = lvgl_raylib_draw_gpu_get_rt(unit, lv_area_get_width(&region), lv_area_get_height(&region), target->target);
+    if (tmp == NULL) {
+        lvgl_raylib_draw_gpu_target_resume(target);
+        return;
+    }
+    tmp->last_used = ++unit->frame;
+
+    // Horizontal pass into the bottom left of the spare target, over the whole region
+    BeginTextureMode(tmp->rt);
+    lvgl_raylib_draw_gpu_target_t tmp_target = { target->layer, region, region, tmp };
+    lvgl_raylib_draw_gpu_blur_pass(unit, &target->target->rt.texture, lvgl_raylib_draw_gpu_blur_offset(target, &region),
+                                   (Vector2){ 1.0f, 0.0f }, blur_radius, &tmp_target, &region, &region, false);
+    EndTextureMode();
+
+    // Vertical pass back into the mirror, only inside the object
+    BeginTextureMode(target->target->rt);
+    lv_area_t blur_area;
+    if (lv_area_intersect(&blur_area, coords, &target->draw_area)) {
+        int32_t short_side = LV_MIN(lv_area_get_width(coords), lv_area_get_height(coords));
+        float rect[4] = { (float)coords->x1, (float)coords->y1, (float)coords->x2 + 1.0f, (float)coords->y2 + 1.0f };
+        float corner = (float)LV_MIN(corner_radius, short_side / 2);
+        SetShaderValue(unit->blur_shader, unit->blur_loc_rect, rect, SHADER_UNIFORM_VEC4);
+        SetShaderValue(unit->blur_shader, unit->blur_loc_corner, &corner, SHADER_UNIFORM_FLOAT);
+        lvgl_raylib_draw_gpu_blur_pass(unit, &tmp->rt.texture, (Vector2){ 0.0f, 0.0f }, (Vector2){ 0.0f, 1.0f }, blur_radius,
+                                       target, &region, &blur_area, true);
+    }
+    EndTextureMode();
+
+    lvgl_raylib_draw_gpu_target_resume(target);
+}
+
+void lvgl_raylib_draw_gpu_blur_deinit(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    lvgl_raylib_draw_gpu_blur_t * blur;
+    LV_LL_READ(&unit->blurs, blur) {
+        lv_obj_remove_event_cb_with_user_data(blur->obj, lvgl_raylib_draw_gpu_blur_delete_cb, unit);
+    }
+    lv_ll_clear(&unit->blurs);
+
+    if (unit->blur_shader.id != 0) {
+        UnloadShader(unit->blur_shader);
+        unit->blur_shader.id = 0;
+    }
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_draw_gpu_blur_t * lvgl_raylib_draw_gpu_blur_find(lvgl_raylib_draw_gpu_unit_t * unit, const lv_obj_t * obj)
+{
+    lvgl_raylib_draw_gpu_blur_t * blur;
+    LV_LL_READ(&unit->blurs, blur) {
+        if (blur->obj == obj) {
+            return blur;
+        }
+    }
+    return NULL;
+}
+
+static void lvgl_raylib_draw_gpu_blur_pass(lvgl_raylib_draw_gpu_unit_t * unit, const Texture2D * src, Vector2 src_offset, Vector2 dir, int32_t blur_radius,
+                                           const lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * region, const lv_area_t * draw_area, bool mask)
+{
+    Vector2 size = { (float)src->width, (float)src->height };
+    Vector2 region_size = { (float)lv_area_get_width(region), (float)lv_area_get_height(region) };
+    Vector2 dst_offset = lvgl_raylib_draw_gpu_blur_offset(target, region);
+    Vector2 origin = lvgl_raylib_draw_gpu_target_origin(target);
+    float radius = (float)blur_radius;
+    float mask_on = mask ? 1.0f : 0.0f;
+
+    // The blurred pixels replace what is there. The mirror is premultiplied, so transparent
+    // pixels around the backdrop do not darken it.
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    SetTextureFilter(*src, TEXTURE_FILTER_BILINEAR);
+
+    BeginShaderMode(unit->blur_shader);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_size, &size, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_region, &region_size, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_dir, &dir, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_radius, &radius, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_origin, &origin, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_mask, &mask_on, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_src, &src_offset, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->blur_shader, unit->blur_loc_dst, &dst_offset, SHADER_UNIFORM_VEC2);
+    // Samples are taken from the region, fragments only cover the part drawn
+    Rectangle dst_rect = lvgl_raylib_draw_gpu_target_rect(target, draw_area);
+    Rectangle src_rect = { 0, 0, dst_rect.width, dst_rect.height };
+    DrawTexturePro(*src, src_rect, dst_rect, (Vector2){ 0, 0 }, 0.0f, WHITE);
+    EndShaderMode();
+
+    EndBlendMode();
+    SetTextureFilter(*src, TEXTURE_FILTER_POINT);
+}
+
+static Vector2 lvgl_raylib_draw_gpu_blur_offset(const lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * region)
+{
+    // Where the region's bottom left pixel is in GL's bottom up coordinates of the texture
+    return (Vector2){ (float)(region->x1 - target->area.x1), (float)(target->area.y2 - region->y2) };
+}
+
+static void lvgl_raylib_draw_gpu_blur_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_draw_gpu_unit_t * unit = lv_event_get_user_data(e);
+    lvgl_raylib_draw_gpu_blur_t * blur = lvgl_raylib_draw_gpu_blur_find(unit, lv_event_get_target(e));
+    if (blur != NULL) {
+        lv_ll_remove(&unit->blurs, blur);
+        lv_free(blur);
+    }
+}
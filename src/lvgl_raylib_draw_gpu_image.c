@@ -0,0 +1,316 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "lvgl_private.h"
+#include "rlgl.h"
+#include "lvgl_raylib_draw_gpu.h"
+
+/* private prototypes */
+
+static lvgl_raylib_draw_gpu_image_t * lvgl_raylib_draw_gpu_image_get(lvgl_raylib_draw_gpu_unit_t * unit, const void * src);
+static lvgl_raylib_draw_gpu_image_t * lvgl_raylib_draw_gpu_image_upload(lvgl_raylib_draw_gpu_unit_t * unit, const void * src);
+static void lvgl_raylib_draw_gpu_image_remove(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_image_t * image);
+
+/* static variables */
+
+// Each fragment is mapped back into the image through the inverse of LVGL's transform
+// (rotate and scale around the pivot). Texels hold LVGL's B,G,R,A bytes, which is also
+// what the target expects, so the recolor is passed in the same order.
+static const char * _image_fs_330 =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec4 area;\n"
+    "uniform vec2 pivot;\n"
+    "uniform vec3 transform;\n"
+    "uniform vec4 recolor;\n"
+    "uniform vec3 params;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec2 p = vec2(origin.x + gl_FragCoord.x, origin.y - gl_FragCoord.y) - area.xy - pivot;\n"
+    "    float c = cos(transform.x);\n"
+    "    float s = sin(transform.x);\n"
+    "    vec2 q = vec2(c * p.x + s * p.y, c * p.y - s * p.x) / transform.yz + pivot;\n"
+    "    if (q.x < 0.0 || q.y < 0.0 || q.x >= area.z || q.y >= area.w) discard;\n"
+    "    vec4 texel = texture(texture0, q / area.zw);\n"
+    "    if (params.z > 0.5 && texel.a > 0.0) texel.rgb /= texel.a;\n"
+    "    vec3 rgb = mix(texel.rgb, recolor.rgb, recolor.a);\n"
+    "    finalColor = vec4(rgb, mix(texel.a, 1.0, params.y) * params.x);\n"
+    "}\n";
+
+static const char * _image_fs_100 =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec4 area;\n"
+    "uniform vec2 pivot;\n"
+    "uniform vec3 transform;\n"
+    "uniform vec4 recolor;\n"
+    "uniform vec3 params;\n"
+    "void main() {\n"
+    "    vec2 p = vec2(origin.x + gl_FragCoord.x, origin.y - gl_FragCoord.y) - area.xy - pivot;\n"
+    "    float c = cos(transform.x);\n"
+    "    float s = sin(transform.x);\n"
+    "    vec2 q = vec2(c * p.x + s * p.y, c * p.y - s * p.x) / transform.yz + pivot;\n"
+    "    if (q.x < 0.0 || q.y < 0.0 || q.x >= area.z || q.y >= area.w) discard;\n"
+    "    vec4 texel = texture2D(texture0, q / area.zw);\n"
+    "    if (params.z > 0.5 && texel.a > 0.0) texel.rgb /= texel.a;\n"
+    "    vec3 rgb = mix(texel.rgb, recolor.rgb, recolor.a);\n"
+    "    gl_FragColor = vec4(rgb, mix(texel.a, 1.0, params.y) * params.x);\n"
+    "}\n";
+
+/* PUBLIC IMPLEMENTATION */
+
+bool lvgl_raylib_draw_gpu_image_supported(const lv_draw_task_t * t)
+{
+    const lv_draw_image_dsc_t * dsc = (const lv_draw_image_dsc_t *)t->draw_dsc;
+    if (dsc->src == NULL || dsc->tile || dsc->clip_radius != 0 || dsc->bitmap_mask_src != NULL
+        || dsc->blend_mode != LV_BLEND_MODE_NORMAL || dsc->skew_x != 0 || dsc->skew_y != 0
+        || dsc->scale_x <= 0 || dsc->scale_y <= 0) {
+        return false;
+    }
+
+    if (dsc->header.cf != LV_COLOR_FORMAT_ARGB8888 && dsc->header.cf != LV_COLOR_FORMAT_XRGB8888) {
+        return false;
+    }
+    lv_image_src_t src_type = lv_image_src_get_type(dsc->src);
+    if (src_type == LV_IMAGE_SRC_FILE) {
+        return true;
+    }
+
+    // Canvases and other draw buffers are written in place, a cached texture would go stale
+    return src_type == LV_IMAGE_SRC_VARIABLE && !(dsc->header.flags & LV_IMAGE_FLAGS_MODIFIABLE);
+}
+
+void lvgl_raylib_draw_gpu_image_init(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    lv_ll_init(&unit->images, sizeof(lvgl_raylib_draw_gpu_image_t));
+    unit->image_stats.max_size = LVGL_RAYLIB_DRAW_GPU_IMAGE_CACHE_SIZE;
+
+    unit->image_shader = lvgl_raylib_draw_gpu_load_shader(_image_fs_330, _image_fs_100);
+    unit->image_loc_origin = GetShaderLocation(unit->image_shader, "origin");
+    unit->image_loc_area = GetShaderLocation(unit->image_shader, "area");
+    unit->image_loc_pivot = GetShaderLocation(unit->image_shader, "pivot");
+    unit->image_loc_transform = GetShaderLocation(unit->image_shader, "transform");
+    unit->image_loc_recolor = GetShaderLocation(unit->image_shader, "recolor");
+    unit->image_loc_params = GetShaderLocation(unit->image_shader, "params");
+}
+
+void lvgl_raylib_draw_gpu_image(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    const lv_draw_image_dsc_t * dsc = (const lv_draw_image_dsc_t *)t->draw_dsc;
+    if (unit->image_shader.id == 0 || dsc->opa <= LV_OPA_MIN) {
+        return;
+    }
+
+    // Rotated and scaled images cover their transformed bounding box, not the task's area
+    lv_area_t draw_area;
+    if (!lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_image_t * image = lvgl_raylib_draw_gpu_image_get(unit, dsc->src);
+    if (image == NULL) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_target_t target;
+    if (!lvgl_raylib_draw_gpu_target_begin(unit, &target, layer, &draw_area)) {
+        return;
+    }
+
+    // Untransformed images map texel centers onto pixel centers, nearest keeps them exact
+    bool transformed = dsc->rotation != 0 || dsc->scale_x != LV_SCALE_NONE || dsc->scale_y != LV_SCALE_NONE;
+    SetTextureFilter(image->texture, transformed && dsc->antialias ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+
+    Vector2 origin = lvgl_raylib_draw_gpu_target_origin(&target);
+    float area[4] = { (float)dsc->image_area.x1, (float)dsc->image_area.y1, (float)image->texture.width, (float)image->texture.height };
+    float pivot[2] = { (float)dsc->pivot.x, (float)dsc->pivot.y };
+    float transform[3] = { (float)dsc->rotation * DEG2RAD / 10.0f, (float)dsc->scale_x / LV_SCALE_NONE, (float)dsc->scale_y / LV_SCALE_NONE };
+    float recolor[4] = { dsc->recolor.blue / 255.0f, dsc->recolor.green / 255.0f, dsc->recolor.red / 255.0f, dsc->recolor_opa / 255.0f };
+    // Premultiplied images, e.g. from the raylib decoder, are turned back into straight alpha
+    float params[3] = {
+        dsc->opa / 255.0f,
+        dsc->header.cf == LV_COLOR_FORMAT_XRGB8888 ? 1.0f : 0.0f,
+        (dsc->header.flags & LV_IMAGE_FLAGS_PREMULTIPLIED) ? 1.0f : 0.0f
+    };
+
+    BeginShaderMode(unit->image_shader);
+    SetShaderValue(unit->image_shader, unit->image_loc_origin, &origin, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->image_shader, unit->image_loc_area, area, SHADER_UNIFORM_VEC4);
+    SetShaderValue(unit->image_shader, unit->image_loc_pivot, pivot, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->image_shader, unit->image_loc_transform, transform, SHADER_UNIFORM_VEC3);
+    SetShaderValue(unit->image_shader, unit->image_loc_recolor, recolor, SHADER_UNIFORM_VEC4);
+    SetShaderValue(unit->image_shader, unit->image_loc_params, params, SHADER_UNIFORM_VEC3);
+    Rectangle src = { 0, 0, (float)image->texture.width, (float)image->texture.height };
+    DrawTexturePro(image->texture, src, lvgl_raylib_draw_gpu_target_rect(&target, &draw_area), (Vector2){ 0, 0 }, 0.0f, WHITE);
+    EndShaderMode();
+
+    lvgl_raylib_draw_gpu_target_end(unit, &target);
+}
+
+void lvgl_raylib_draw_gpu_image_trim(lvgl_raylib_draw_gpu_unit_t * unit, uint32_t max_size)
+{
+    while (unit->image_stats.size > max_size) {
+        lvgl_raylib_draw_gpu_image_t * oldest = lvgl_raylib_draw_gpu_image_oldest(unit);
+        if (oldest == NULL) {
+            break;
+        }
+        lvgl_raylib_draw_gpu_image_evict(unit, oldest);
+    }
+}
+
+lvgl_raylib_draw_gpu_image_t * lvgl_raylib_draw_gpu_image_oldest(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    uint32_t now = lvgl_raylib_budget_now();
+    lvgl_raylib_draw_gpu_image_t * oldest = NULL;
+    lvgl_raylib_draw_gpu_image_t * image;
+    LV_LL_READ(&unit->images, image) {
+        if (oldest == NULL || now - image->last_used > now - oldest->last_used) {
+            oldest = image;
+        }
+    }
+    return oldest;
+}
+
+void lvgl_raylib_draw_gpu_image_evict(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_image_t * image)
+{
+    lvgl_raylib_draw_gpu_image_remove(unit, image);
+    unit->image_stats.evictions++;
+}
+
+void lvgl_raylib_draw_gpu_image_drop_src(lvgl_raylib_draw_gpu_unit_t * unit, const void * src)
+{
+    bool is_file = src != NULL && lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE;
+    lvgl_raylib_draw_gpu_image_t * image = lv_ll_get_head(&unit->images);
+    while (image != NULL) {
+        lvgl_raylib_draw_gpu_image_t * next = lv_ll_get_next(&unit->images, image);
+        if (src == NULL || image->src == src || (is_file && image->path != NULL && strcmp(image->path, src) == 0)) {
+            lvgl_raylib_draw_gpu_image_remove(unit, image);
+        }
+        image = next;
+    }
+}
+
+void lvgl_raylib_draw_gpu_image_deinit(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    lvgl_raylib_draw_gpu_image_trim(unit, 0);
+    if (unit->image_shader.id != 0) {
+        UnloadShader(unit->image_shader);
+        unit->image_shader.id = 0;
+    }
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_draw_gpu_image_t * lvgl_raylib_draw_gpu_image_get(lvgl_raylib_draw_gpu_unit_t * unit, const void * src)
+{
+    bool is_file = lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE;
+    const void * data = is_file ? NULL : ((const lv_image_dsc_t *)src)->data;
+
+    lvgl_raylib_draw_gpu_image_t * image;
+    LV_LL_READ(&unit->images, image) {
+        bool match = is_file ? (image->path != NULL && strcmp(image->path, src) == 0) : image->src == src;
+        if (!match) {
+            continue;
+        }
+        if (image->data != data) {
+            // The descriptor now points at other pixels
+            lvgl_raylib_draw_gpu_image_remove(unit, image);
+            break;
+        }
+        image->last_used = lvgl_raylib_budget_touch();
+        unit->image_stats.hits++;
+        return image;
+    }
+
+    unit->image_stats.misses++;
+    return lvgl_raylib_draw_gpu_image_upload(unit, src);
+}
+
+static lvgl_raylib_draw_gpu_image_t * lvgl_raylib_draw_gpu_image_upload(lvgl_raylib_draw_gpu_unit_t * unit, const void * src)
+{
+    lv_image_decoder_dsc_t decoder_dsc;
+    if (lv_image_decoder_open(&decoder_dsc, src, NULL) != LV_RESULT_OK) {
+        TraceLog(LOG_ERROR, "Failed to decode image for the GPU draw unit");
+        return NULL;
+    }
+
+    const lv_draw_buf_t * decoded = decoder_dsc.decoded;
+    lvgl_raylib_draw_gpu_image_t * image = NULL;
+    if (decoded == NULL || (decoded->header.cf != LV_COLOR_FORMAT_ARGB8888 && decoded->header.cf != LV_COLOR_FORMAT_XRGB8888)) {
+        TraceLog(LOG_ERROR, "GPU draw unit can't upload decoded image format %d", decoded != NULL ? decoded->header.cf : 0);
+        lv_image_decoder_close(&decoder_dsc);
+        return NULL;
+    }
+
+    int32_t w = decoded->header.w;
+    int32_t h = decoded->header.h;
+    uint32_t size = (uint32_t)w * h * 4;
+    if (size > unit->image_stats.max_size) {
+        lv_image_decoder_close(&decoder_dsc);
+        return NULL;
+    }
+    lvgl_raylib_draw_gpu_image_trim(unit, unit->image_stats.max_size - size);
+
+    // Tightly packed rows for the upload, the B,G,R,A bytes go up as they are
+    const uint8_t * pixels = decoded->data;
+    if (decoded->header.stride != (uint32_t)w * 4) {
+        if (!lvgl_raylib_draw_gpu_reserve_scratch(unit, size)) {
+            lv_image_decoder_close(&decoder_dsc);
+            return NULL;
+        }
+        for (int32_t row = 0; row < h; row++) {
+            memcpy(unit->scratch + (size_t)row * w * 4, decoded->data + row * decoded->header.stride, (size_t)w * 4);
+        }
+        pixels = unit->scratch;
+    }
+
+    Texture2D texture = { 0 };
+    texture.id = rlLoadTexture(pixels, w, h, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+    texture.width = w;
+    texture.height = h;
+    texture.mipmaps = 1;
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    lv_image_decoder_close(&decoder_dsc);
+    if (texture.id == 0) {
+        TraceLog(LOG_ERROR, "Failed to upload %dx%d image texture", w, h);
+        return NULL;
+    }
+    SetTextureWrap(texture, TEXTURE_WRAP_CLAMP);
+
+    image = lv_ll_ins_head(&unit->images);
+    if (image == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate GPU image cache entry");
+        UnloadTexture(texture);
+        return NULL;
+    }
+
+    bool is_file = lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE;
+    image->src = is_file ? NULL : src;
+    image->path = is_file ? lv_strdup(src) : NULL;
+    image->data = is_file ? NULL : ((const lv_image_dsc_t *)src)->data;
+    image->texture = texture;
+    image->size = size;
+    image->last_used = lvgl_raylib_budget_touch();
+
+    unit->image_stats.entries++;
+    unit->image_stats.size += size;
+    return image;
+}
+
+static void lvgl_raylib_draw_gpu_image_remove(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_image_t * image)
+{
+    UnloadTexture(image->texture);
+    lv_free(image->path);
+    unit->image_stats.size -= image->size;
+    unit->image_stats.entries--;
+    lv_ll_remove(&unit->images, image);
+    lv_free(image);
+}
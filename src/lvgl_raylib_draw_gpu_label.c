@@ -0,0 +1,319 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "rlgl.h"
+#include "lvgl_raylib_draw_gpu.h"
+
+/* private defines */
+
+// LVGL 9.3 passes the draw task to the glyph callback, older versions the draw unit
+#if LV_VERSION_CHECK(9, 3, 0)
+    #define LVGL_RAYLIB_GLYPH_CB_CTX lv_draw_task_t
+#else
+    #define LVGL_RAYLIB_GLYPH_CB_CTX lv_draw_unit_t
+#endif
+
+/* private prototypes */
+
+static void lvgl_raylib_draw_gpu_label_glyph_cb(LVGL_RAYLIB_GLYPH_CB_CTX * ctx, lv_draw_glyph_dsc_t * glyph_dsc, lv_draw_fill_dsc_t * fill_dsc, const lv_area_t * fill_area);
+static const lvgl_raylib_draw_gpu_glyph_t * lvgl_raylib_draw_gpu_label_get_glyph(lvgl_raylib_draw_gpu_unit_t * unit, const lv_draw_glyph_dsc_t * glyph_dsc);
+static bool lvgl_raylib_draw_gpu_label_pack(lvgl_raylib_draw_gpu_unit_t * unit, int32_t w, int32_t h, int32_t * x, int32_t * y);
+static void lvgl_raylib_draw_gpu_label_evict(lvgl_raylib_draw_gpu_unit_t * unit);
+static void lvgl_raylib_draw_gpu_label_count(lvgl_raylib_draw_gpu_unit_t * unit, uint32_t glyphs);
+static uint32_t lvgl_raylib_draw_gpu_label_hash(const lv_font_t * font, uint32_t index);
+
+/* static variables */
+
+// The glyph callback has no user data, the label being drawn is kept here
+static lvgl_raylib_draw_gpu_unit_t * _label_unit = NULL;
+static lvgl_raylib_draw_gpu_target_t * _label_target = NULL;
+static uint32_t _label_glyphs = 0;
+
+/* PUBLIC IMPLEMENTATION */
+
+bool lvgl_raylib_draw_gpu_label_supported(const lv_draw_task_t * t)
+{
+    const lv_draw_label_dsc_t * dsc = (const lv_draw_label_dsc_t *)t->draw_dsc;
+    if (dsc->text == NULL || dsc->font == NULL) {
+        return false;
+    }
+
+    // Only fonts in LVGL's built-in bitmap format are known to give A1..A8 glyphs,
+    // image and vector glyphs are left to the software unit
+    for (const lv_font_t * font = dsc->font; font != NULL; font = font->fallback) {
+        if (font->get_glyph_bitmap != lv_font_get_bitmap_fmt_txt) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void lvgl_raylib_draw_gpu_label_init(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    // White glyphs with the coverage in alpha, tinted by the vertex color when drawn
+    unit->atlas.id = rlLoadTexture(NULL, LVGL_RAYLIB_DRAW_GPU_ATLAS_SIZE, LVGL_RAYLIB_DRAW_GPU_ATLAS_SIZE,
+                                   PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA, 1);
+    if (unit->atlas.id == 0) {
+        TraceLog(LOG_ERROR, "Failed to create glyph atlas");
+        return;
+    }
+    unit->atlas.width = LVGL_RAYLIB_DRAW_GPU_ATLAS_SIZE;
+    unit->atlas.height = LVGL_RAYLIB_DRAW_GPU_ATLAS_SIZE;
+    unit->atlas.mipmaps = 1;
+    unit->atlas.format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+
+    unit->glyphs = calloc(LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS, sizeof(lvgl_raylib_draw_gpu_glyph_t));
+    if (unit->glyphs == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate glyph atlas index");
+        rlUnloadTexture(unit->atlas.id);
+        unit->atlas.id = 0;
+        return;
+    }
+    unit->text_window_start = GetTime();
+}
+
+void lvgl_raylib_draw_gpu_label(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    if (unit->atlas.id == 0) {
+        return;
+    }
+
+    const lv_draw_label_dsc_t * dsc = (const lv_draw_label_dsc_t *)t->draw_dsc;
+    if (dsc->opa <= LV_OPA_MIN) {
+        return;
+    }
+
+    lv_area_t draw_area;
+    if (!lv_area_intersect(&draw_area, &t->area, &t->clip_area)) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_target_t target;
+    if (!lvgl_raylib_draw_gpu_target_begin(unit, &target, layer, &draw_area)) {
+        return;
+    }
+
+    // Every glyph is a quad from the same atlas texture, so rlgl batches a whole label
+    // into a single draw call
+    _label_unit = unit;
+    _label_target = &target;
+    _label_glyphs = 0;
+#if LV_VERSION_CHECK(9, 3, 0)
+    lv_draw_label_iterate_characters(t, dsc, &t->area, lvgl_raylib_draw_gpu_label_glyph_cb);
+#else
+    unit->base_unit.target_layer = layer;
+    unit->base_unit.clip_area = &t->clip_area;
+    lv_draw_label_iterate_characters(&unit->base_unit, dsc, &t->area, lvgl_raylib_draw_gpu_label_glyph_cb);
+#endif
+    _label_unit = NULL;
+    _label_target = NULL;
+
+    lvgl_raylib_draw_gpu_target_end(unit, &target);
+    lvgl_raylib_draw_gpu_label_count(unit, _label_glyphs);
+}
+
+void lvgl_raylib_draw_gpu_label_drop_font(lvgl_raylib_draw_gpu_unit_t * unit, const lv_font_t * font)
+{
+    if (unit->glyphs == NULL) {
+        return;
+    }
+    if (font == NULL) {
+        lvgl_raylib_draw_gpu_label_evict(unit);
+        return;
+    }
+
+    // Open addressing can't just clear slots, probes would stop at the gap: the other fonts'
+    // glyphs are filed into a new index. Their atlas space stays, it is reclaimed on eviction.
+    lvgl_raylib_draw_gpu_glyph_t * glyphs = calloc(LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS, sizeof(lvgl_raylib_draw_gpu_glyph_t));
+    if (glyphs == NULL) {
+        lvgl_raylib_draw_gpu_label_evict(unit);
+        return;
+    }
+    uint32_t cnt = 0;
+    for (uint32_t i = 0; i < LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS; i++) {
+        const lvgl_raylib_draw_gpu_glyph_t * glyph = &unit->glyphs[i];
+        if (glyph->font == NULL || glyph->font == font) {
+            continue;
+        }
+        uint32_t slot = lvgl_raylib_draw_gpu_label_hash(glyph->font, glyph->index);
+        while (glyphs[slot].font != NULL) {
+            slot = (slot + 1) % LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS;
+        }
+        glyphs[slot] = *glyph;
+        cnt++;
+    }
+    free(unit->glyphs);
+    unit->glyphs = glyphs;
+    unit->glyph_cnt = cnt;
+    unit->text_stats.atlas_glyphs = cnt;
+}
+
+void lvgl_raylib_draw_gpu_label_deinit(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    if (unit->atlas.id != 0) {
+        rlUnloadTexture(unit->atlas.id);
+        unit->atlas.id = 0;
+    }
+    free(unit->glyphs);
+    unit->glyphs = NULL;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static void lvgl_raylib_draw_gpu_label_glyph_cb(LVGL_RAYLIB_GLYPH_CB_CTX * ctx, lv_draw_glyph_dsc_t * glyph_dsc, lv_draw_fill_dsc_t * fill_dsc, const lv_area_t * fill_area)
+{
+    LV_UNUSED(ctx);
+    lvgl_raylib_draw_gpu_unit_t * unit = _label_unit;
+    lvgl_raylib_draw_gpu_target_t * target = _label_target;
+
+    // Letter backgrounds, underlines and strikethroughs
+    if (fill_dsc != NULL && fill_area != NULL) {
+        DrawRectangleRec(lvgl_raylib_draw_gpu_target_rect(target, fill_area),
+                         lvgl_raylib_draw_gpu_color(fill_dsc->color, fill_dsc->opa));
+    }
+
+    if (glyph_dsc == NULL) {
+        return;
+    }
+
+    if (glyph_dsc->format == LV_FONT_GLYPH_FORMAT_NONE) {
+#if LV_USE_FONT_PLACEHOLDER
+        // Missing glyph, outline its box like the software renderer
+        if (glyph_dsc->bg_coords != NULL) {
+            DrawRectangleLinesEx(lvgl_raylib_draw_gpu_target_rect(target, glyph_dsc->bg_coords), 1.0f,
+                                 lvgl_raylib_draw_gpu_color(glyph_dsc->color, glyph_dsc->opa));
+        }
+#endif
+        return;
+    }
+
+    const lvgl_raylib_draw_gpu_glyph_t * glyph = lvgl_raylib_draw_gpu_label_get_glyph(unit, glyph_dsc);
+    if (glyph == NULL) {
+        return;
+    }
+
+    Rectangle src = { (float)glyph->x, (float)glyph->y, (float)glyph->w, (float)glyph->h };
+    DrawTexturePro(unit->atlas, src, lvgl_raylib_draw_gpu_target_rect(target, glyph_dsc->letter_coords),
+                   (Vector2){ 0, 0 }, 0.0f, lvgl_raylib_draw_gpu_color(glyph_dsc->color, glyph_dsc->opa));
+    _label_glyphs++;
+}
+
+static const lvgl_raylib_draw_gpu_glyph_t * lvgl_raylib_draw_gpu_label_get_glyph(lvgl_raylib_draw_gpu_unit_t * unit, const lv_draw_glyph_dsc_t * glyph_dsc)
+{
+    const lv_font_glyph_dsc_t * g = glyph_dsc->g;
+    const lv_draw_buf_t * bitmap = (const lv_draw_buf_t *)glyph_dsc->glyph_data;
+    if (g == NULL || bitmap == NULL || g->box_w == 0 || g->box_h == 0) {
+        return NULL;
+    }
+
+    const lv_font_t * font = g->resolved_font;
+    uint32_t index = g->gid.index;
+    uint32_t slot = lvgl_raylib_draw_gpu_label_hash(font, index);
+    while (unit->glyphs[slot].font != NULL) {
+        if (unit->glyphs[slot].font == font && unit->glyphs[slot].index == index) {
+            unit->text_stats.atlas_hits++;
+            return &unit->glyphs[slot];
+        }
+        slot = (slot + 1) % LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS;
+    }
+    unit->text_stats.atlas_misses++;
+
+    int32_t w = g->box_w;
+    int32_t h = g->box_h;
+    int32_t x;
+    int32_t y;
+    // Keep the index at most 3/4 full so probing stays short
+    if (unit->glyph_cnt >= LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS * 3 / 4 || !lvgl_raylib_draw_gpu_label_pack(unit, w, h, &x, &y)) {
+        lvgl_raylib_draw_gpu_label_evict(unit);
+        if (!lvgl_raylib_draw_gpu_label_pack(unit, w, h, &x, &y)) {
+            return NULL;
+        }
+        slot = lvgl_raylib_draw_gpu_label_hash(font, index);
+    }
+
+    // The font hands out A8 coverage, expand it to white + alpha for the atlas
+    if (!lvgl_raylib_draw_gpu_reserve_scratch(unit, (size_t)w * h * 2)) {
+        return NULL;
+    }
+    for (int32_t row = 0; row < h; row++) {
+        const uint8_t * src = bitmap->data + row * bitmap->header.stride;
+        uint8_t * dst = unit->scratch + (size_t)row * w * 2;
+        for (int32_t col = 0; col < w; col++) {
+            dst[col * 2] = 0xFF;
+            dst[col * 2 + 1] = src[col];
+        }
+    }
+    UpdateTextureRec(unit->atlas, (Rectangle){ (float)x, (float)y, (float)w, (float)h }, unit->scratch);
+
+    lvgl_raylib_draw_gpu_glyph_t * glyph = &unit->glyphs[slot];
+    glyph->font = font;
+    glyph->index = index;
+    glyph->x = (uint16_t)x;
+    glyph->y = (uint16_t)y;
+    glyph->w = (uint16_t)w;
+    glyph->h = (uint16_t)h;
+    unit->glyph_cnt++;
+    unit->text_stats.atlas_glyphs = unit->glyph_cnt;
+    return glyph;
+}
+
+static bool lvgl_raylib_draw_gpu_label_pack(lvgl_raylib_draw_gpu_unit_t * unit, int32_t w, int32_t h, int32_t * x, int32_t * y)
+{
+    // Shelf packing with a pixel of padding so filtering never picks up a neighbor
+    const int32_t size = LVGL_RAYLIB_DRAW_GPU_ATLAS_SIZE;
+    if (w + 1 > size || h + 1 > size) {
+        return false;
+    }
+
+    if (unit->shelf_x + w + 1 > size) {
+        unit->shelf_y += unit->shelf_h;
+        unit->shelf_x = 0;
+        unit->shelf_h = 0;
+    }
+    if (unit->shelf_y + h + 1 > size) {
+        return false;
+    }
+
+    *x = unit->shelf_x;
+    *y = unit->shelf_y;
+    unit->shelf_x += w + 1;
+    if (h + 1 > unit->shelf_h) {
+        unit->shelf_h = h + 1;
+    }
+    return true;
+}
+
+static void lvgl_raylib_draw_gpu_label_evict(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    // Quads already queued still sample the old atlas contents
+    rlDrawRenderBatchActive();
+
+    memset(unit->glyphs, 0, LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS * sizeof(lvgl_raylib_draw_gpu_glyph_t));
+    unit->glyph_cnt = 0;
+    unit->shelf_x = 0;
+    unit->shelf_y = 0;
+    unit->shelf_h = 0;
+    unit->text_stats.atlas_evictions++;
+    unit->text_stats.atlas_glyphs = 0;
+}
+
+static void lvgl_raylib_draw_gpu_label_count(lvgl_raylib_draw_gpu_unit_t * unit, uint32_t glyphs)
+{
+    unit->text_stats.glyphs_drawn += glyphs;
+    unit->text_glyphs_window += glyphs;
+
+    double now = GetTime();
+    if (now - unit->text_window_start >= 1.0) {
+        unit->text_stats.glyphs_per_sec = (uint32_t)(unit->text_glyphs_window / (now - unit->text_window_start));
+        unit->text_glyphs_window = 0;
+        unit->text_window_start = now;
+    }
+}
+
+static uint32_t lvgl_raylib_draw_gpu_label_hash(const lv_font_t * font, uint32_t index)
+{
+    uintptr_t key = (uintptr_t)font ^ ((uintptr_t)index * 2654435761u);
+    return (uint32_t)((key ^ (key >> 16)) % LVGL_RAYLIB_DRAW_GPU_GLYPH_SLOTS);
+}
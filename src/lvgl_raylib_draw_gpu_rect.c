@@ -0,0 +1,227 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib_draw_gpu.h"
+
+/* static variables */
+
+// Signed distance to a rounded box gives the coverage of each pixel, which is
+// both the rounded corner and its anti-aliasing. A border is the outer box
+// minus the inner one, a shadow fades out over `blur` pixels across the edge.
+// Nothing is drawn inside the `hole` box, e.g. the object casting a shadow.
+static const char * _rect_fs_330 =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec4 rect;\n"
+    "uniform float radius;\n"
+    "uniform float border;\n"
+    "uniform float blur;\n"
+    "uniform vec4 hole;\n"
+    "uniform float hole_radius;\n"
+    "out vec4 finalColor;\n"
+    "float box(vec2 p, vec4 r, float rad) {\n"
+    "    vec2 q = abs(p - (r.xy + r.zw) * 0.5) - (r.zw - r.xy) * 0.5 + rad;\n"
+    "    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - rad;\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 p = vec2(origin.x + gl_FragCoord.x, origin.y - gl_FragCoord.y);\n"
+    "    float d = box(p, rect, radius);\n"
+    "    float cov = blur > 0.0 ? 1.0 - smoothstep(-0.5 * blur, 0.5 * blur, d) : clamp(0.5 - d, 0.0, 1.0);\n"
+    "    vec4 inner = rect + vec4(border, border, -border, -border);\n"
+    "    if (border > 0.0 && inner.z > inner.x && inner.w > inner.y) {\n"
+    "        cov *= 1.0 - clamp(0.5 - box(p, inner, max(radius - border, 0.0)), 0.0, 1.0);\n"
+    "    }\n"
+    "    if (hole.z > hole.x) {\n"
+    "        cov *= 1.0 - clamp(0.5 - box(p, hole, hole_radius), 0.0, 1.0);\n"
+    "    }\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a * cov);\n"
+    "}\n";
+
+static const char * _rect_fs_100 =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec4 rect;\n"
+    "uniform float radius;\n"
+    "uniform float border;\n"
+    "uniform float blur;\n"
+    "uniform vec4 hole;\n"
+    "uniform float hole_radius;\n"
+    "float box(vec2 p, vec4 r, float rad) {\n"
+    "    vec2 q = abs(p - (r.xy + r.zw) * 0.5) - (r.zw - r.xy) * 0.5 + rad;\n"
+    "    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - rad;\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 p = vec2(origin.x + gl_FragCoord.x, origin.y - gl_FragCoord.y);\n"
+    "    float d = box(p, rect, radius);\n"
+    "    float cov = blur > 0.0 ? 1.0 - smoothstep(-0.5 * blur, 0.5 * blur, d) : clamp(0.5 - d, 0.0, 1.0);\n"
+    "    vec4 inner = rect + vec4(border, border, -border, -border);\n"
+    "    if (border > 0.0 && inner.z > inner.x && inner.w > inner.y) {\n"
+    "        cov *= 1.0 - clamp(0.5 - box(p, inner, max(radius - border, 0.0)), 0.0, 1.0);\n"
+    "    }\n"
+    "    if (hole.z > hole.x) {\n"
+    "        cov *= 1.0 - clamp(0.5 - box(p, hole, hole_radius), 0.0, 1.0);\n"
+    "    }\n"
+    "    gl_FragColor = vec4(fragColor.rgb, fragColor.a * cov);\n"
+    "}\n";
+
+/* PUBLIC IMPLEMENTATION */
+
+bool lvgl_raylib_draw_gpu_rect_supported(const lv_draw_task_t * t)
+{
+    if (t->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t * dsc = (const lv_draw_fill_dsc_t *)t->draw_dsc;
+        return dsc->grad.dir == LV_GRAD_DIR_NONE;
+    }
+
+    if (t->type == LV_DRAW_TASK_TYPE_BORDER) {
+        const lv_draw_border_dsc_t * dsc = (const lv_draw_border_dsc_t *)t->draw_dsc;
+        return dsc->side == LV_BORDER_SIDE_FULL;
+    }
+
+    return false;
+}
+
+void lvgl_raylib_draw_gpu_rect_init(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    unit->rect_shader = lvgl_raylib_draw_gpu_load_shader(_rect_fs_330, _rect_fs_100);
+    unit->rect_loc_origin = GetShaderLocation(unit->rect_shader, "origin");
+    unit->rect_loc_rect = GetShaderLocation(unit->rect_shader, "rect");
+    unit->rect_loc_radius = GetShaderLocation(unit->rect_shader, "radius");
+    unit->rect_loc_border = GetShaderLocation(unit->rect_shader, "border");
+    unit->rect_loc_blur = GetShaderLocation(unit->rect_shader, "blur");
+    unit->rect_loc_hole = GetShaderLocation(unit->rect_shader, "hole");
+    unit->rect_loc_hole_radius = GetShaderLocation(unit->rect_shader, "hole_radius");
+}
+
+void lvgl_raylib_draw_gpu_rect(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    if (unit->rect_shader.id == 0) {
+        return;
+    }
+
+    lv_color_t color;
+    lv_opa_t opa;
+    int32_t radius;
+    float border = 0.0f;
+    if (t->type == LV_DRAW_TASK_TYPE_FILL) {
+        const lv_draw_fill_dsc_t * dsc = (const lv_draw_fill_dsc_t *)t->draw_dsc;
+        color = dsc->color;
+        opa = dsc->opa;
+        radius = dsc->radius;
+    } else {
+        const lv_draw_border_dsc_t * dsc = (const lv_draw_border_dsc_t *)t->draw_dsc;
+        color = dsc->color;
+        opa = dsc->opa;
+        radius = dsc->radius;
+        border = (float)dsc->width;
+    }
+
+    lv_area_t draw_area;
+    if (!lv_area_intersect(&draw_area, &t->area, &t->clip_area)) {
+        return;
+    }
+
+    // A backdrop blur has to run even under a fully transparent fill
+    int32_t blur_radius = t->type == LV_DRAW_TASK_TYPE_FILL ? lvgl_raylib_draw_gpu_blur_get(unit, t) : 0;
+    if (opa <= LV_OPA_MIN && blur_radius == 0) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_target_t target;
+    if (!lvgl_raylib_draw_gpu_target_begin(unit, &target, layer, &draw_area)) {
+        return;
+    }
+
+    if (blur_radius > 0) {
+        // Only the task's own area is sampled. Around it the software unit may be drawing
+        // right now, so the blur clamps to the edge pixels instead of reading past them.
+        lvgl_raylib_draw_gpu_blur(unit, &target, &draw_area, &t->area, radius, blur_radius);
+    }
+    if (opa > LV_OPA_MIN) {
+        lvgl_raylib_draw_gpu_rect_draw(unit, &target, &t->area, &draw_area, radius, border, 0.0f, NULL, 0,
+                                       lvgl_raylib_draw_gpu_color(color, opa));
+    }
+
+    lvgl_raylib_draw_gpu_target_end(unit, &target);
+}
+
+void lvgl_raylib_draw_gpu_shadow(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    const lv_draw_box_shadow_dsc_t * dsc = (const lv_draw_box_shadow_dsc_t *)t->draw_dsc;
+    if (unit->rect_shader.id == 0 || dsc->opa <= LV_OPA_MIN) {
+        return;
+    }
+
+    // The task's area is the object, the shadow spreads over the real area
+    lv_area_t draw_area;
+    if (!lv_area_intersect(&draw_area, &t->_real_area, &t->clip_area)) {
+        return;
+    }
+
+    // Same core rectangle as the software renderer: moved by the offset, grown by the spread
+    lv_area_t core = t->area;
+    lv_area_move(&core, dsc->ofs_x, dsc->ofs_y);
+    lv_area_increase(&core, dsc->spread, dsc->spread);
+    if (lv_area_get_width(&core) <= 0 || lv_area_get_height(&core) <= 0) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_target_t target;
+    if (!lvgl_raylib_draw_gpu_target_begin(unit, &target, layer, &draw_area)) {
+        return;
+    }
+
+    // Like the software renderer, the shadow is cut out under the object: a translucent
+    // background must not show it through
+    int32_t short_side = LV_MIN(lv_area_get_width(&t->area), lv_area_get_height(&t->area));
+    int32_t radius = LV_MIN(dsc->radius, short_side / 2) + dsc->spread;
+    lvgl_raylib_draw_gpu_rect_draw(unit, &target, &core, &draw_area, LV_MAX(radius, 0), 0.0f, (float)dsc->width,
+                                   &t->area, LV_MIN(dsc->radius, short_side / 2),
+                                   lvgl_raylib_draw_gpu_color(dsc->color, dsc->opa));
+
+    lvgl_raylib_draw_gpu_target_end(unit, &target);
+}
+
+void lvgl_raylib_draw_gpu_rect_draw(lvgl_raylib_draw_gpu_unit_t * unit, const lvgl_raylib_draw_gpu_target_t * target,
+                                    const lv_area_t * coords, const lv_area_t * draw_area, int32_t radius, float border, float blur,
+                                    const lv_area_t * hole, int32_t hole_radius, Color color)
+{
+    // LV_RADIUS_CIRCLE and oversized radii are clamped like the software renderer does
+    int32_t short_side = LV_MIN(lv_area_get_width(coords), lv_area_get_height(coords));
+    float rad = (float)LV_MIN(radius, short_side / 2);
+
+    Vector2 origin = lvgl_raylib_draw_gpu_target_origin(target);
+    float rect[4] = { (float)coords->x1, (float)coords->y1, (float)coords->x2 + 1.0f, (float)coords->y2 + 1.0f };
+    float hole_rect[4] = { 0 };
+    if (hole != NULL) {
+        hole_rect[0] = (float)hole->x1;
+        hole_rect[1] = (float)hole->y1;
+        hole_rect[2] = (float)hole->x2 + 1.0f;
+        hole_rect[3] = (float)hole->y2 + 1.0f;
+    }
+    float hole_rad = (float)hole_radius;
+
+    BeginShaderMode(unit->rect_shader);
+    SetShaderValue(unit->rect_shader, unit->rect_loc_origin, &origin, SHADER_UNIFORM_VEC2);
+    SetShaderValue(unit->rect_shader, unit->rect_loc_rect, rect, SHADER_UNIFORM_VEC4);
+    SetShaderValue(unit->rect_shader, unit->rect_loc_radius, &rad, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(unit->rect_shader, unit->rect_loc_border, &border, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(unit->rect_shader, unit->rect_loc_blur, &blur, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(unit->rect_shader, unit->rect_loc_hole, hole_rect, SHADER_UNIFORM_VEC4);
+    SetShaderValue(unit->rect_shader, unit->rect_loc_hole_radius, &hole_rad, SHADER_UNIFORM_FLOAT);
+    DrawRectangleRec(lvgl_raylib_draw_gpu_target_rect(target, draw_area), color);
+    EndShaderMode();
+}
+
+void lvgl_raylib_draw_gpu_rect_deinit(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    if (unit->rect_shader.id != 0) {
+        UnloadShader(unit->rect_shader);
+        unit->rect_shader.id = 0;
+    }
+}
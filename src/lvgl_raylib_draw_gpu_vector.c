@@ -0,0 +1,1045 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "lvgl_private.h"
+#include "rlgl.h"
+#include "lvgl_raylib_draw_gpu.h"
+
+#if LV_USE_VECTOR_GRAPHIC
+
+/* private defines */
+
+/** Largest supersampled mask edge, bigger regions fall back to fewer samples */
+#define LVGL_RAYLIB_VECTOR_MASK_MAX 4096
+
+/** Flattening tolerance in pixels */
+#define LVGL_RAYLIB_VECTOR_TOLERANCE 0.2f
+
+#define LVGL_RAYLIB_VECTOR_MAX_STOPS 8
+
+/* private types */
+
+typedef struct {
+    uint32_t start;
+    uint32_t cnt;
+    bool closed;
+} lvgl_raylib_vector_sub_t;
+
+/** Flattened path: polylines in path coordinates */
+typedef struct {
+    float * pts;
+    uint32_t pts_cnt;
+    uint32_t pts_cap;
+    lvgl_raylib_vector_sub_t * subs;
+    uint32_t subs_cnt;
+    uint32_t subs_cap;
+} lvgl_raylib_vector_poly_t;
+
+/** Triangle soup being built, positive and negative orientation kept apart */
+typedef struct {
+    float * pos;
+    uint32_t pos_cnt;           // floats
+    uint32_t pos_cap;
+    float * neg;
+    uint32_t neg_cnt;
+    uint32_t neg_cap;
+} lvgl_raylib_vector_tris_t;
+
+/** Paint of a fill or stroke, resolved for the cover shader */
+typedef struct {
+    const lv_vector_draw_dsc_t * dsc;
+    lv_vector_draw_style_t style;
+    lv_color32_t color;
+    lv_opa_t opa;
+    const lv_vector_gradient_t * gradient;
+    const lv_matrix_t * matrix;
+    bool even_odd;
+} lvgl_raylib_vector_paint_t;
+
+/** One piece of a mesh cache key */
+typedef struct {
+    const void * data;
+    size_t size;
+} lvgl_raylib_vector_key_part_t;
+
+/* private prototypes */
+
+static bool lvgl_raylib_draw_gpu_vector_paint_supported(lv_vector_draw_style_t style);
+static void lvgl_raylib_draw_gpu_vector_entry(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * draw_area,
+                                              const lv_vector_path_t * path, const lv_vector_draw_dsc_t * dsc);
+static void lvgl_raylib_draw_gpu_vector_clear(lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * draw_area, const lv_vector_draw_dsc_t * dsc);
+static void lvgl_raylib_draw_gpu_vector_paint(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * draw_area,
+                                              const lvgl_raylib_draw_gpu_path_t * mesh, const lvgl_raylib_vector_paint_t * paint);
+static lvgl_raylib_draw_gpu_path_t * lvgl_raylib_draw_gpu_vector_get_mesh(lvgl_raylib_draw_gpu_unit_t * unit, const lv_vector_path_t * path,
+                                                                         const lv_vector_draw_dsc_t * dsc, bool stroke);
+static void lvgl_raylib_draw_gpu_vector_flatten(lvgl_raylib_vector_poly_t * poly, const lv_vector_path_t * path, float tolerance);
+static bool lvgl_raylib_draw_gpu_vector_dash(lvgl_raylib_vector_poly_t * dst, const lvgl_raylib_vector_poly_t * src, const lv_array_t * pattern);
+static void lvgl_raylib_draw_gpu_vector_fill_tris(lvgl_raylib_vector_tris_t * tris, const lvgl_raylib_vector_poly_t * poly);
+static void lvgl_raylib_draw_gpu_vector_stroke_tris(lvgl_raylib_vector_tris_t * tris, const lvgl_raylib_vector_poly_t * poly,
+                                                    const lv_vector_stroke_dsc_t * stroke, float tolerance);
+static void lvgl_raylib_draw_gpu_vector_circle(lvgl_raylib_vector_tris_t * tris, float x, float y, float r, float tolerance);
+static void lvgl_raylib_draw_gpu_vector_tri(lvgl_raylib_vector_tris_t * tris, float x0, float y0, float x1, float y1, float x2, float y2, bool positive_only);
+static void lvgl_raylib_draw_gpu_vector_point(lvgl_raylib_vector_poly_t * poly, float x, float y);
+static void lvgl_raylib_draw_gpu_vector_begin_sub(lvgl_raylib_vector_poly_t * poly);
+static void lvgl_raylib_draw_gpu_vector_poly_free(lvgl_raylib_vector_poly_t * poly);
+static bool lvgl_raylib_draw_gpu_vector_reserve(void ** data, uint32_t * cap, uint32_t need, size_t elem_size);
+static void lvgl_raylib_draw_gpu_vector_transform(const lv_matrix_t * m, float x, float y, float * out_x, float * out_y);
+static bool lvgl_raylib_draw_gpu_vector_invert(const lv_matrix_t * m, float inv[6]);
+static uint32_t lvgl_raylib_draw_gpu_vector_hash(uint32_t hash, const void * data, size_t size);
+static bool lvgl_raylib_draw_gpu_vector_key_equal(const uint8_t * key, const lvgl_raylib_vector_key_part_t * parts, uint32_t parts_cnt);
+static void lvgl_raylib_draw_gpu_vector_trim(lvgl_raylib_draw_gpu_unit_t * unit);
+
+/* static variables */
+
+// Cover pass. The mask holds 128 + the winding number of every sample, the fill rule
+// turns each into inside/outside and the samples of a pixel average into its coverage.
+static const char * _vector_fs_330 =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 size;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec2 maskOrigin;\n"
+    "uniform float ss;\n"
+    "uniform float evenOdd;\n"
+    "uniform float style;\n"
+    "uniform vec3 inv0;\n"
+    "uniform vec3 inv1;\n"
+    "uniform vec4 grad;\n"
+    "uniform float spread;\n"
+    "uniform float stopCnt;\n"
+    "uniform vec4 stopColors[8];\n"
+    "uniform float stopPos[8];\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    vec2 px = vec2(origin.x + floor(gl_FragCoord.x), origin.y - 1.0 - floor(gl_FragCoord.y));\n"
+    "    vec2 base = vec2(px.x - maskOrigin.x, maskOrigin.y - 1.0 - px.y) * ss;\n"
+    "    float inside = 0.0;\n"
+    "    for (int j = 0; j < 4; j++) {\n"
+    "        if (float(j) >= ss) break;\n"
+    "        for (int i = 0; i < 4; i++) {\n"
+    "            if (float(i) >= ss) break;\n"
+    "            float w = floor(texture(texture0, (base + vec2(float(i), float(j)) + 0.5) / size).r * 255.0 + 0.5) - 128.0;\n"
+    "            inside += evenOdd > 0.5 ? mod(abs(w), 2.0) : step(0.5, abs(w));\n"
+    "        }\n"
+    "    }\n"
+    "    float cov = inside / (ss * ss);\n"
+    "    if (cov <= 0.0) discard;\n"
+    "    vec4 color = fragColor;\n"
+    "    if (style > 0.5) {\n"
+    "        vec2 c = px + 0.5;\n"
+    "        vec2 g = vec2(dot(inv0, vec3(c, 1.0)), dot(inv1, vec3(c, 1.0)));\n"
+    "        float t;\n"
+    "        if (style < 1.5) {\n"
+    "            vec2 d = grad.zw - grad.xy;\n"
+    "            t = dot(g - grad.xy, d) / max(dot(d, d), 0.0001);\n"
+    "        } else {\n"
+    "            t = length(g - grad.xy) / max(grad.z, 0.0001);\n"
+    "        }\n"
+    "        if (spread > 1.5) t = 1.0 - abs(mod(t, 2.0) - 1.0);\n"
+    "        else if (spread > 0.5) t = fract(t);\n"
+    "        t = clamp(t, 0.0, 1.0);\n"
+    "        color = stopColors[0];\n"
+    "        for (int k = 1; k < 8; k++) {\n"
+    "            if (float(k) >= stopCnt) break;\n"
+    "            float range = max(stopPos[k] - stopPos[k - 1], 0.0001);\n"
+    "            color = mix(color, stopColors[k], clamp((t - stopPos[k - 1]) / range, 0.0, 1.0));\n"
+    "        }\n"
+    "        color.a *= fragColor.a;\n"
+    "    }\n"
+    "    finalColor = vec4(color.rgb, color.a * cov);\n"
+    "}\n";
+
+static const char * _vector_fs_100 =
+    "#version 100\n"
+    "precision highp float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec2 size;\n"
+    "uniform vec2 origin;\n"
+    "uniform vec2 maskOrigin;\n"
+    "uniform float ss;\n"
+    "uniform float evenOdd;\n"
+    "uniform float style;\n"
+    "uniform vec3 inv0;\n"
+    "uniform vec3 inv1;\n"
+    "uniform vec4 grad;\n"
+    "uniform float spread;\n"
+    "uniform float stopCnt;\n"
+    "uniform vec4 stopColors[8];\n"
+    "uniform float stopPos[8];\n"
+    "void main() {\n"
+    "    vec2 px = vec2(origin.x + floor(gl_FragCoord.x), origin.y - 1.0 - floor(gl_FragCoord.y));\n"
+    "    vec2 base = vec2(px.x - maskOrigin.x, maskOrigin.y - 1.0 - px.y) * ss;\n"
+    "    float inside = 0.0;\n"
+    "    for (int j = 0; j < 4; j++) {\n"
+    "        if (float(j) >= ss) break;\n"
+    "        for (int i = 0; i < 4; i++) {\n"
+    "            if (float(i) >= ss) break;\n"
+    "            float w = floor(texture2D(texture0, (base + vec2(float(i), float(j)) + 0.5) / size).r * 255.0 + 0.5) - 128.0;\n"
+    "            inside += evenOdd > 0.5 ? mod(abs(w), 2.0) : step(0.5, abs(w));\n"
+    "        }\n"
+    "    }\n"
+    "    float cov = inside / (ss * ss);\n"
+    "    if (cov <= 0.0) discard;\n"
+    "    vec4 color = fragColor;\n"
+    "    if (style > 0.5) {\n"
+    "        vec2 c = px + 0.5;\n"
+    "        vec2 g = vec2(dot(inv0, vec3(c, 1.0)), dot(inv1, vec3(c, 1.0)));\n"
+    "        float t;\n"
+    "        if (style < 1.5) {\n"
+    "            vec2 d = grad.zw - grad.xy;\n"
+    "            t = dot(g - grad.xy, d) / max(dot(d, d), 0.0001);\n"
+    "        } else {\n"
+    "            t = length(g - grad.xy) / max(grad.z, 0.0001);\n"
+    "        }\n"
+    "        if (spread > 1.5) t = 1.0 - abs(mod(t, 2.0) - 1.0);\n"
+    "        else if (spread > 0.5) t = fract(t);\n"
+    "        t = clamp(t, 0.0, 1.0);\n"
+    "        color = stopColors[0];\n"
+    "        for (int k = 1; k < 8; k++) {\n"
+    "            if (float(k) >= stopCnt) break;\n"
+    "            float range = max(stopPos[k] - stopPos[k - 1], 0.0001);\n"
+    "            color = mix(color, stopColors[k], clamp((t - stopPos[k - 1]) / range, 0.0, 1.0));\n"
+    "        }\n"
+    "        color.a *= fragColor.a;\n"
+    "    }\n"
+    "    gl_FragColor = vec4(color.rgb, color.a * cov);\n"
+    "}\n";
+
+/* PUBLIC IMPLEMENTATION */
+
+bool lvgl_raylib_draw_gpu_vector_supported(const lv_draw_task_t * t)
+{
+    const lv_draw_vector_task_dsc_t * dsc = (const lv_draw_vector_task_dsc_t *)t->draw_dsc;
+    if (dsc->task_list == NULL) {
+        return false;
+    }
+
+    // Image patterns aren't supported and the whole task has to be drawn by one unit, so such
+    // tasks go to the software unit which, without ThorVG, skips them
+    lv_vector_draw_task * entry;
+    LV_LL_READ(dsc->task_list, entry) {
+        if (entry->path == NULL) {
+            continue;
+        }
+        if (!lvgl_raylib_draw_gpu_vector_paint_supported(entry->dsc.fill_dsc.style)
+            || !lvgl_raylib_draw_gpu_vector_paint_supported(entry->dsc.stroke_dsc.style)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void lvgl_raylib_draw_gpu_vector_init(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    lv_ll_init(&unit->paths, sizeof(lvgl_raylib_draw_gpu_path_t));
+
+    unit->vector_shader = lvgl_raylib_draw_gpu_load_shader(_vector_fs_330, _vector_fs_100);
+    const char * names[LVGL_RAYLIB_DRAW_GPU_VECTOR_LOC_CNT] = {
+        "size", "origin", "maskOrigin", "ss", "evenOdd", "style", "inv0", "inv1",
+        "grad", "spread", "stopCnt", "stopColors", "stopPos"
+    };
+    for (int i = 0; i < LVGL_RAYLIB_DRAW_GPU_VECTOR_LOC_CNT; i++) {
+        unit->vector_locs[i] = GetShaderLocation(unit->vector_shader, names[i]);
+    }
+}
+
+void lvgl_raylib_draw_gpu_vector(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    const lv_draw_vector_task_dsc_t * dsc = (const lv_draw_vector_task_dsc_t *)t->draw_dsc;
+    if (unit->vector_shader.id == 0 || dsc->task_list == NULL) {
+        return;
+    }
+
+    lv_area_t draw_area;
+    if (!lv_area_intersect(&draw_area, &t->area, &t->clip_area)) {
+        return;
+    }
+
+    lvgl_raylib_draw_gpu_target_t target;
+    if (!lvgl_raylib_draw_gpu_target_begin(unit, &target, layer, &draw_area)) {
+        return;
+    }
+
+    // Paths are drawn in order, each on top of the previous ones
+    lv_vector_draw_task * entry;
+    LV_LL_READ(dsc->task_list, entry) {
+        lv_area_t entry_area;
+        if (!lv_area_intersect(&entry_area, &draw_area, &entry->dsc.scissor_area)) {
+            continue;
+        }
+        if (entry->path == NULL) {
+            lvgl_raylib_draw_gpu_vector_clear(&target, &entry_area, &entry->dsc);
+        } else {
+            lvgl_raylib_draw_gpu_vector_entry(unit, &target, &entry_area, entry->path, &entry->dsc);
+        }
+    }
+
+    lvgl_raylib_draw_gpu_target_end(unit, &target);
+}
+
+lvgl_raylib_draw_gpu_path_t * lvgl_raylib_draw_gpu_vector_oldest(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    uint32_t now = lvgl_raylib_budget_now();
+    lvgl_raylib_draw_gpu_path_t * oldest = NULL;
+    lvgl_raylib_draw_gpu_path_t * mesh;
+    LV_LL_READ(&unit->paths, mesh) {
+        if (oldest == NULL || now - mesh->last_used > now - oldest->last_used) {
+            oldest = mesh;
+        }
+    }
+    return oldest;
+}
+
+void lvgl_raylib_draw_gpu_vector_evict(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_path_t * mesh)
+{
+    unit->path_stats.entries--;
+    unit->path_stats.size -= mesh->size;
+    lv_free(mesh->vertices);
+    lv_ll_remove(&unit->paths, mesh);
+    lv_free(mesh);
+}
+
+void lvgl_raylib_draw_gpu_vector_deinit(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    lvgl_raylib_draw_gpu_path_t * mesh;
+    LV_LL_READ(&unit->paths, mesh) {
+        lv_free(mesh->vertices);
+    }
+    lv_ll_clear(&unit->paths);
+    unit->path_stats.entries = 0;
+    unit->path_stats.size = 0;
+
+    if (unit->vector_shader.id != 0) {
+        UnloadShader(unit->vector_shader);
+        unit->vector_shader.id = 0;
+    }
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool lvgl_raylib_draw_gpu_vector_paint_supported(lv_vector_draw_style_t style)
+{
+    return style == LV_VECTOR_DRAW_STYLE_SOLID || style == LV_VECTOR_DRAW_STYLE_GRADIENT;
+}
+
+static void lvgl_raylib_draw_gpu_vector_entry(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * draw_area,
+                                              const lv_vector_path_t * path, const lv_vector_draw_dsc_t * dsc)
+{
+    // Fill first, the stroke goes on top like in ThorVG
+    const lv_vector_fill_dsc_t * fill = &dsc->fill_dsc;
+    if (fill->opa > LV_OPA_MIN) {
+        lvgl_raylib_draw_gpu_path_t * mesh = lvgl_raylib_draw_gpu_vector_get_mesh(unit, path, dsc, false);
+        if (mesh != NULL) {
+            lvgl_raylib_vector_paint_t paint = {
+                dsc, fill->style, fill->color, fill->opa, &fill->gradient, &fill->matrix, fill->fill_rule == LV_VECTOR_FILL_EVENODD
+            };
+            lvgl_raylib_draw_gpu_vector_paint(unit, target, draw_area, mesh, &paint);
+        }
+    }
+
+    const lv_vector_stroke_dsc_t * stroke = &dsc->stroke_dsc;
+    if (stroke->opa > LV_OPA_MIN && stroke->width > 0.0f) {
+        lvgl_raylib_draw_gpu_path_t * mesh = lvgl_raylib_draw_gpu_vector_get_mesh(unit, path, dsc, true);
+        if (mesh != NULL) {
+            lvgl_raylib_vector_paint_t paint = {
+                dsc, stroke->style, stroke->color, stroke->opa, &stroke->gradient, &stroke->matrix, false
+            };
+            lvgl_raylib_draw_gpu_vector_paint(unit, target, draw_area, mesh, &paint);
+        }
+    }
+}
+
+static void lvgl_raylib_draw_gpu_vector_clear(lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * draw_area, const lv_vector_draw_dsc_t * dsc)
+{
+    // lv_vector_clear_area() replaces the pixels, no blending. The mirror is premultiplied.
+    lv_color32_t c = dsc->fill_dsc.color;
+    Color color = {
+        (uint8_t)((c.blue * c.alpha + 127) / 255), (uint8_t)((c.green * c.alpha + 127) / 255), (uint8_t)((c.red * c.alpha + 127) / 255), c.alpha
+    };
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    DrawRectangleRec(lvgl_raylib_draw_gpu_target_rect(target, draw_area), color);
+    EndBlendMode();
+    lvgl_raylib_draw_gpu_target_blend();
+}
+
+static void lvgl_raylib_draw_gpu_vector_paint(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_target_t * target, const lv_area_t * draw_area,
+                                              const lvgl_raylib_draw_gpu_path_t * mesh, const lvgl_raylib_vector_paint_t * paint)
+{
+    const lv_matrix_t * matrix = &paint->dsc->matrix;
+
+    // Only the part of the region the transformed mesh can touch needs a mask
+    float corners[4][2] = { { mesh->min_x, mesh->min_y }, { mesh->max_x, mesh->min_y }, { mesh->min_x, mesh->max_y }, { mesh->max_x, mesh->max_y } };
+    float min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+    for (int i = 0; i < 4; i++) {
+        float x, y;
+        lvgl_raylib_draw_gpu_vector_transform(matrix, corners[i][0], corners[i][1], &x, &y);
+        min_x = LV_MIN(min_x, x);
+        min_y = LV_MIN(min_y, y);
+        max_x = LV_MAX(max_x, x);
+        max_y = LV_MAX(max_y, y);
+    }
+    lv_area_t mesh_area = { (int32_t)floorf(min_x), (int32_t)floorf(min_y), (int32_t)ceilf(max_x), (int32_t)ceilf(max_y) };
+    lv_area_t region;
+    if (!lv_area_intersect(&region, &mesh_area, draw_area)) {
+        return;
+    }
+
+    int32_t w = lv_area_get_width(&region);
+    int32_t h = lv_area_get_height(&region);
+    int32_t ss = mesh->quality == LV_VECTOR_PATH_QUALITY_LOW ? 1 : 4;
+    while (ss > 1 && (w * ss > LVGL_RAYLIB_VECTOR_MASK_MAX || h * ss > LVGL_RAYLIB_VECTOR_MASK_MAX)) {
+        ss /= 2;
+    }
+
+    lvgl_raylib_draw_gpu_rt_t * mask = lvgl_raylib_draw_gpu_get_rt(unit, w * ss, h * ss, target->target);
+    if (mask == NULL) {
+        return;
+    }
+    mask->last_used = ++unit->frame;
+
+    lvgl_raylib_draw_gpu_target_pause(target);
+
+    // Winding count pass: every triangle of the fan adds or removes one around 128
+    BeginTextureMode(mask->rt);
+    ClearBackground((Color){ 128, 0, 0, 0 });
+    rlDisableBackfaceCulling();
+    float base_y = (float)(mask->rt.texture.height - h * ss);
+    const float * v = mesh->vertices;
+    for (int pass = 0; pass < 2; pass++) {
+        uint32_t cnt = pass == 0 ? mesh->pos_cnt : mesh->neg_cnt;
+        rlSetBlendFactors(RL_ONE, RL_ONE, pass == 0 ? RL_FUNC_ADD : RL_FUNC_REVERSE_SUBTRACT);
+        BeginBlendMode(BLEND_CUSTOM);
+        for (uint32_t i = 0; i < cnt; i++) {
+            rlCheckRenderBatchLimit(3);
+            rlBegin(RL_TRIANGLES);
+            rlColor4ub(1, 0, 0, 0);
+            for (int k = 0; k < 3; k++) {
+                float x, y;
+                lvgl_raylib_draw_gpu_vector_transform(matrix, v[0], v[1], &x, &y);
+                rlVertex2f((x - (float)region.x1) * ss, base_y + (y - (float)region.y1) * ss);
+                v += 2;
+            }
+            rlEnd();
+        }
+        EndBlendMode();
+    }
+    rlEnableBackfaceCulling();
+    EndTextureMode();
+
+    // Cover pass over the region of the target
+    lvgl_raylib_draw_gpu_target_resume(target);
+
+    const int * locs = unit->vector_locs;
+    Shader shader = unit->vector_shader;
+    Vector2 size = { (float)mask->rt.texture.width, (float)mask->rt.texture.height };
+    Vector2 origin = lvgl_raylib_draw_gpu_target_origin(target);
+    Vector2 mask_origin = { (float)region.x1, (float)(region.y1 + h) };
+    float ss_f = (float)ss;
+    float even_odd = paint->even_odd ? 1.0f : 0.0f;
+    float style = 0.0f;
+    BeginShaderMode(shader);
+    SetShaderValue(shader, locs[0], &size, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locs[1], &origin, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locs[2], &mask_origin, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shader, locs[3], &ss_f, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, locs[4], &even_odd, SHADER_UNIFORM_FLOAT);
+
+    float inv[6];
+    const lv_vector_gradient_t * g = paint->gradient;
+    if (paint->style == LV_VECTOR_DRAW_STYLE_GRADIENT && g->stops_count > 0) {
+        // Gradient coordinates go through the paint's matrix, then the path's
+        lv_matrix_t m = *matrix;
+        lv_matrix_multiply(&m, paint->matrix);
+        if (lvgl_raylib_draw_gpu_vector_invert(&m, inv)) {
+            style = g->style == LV_VECTOR_GRADIENT_STYLE_RADIAL ? 2.0f : 1.0f;
+            float grad[4] = { g->x1, g->y1, g->x2, g->y2 };
+            if (g->style == LV_VECTOR_GRADIENT_STYLE_RADIAL) {
+                grad[0] = g->cx;
+                grad[1] = g->cy;
+                grad[2] = g->cr;
+            }
+            float spread = g->spread == LV_VECTOR_GRADIENT_SPREAD_REPEAT ? 1.0f : g->spread == LV_VECTOR_GRADIENT_SPREAD_REFLECT ? 2.0f : 0.0f;
+            uint32_t cnt = LV_MIN(g->stops_count, LVGL_RAYLIB_VECTOR_MAX_STOPS);
+            float stop_cnt = (float)cnt;
+            float colors[LVGL_RAYLIB_VECTOR_MAX_STOPS * 4] = { 0 };
+            float pos[LVGL_RAYLIB_VECTOR_MAX_STOPS] = { 0 };
+            for (uint32_t i = 0; i < cnt; i++) {
+                colors[i * 4 + 0] = g->stops[i].color.blue / 255.0f;
+                colors[i * 4 + 1] = g->stops[i].color.green / 255.0f;
+                colors[i * 4 + 2] = g->stops[i].color.red / 255.0f;
+                colors[i * 4 + 3] = g->stops[i].opa / 255.0f;
+                pos[i] = g->stops[i].frac / 255.0f;
+            }
+            SetShaderValue(shader, locs[6], &inv[0], SHADER_UNIFORM_VEC3);
+            SetShaderValue(shader, locs[7], &inv[3], SHADER_UNIFORM_VEC3);
+            SetShaderValue(shader, locs[8], grad, SHADER_UNIFORM_VEC4);
+            SetShaderValue(shader, locs[9], &spread, SHADER_UNIFORM_FLOAT);
+            SetShaderValue(shader, locs[10], &stop_cnt, SHADER_UNIFORM_FLOAT);
+            SetShaderValueV(shader, locs[11], colors, SHADER_UNIFORM_VEC4, LVGL_RAYLIB_VECTOR_MAX_STOPS);
+            SetShaderValueV(shader, locs[12], pos, SHADER_UNIFORM_FLOAT, LVGL_RAYLIB_VECTOR_MAX_STOPS);
+        }
+    }
+    SetShaderValue(shader, locs[5], &style, SHADER_UNIFORM_FLOAT);
+
+    // Solid colors come in through the vertex color, gradients only use its alpha
+    lv_color32_t c = paint->color;
+    Color color = { c.blue, c.green, c.red, (uint8_t)(style > 0.0f ? paint->opa : LV_UDIV255(c.alpha * paint->opa)) };
+    Rectangle src = { 0, 0, (float)(w * ss), (float)(h * ss) };
+    DrawTexturePro(mask->rt.texture, src, lvgl_raylib_draw_gpu_target_rect(target, &region), (Vector2){ 0, 0 }, 0.0f, color);
+    EndShaderMode();
+}
+
+static lvgl_raylib_draw_gpu_path_t * lvgl_raylib_draw_gpu_vector_get_mesh(lvgl_raylib_draw_gpu_unit_t * unit, const lv_vector_path_t * path,
+                                                                         const lv_vector_draw_dsc_t * dsc, bool stroke)
+{
+    // Paths are usually rebuilt for every draw, so they are keyed by content rather than
+    // address. Flattening depends on the scale, which is kept in half octaves.
+    const lv_matrix_t * m = &dsc->matrix;
+    float scale = sqrtf(fabsf(m->m[0][0] * m->m[1][1] - m->m[0][1] * m->m[1][0]));
+    if (scale <= 0.0f) {
+        return NULL;
+    }
+    int32_t scale_key = (int32_t)floorf(log2f(scale) * 2.0f);
+    float tolerance = LVGL_RAYLIB_VECTOR_TOLERANCE / powf(2.0f, (float)(scale_key + 1) / 2.0f);
+
+    // The hash only picks the candidates, a hit needs the whole key to match. Counts go in
+    // too so the variable length parts can't shift into each other.
+    const lv_vector_stroke_dsc_t * s = &dsc->stroke_dsc;
+    lvgl_raylib_vector_key_part_t parts[] = {
+        { &path->ops.size, sizeof(path->ops.size) },
+        { &path->points.size, sizeof(path->points.size) },
+        { &scale_key, sizeof(scale_key) },
+        { &stroke, sizeof(stroke) },
+        { path->ops.data, (size_t)path->ops.size * path->ops.element_size },
+        { path->points.data, (size_t)path->points.size * path->points.element_size },
+        { &s->width, sizeof(s->width) },
+        { &s->cap, sizeof(s->cap) },
+        { &s->join, sizeof(s->join) },
+        { &s->miter_limit, sizeof(s->miter_limit) },
+        { &s->dash_pattern.size, sizeof(s->dash_pattern.size) },
+        { s->dash_pattern.data, (size_t)s->dash_pattern.size * s->dash_pattern.element_size },
+    };
+    // Stroke parameters don't matter for fills
+    uint32_t parts_cnt = stroke ? sizeof(parts) / sizeof(parts[0]) : 6;
+
+    uint32_t hash = 2166136261u;
+    size_t key_size = 0;
+    for (uint32_t i = 0; i < parts_cnt; i++) {
+        hash = lvgl_raylib_draw_gpu_vector_hash(hash, parts[i].data, parts[i].size);
+        key_size += parts[i].size;
+    }
+
+    lvgl_raylib_draw_gpu_path_t * mesh;
+    LV_LL_READ(&unit->paths, mesh) {
+        if (mesh->hash == hash && mesh->key_size == key_size && lvgl_raylib_draw_gpu_vector_key_equal(mesh->key, parts, parts_cnt)) {
+            mesh->last_used = lvgl_raylib_budget_touch();
+            unit->path_stats.hits++;
+            return mesh;
+        }
+    }
+    unit->path_stats.misses++;
+
+    lvgl_raylib_vector_poly_t poly = { 0 };
+    lvgl_raylib_vector_tris_t tris = { 0 };
+    lvgl_raylib_draw_gpu_vector_flatten(&poly, path, tolerance);
+    if (stroke) {
+        lvgl_raylib_vector_poly_t dashed = { 0 };
+        if (s->dash_pattern.size > 0 && lvgl_raylib_draw_gpu_vector_dash(&dashed, &poly, &s->dash_pattern)) {
+            lvgl_raylib_draw_gpu_vector_poly_free(&poly);
+            poly = dashed;
+        }
+        lvgl_raylib_draw_gpu_vector_stroke_tris(&tris, &poly, s, tolerance);
+    } else {
+        lvgl_raylib_draw_gpu_vector_fill_tris(&tris, &poly);
+    }
+    lvgl_raylib_draw_gpu_vector_poly_free(&poly);
+
+    mesh = lv_ll_ins_head(&unit->paths);
+    size_t vertices_size = ((size_t)tris.pos_cnt + tris.neg_cnt) * sizeof(float);
+    float * vertices = lv_malloc(vertices_size + key_size + 1);
+    if (mesh == NULL || vertices == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate vector path mesh");
+        if (mesh != NULL) {
+            lv_ll_remove(&unit->paths, mesh);
+            lv_free(mesh);
+        }
+        lv_free(vertices);
+        lv_free(tris.pos);
+        lv_free(tris.neg);
+        return NULL;
+    }
+
+    if (tris.pos_cnt > 0) {
+        memcpy(vertices, tris.pos, tris.pos_cnt * sizeof(float));
+    }
+    if (tris.neg_cnt > 0) {
+        memcpy(vertices + tris.pos_cnt, tris.neg, tris.neg_cnt * sizeof(float));
+    }
+    lv_free(tris.pos);
+    lv_free(tris.neg);
+
+    mesh->hash = hash;
+    mesh->key = (uint8_t *)vertices + vertices_size;
+    mesh->key_size = (uint32_t)key_size;
+    for (uint32_t i = 0, offset = 0; i < parts_cnt; offset += (uint32_t)parts[i].size, i++) {
+        if (parts[i].size > 0) {
+            memcpy(mesh->key + offset, parts[i].data, parts[i].size);
+        }
+    }
+    mesh->vertices = vertices;
+    mesh->pos_cnt = tris.pos_cnt / 6;
+    mesh->neg_cnt = tris.neg_cnt / 6;
+    mesh->size = (uint32_t)sizeof(*mesh) + (uint32_t)(vertices_size + key_size);
+    mesh->quality = (uint8_t)path->quality;
+    mesh->last_used = lvgl_raylib_budget_touch();
+    mesh->min_x = mesh->min_y = INFINITY;
+    mesh->max_x = mesh->max_y = -INFINITY;
+    for (uint32_t i = 0; i < tris.pos_cnt + tris.neg_cnt; i += 2) {
+        mesh->min_x = LV_MIN(mesh->min_x, vertices[i]);
+        mesh->min_y = LV_MIN(mesh->min_y, vertices[i + 1]);
+        mesh->max_x = LV_MAX(mesh->max_x, vertices[i]);
+        mesh->max_y = LV_MAX(mesh->max_y, vertices[i + 1]);
+    }
+    unit->path_stats.entries++;
+    unit->path_stats.size += mesh->size;
+
+    lvgl_raylib_draw_gpu_vector_trim(unit);
+    return mesh;
+}
+
+static void lvgl_raylib_draw_gpu_vector_flatten(lvgl_raylib_vector_poly_t * poly, const lv_vector_path_t * path, float tolerance)
+{
+    const lv_fpoint_t * pts = (const lv_fpoint_t *)path->points.data;
+    uint32_t pt = 0;
+    float cur_x = 0, cur_y = 0;
+    bool open = false;
+
+    for (uint32_t i = 0; i < path->ops.size; i++) {
+        lv_vector_path_op_t op = *(lv_vector_path_op_t *)lv_array_at(&path->ops, i);
+        switch (op) {
+            case LV_VECTOR_PATH_OP_MOVE_TO:
+                lvgl_raylib_draw_gpu_vector_begin_sub(poly);
+                cur_x = pts[pt].x;
+                cur_y = pts[pt].y;
+                pt++;
+                lvgl_raylib_draw_gpu_vector_point(poly, cur_x, cur_y);
+                open = true;
+                break;
+            case LV_VECTOR_PATH_OP_LINE_TO:
+                if (!open) {
+                    lvgl_raylib_draw_gpu_vector_begin_sub(poly);
+                    lvgl_raylib_draw_gpu_vector_point(poly, cur_x, cur_y);
+                    open = true;
+                }
+                cur_x = pts[pt].x;
+                cur_y = pts[pt].y;
+                pt++;
+                lvgl_raylib_draw_gpu_vector_point(poly, cur_x, cur_y);
+                break;
+            case LV_VECTOR_PATH_OP_QUAD_TO:
+            case LV_VECTOR_PATH_OP_CUBIC_TO: {
+                if (!open) {
+                    lvgl_raylib_draw_gpu_vector_begin_sub(poly);
+                    lvgl_raylib_draw_gpu_vector_point(poly, cur_x, cur_y);
+                    open = true;
+                }
+                // Quadratics are raised to cubics, the segment count follows the
+                // control polygon's second difference
+                float x0 = cur_x, y0 = cur_y, x1, y1, x2, y2, x3, y3;
+                if (op == LV_VECTOR_PATH_OP_QUAD_TO) {
+                    x1 = x0 + 2.0f / 3.0f * (pts[pt].x - x0);
+                    y1 = y0 + 2.0f / 3.0f * (pts[pt].y - y0);
+                    x3 = pts[pt + 1].x;
+                    y3 = pts[pt + 1].y;
+                    x2 = x3 + 2.0f / 3.0f * (pts[pt].x - x3);
+                    y2 = y3 + 2.0f / 3.0f * (pts[pt].y - y3);
+                    pt += 2;
+                } else {
+                    x1 = pts[pt].x;
+                    y1 = pts[pt].y;
+                    x2 = pts[pt + 1].x;
+                    y2 = pts[pt + 1].y;
+                    x3 = pts[pt + 2].x;
+                    y3 = pts[pt + 2].y;
+                    pt += 3;
+                }
+                float ddx = LV_MAX(fabsf(x0 - 2 * x1 + x2), fabsf(x1 - 2 * x2 + x3));
+                float ddy = LV_MAX(fabsf(y0 - 2 * y1 + y2), fabsf(y1 - 2 * y2 + y3));
+                int32_t n = (int32_t)ceilf(sqrtf(0.75f * sqrtf(ddx * ddx + ddy * ddy) / tolerance));
+                n = LV_CLAMP(1, n, 128);
+                for (int32_t k = 1; k <= n; k++) {
+                    float t = (float)k / n;
+                    float u = 1.0f - t;
+                    float a = u * u * u, b = 3 * u * u * t, c = 3 * u * t * t, d = t * t * t;
+                    lvgl_raylib_draw_gpu_vector_point(poly, a * x0 + b * x1 + c * x2 + d * x3, a * y0 + b * y1 + c * y2 + d * y3);
+                }
+                cur_x = x3;
+                cur_y = y3;
+                break;
+            }
+            case LV_VECTOR_PATH_OP_CLOSE:
+                if (open && poly->subs_cnt > 0) {
+                    lvgl_raylib_vector_sub_t * sub = &poly->subs[poly->subs_cnt - 1];
+                    sub->closed = true;
+                    cur_x = poly->pts[sub->start * 2];
+                    cur_y = poly->pts[sub->start * 2 + 1];
+                }
+                open = false;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+static bool lvgl_raylib_draw_gpu_vector_dash(lvgl_raylib_vector_poly_t * dst, const lvgl_raylib_vector_poly_t * src, const lv_array_t * pattern)
+{
+    uint32_t cnt = pattern->size;
+    const float * dashes = (const float *)pattern->data;
+    float total = 0.0f;
+    for (uint32_t i = 0; i < cnt; i++) {
+        total += LV_MAX(dashes[i], 0.0f);
+    }
+    if (total <= 0.0f) {
+        return false;
+    }
+
+    // An odd pattern repeats twice, like SVG's stroke-dasharray
+    uint32_t period = cnt % 2 ? cnt * 2 : cnt;
+    for (uint32_t s = 0; s < src->subs_cnt; s++) {
+        const lvgl_raylib_vector_sub_t * sub = &src->subs[s];
+        uint32_t seg_cnt = sub->closed ? sub->cnt : sub->cnt - 1;
+        uint32_t dash = 0;
+        float left = LV_MAX(dashes[0], 0.0f);
+        bool on = true;
+        lvgl_raylib_draw_gpu_vector_begin_sub(dst);
+        lvgl_raylib_draw_gpu_vector_point(dst, src->pts[sub->start * 2], src->pts[sub->start * 2 + 1]);
+
+        for (uint32_t i = 0; i < seg_cnt; i++) {
+            const float * a = &src->pts[(sub->start + i) * 2];
+            const float * b = &src->pts[(sub->start + (i + 1) % sub->cnt) * 2];
+            float len = sqrtf((b[0] - a[0]) * (b[0] - a[0]) + (b[1] - a[1]) * (b[1] - a[1]));
+            float pos = 0.0f;
+            while (len - pos > left) {
+                pos += left;
+                float x = a[0] + (b[0] - a[0]) * pos / len;
+                float y = a[1] + (b[1] - a[1]) * pos / len;
+                if (on) {
+                    lvgl_raylib_draw_gpu_vector_point(dst, x, y);
+                } else {
+                    lvgl_raylib_draw_gpu_vector_begin_sub(dst);
+                    lvgl_raylib_draw_gpu_vector_point(dst, x, y);
+                }
+                on = !on;
+                dash = (dash + 1) % period;
+                left = LV_MAX(dashes[dash % cnt], 0.0f);
+            }
+            left -= len - pos;
+            if (on) {
+                lvgl_raylib_draw_gpu_vector_point(dst, b[0], b[1]);
+            }
+        }
+    }
+    return true;
+}
+
+static void lvgl_raylib_draw_gpu_vector_fill_tris(lvgl_raylib_vector_tris_t * tris, const lvgl_raylib_vector_poly_t * poly)
+{
+    // A fan from the first point of every subpath; overlapping triangles add up to the winding number
+    for (uint32_t s = 0; s < poly->subs_cnt; s++) {
+        const lvgl_raylib_vector_sub_t * sub = &poly->subs[s];
+        const float * p = &poly->pts[sub->start * 2];
+        for (uint32_t i = 1; i + 1 < sub->cnt; i++) {
+            lvgl_raylib_draw_gpu_vector_tri(tris, p[0], p[1], p[i * 2], p[i * 2 + 1], p[i * 2 + 2], p[i * 2 + 3], false);
+        }
+    }
+}
+
+static void lvgl_raylib_draw_gpu_vector_stroke_tris(lvgl_raylib_vector_tris_t * tris, const lvgl_raylib_vector_poly_t * poly,
+                                                    const lv_vector_stroke_dsc_t * stroke, float tolerance)
+{
+    // Segments, joins and caps all go in with the same orientation, so with the nonzero
+    // rule the overlaps simply merge
+    float hw = stroke->width / 2.0f;
+    for (uint32_t s = 0; s < poly->subs_cnt; s++) {
+        const lvgl_raylib_vector_sub_t * sub = &poly->subs[s];
+        const float * p = &poly->pts[sub->start * 2];
+        uint32_t n = sub->cnt;
+        if (n == 0) {
+            continue;
+        }
+        if (n == 1) {
+            if (stroke->cap == LV_VECTOR_STROKE_CAP_ROUND) {
+                lvgl_raylib_draw_gpu_vector_circle(tris, p[0], p[1], hw, tolerance);
+            } else if (stroke->cap == LV_VECTOR_STROKE_CAP_SQUARE) {
+                lvgl_raylib_draw_gpu_vector_tri(tris, p[0] - hw, p[1] - hw, p[0] + hw, p[1] - hw, p[0] + hw, p[1] + hw, true);
+                lvgl_raylib_draw_gpu_vector_tri(tris, p[0] - hw, p[1] - hw, p[0] + hw, p[1] + hw, p[0] - hw, p[1] + hw, true);
+            }
+            continue;
+        }
+
+        uint32_t seg_cnt = sub->closed ? n : n - 1;
+        for (uint32_t i = 0; i < seg_cnt; i++) {
+            float ax = p[i * 2], ay = p[i * 2 + 1];
+            float bx = p[((i + 1) % n) * 2], by = p[((i + 1) % n) * 2 + 1];
+            float len = sqrtf((bx - ax) * (bx - ax) + (by - ay) * (by - ay));
+            if (len <= 0.0f) {
+                continue;
+            }
+            float dx = (bx - ax) / len, dy = (by - ay) / len;
+            if (!sub->closed && stroke->cap == LV_VECTOR_STROKE_CAP_SQUARE) {
+                if (i == 0) {
+                    ax -= dx * hw;
+                    ay -= dy * hw;
+                }
+                if (i == seg_cnt - 1) {
+                    bx += dx * hw;
+                    by += dy * hw;
+                }
+            }
+            float nx = -dy * hw, ny = dx * hw;
+            lvgl_raylib_draw_gpu_vector_tri(tris, ax + nx, ay + ny, bx + nx, by + ny, bx - nx, by - ny, true);
+            lvgl_raylib_draw_gpu_vector_tri(tris, ax + nx, ay + ny, bx - nx, by - ny, ax - nx, ay - ny, true);
+        }
+
+        // Joins at the inner points, and at every point of a closed subpath
+        uint32_t first = sub->closed ? 0 : 1;
+        uint32_t last = sub->closed ? n : n - 1;
+        for (uint32_t i = first; i < last; i++) {
+            float vx = p[i * 2], vy = p[i * 2 + 1];
+            if (stroke->join == LV_VECTOR_STROKE_JOIN_ROUND) {
+                lvgl_raylib_draw_gpu_vector_circle(tris, vx, vy, hw, tolerance);
+                continue;
+            }
+            const float * a = &p[((i + n - 1) % n) * 2];
+            const float * b = &p[((i + 1) % n) * 2];
+            float l0 = sqrtf((vx - a[0]) * (vx - a[0]) + (vy - a[1]) * (vy - a[1]));
+            float l1 = sqrtf((b[0] - vx) * (b[0] - vx) + (b[1] - vy) * (b[1] - vy));
+            if (l0 <= 0.0f || l1 <= 0.0f) {
+                continue;
+            }
+            float n0x = -(vy - a[1]) / l0 * hw, n0y = (vx - a[0]) / l0 * hw;
+            float n1x = -(b[1] - vy) / l1 * hw, n1y = (b[0] - vx) / l1 * hw;
+
+            // Both sides get a bevel, the one on the inside of the turn is covered anyway
+            for (int side = -1; side <= 1; side += 2) {
+                float p0x = vx + side * n0x, p0y = vy + side * n0y;
+                float p1x = vx + side * n1x, p1y = vy + side * n1y;
+                lvgl_raylib_draw_gpu_vector_tri(tris, vx, vy, p0x, p0y, p1x, p1y, true);
+                if (stroke->join != LV_VECTOR_STROKE_JOIN_MITER) {
+                    continue;
+                }
+                float mx = n0x + n1x, my = n0y + n1y;
+                float ml = sqrtf(mx * mx + my * my);
+                if (ml <= 0.0f) {
+                    continue;
+                }
+                float cos_half = (mx * n0x + my * n0y) / (ml * hw);
+                if (cos_half <= 0.0f || 1.0f / cos_half > stroke->miter_limit) {
+                    continue;
+                }
+                float miter = hw / cos_half;
+                float tx = vx + side * mx / ml * miter, ty = vy + side * my / ml * miter;
+                lvgl_raylib_draw_gpu_vector_tri(tris, p0x, p0y, tx, ty, p1x, p1y, true);
+            }
+        }
+
+        if (!sub->closed && stroke->cap == LV_VECTOR_STROKE_CAP_ROUND) {
+            lvgl_raylib_draw_gpu_vector_circle(tris, p[0], p[1], hw, tolerance);
+            lvgl_raylib_draw_gpu_vector_circle(tris, p[(n - 1) * 2], p[(n - 1) * 2 + 1], hw, tolerance);
+        }
+    }
+}
+
+static void lvgl_raylib_draw_gpu_vector_circle(lvgl_raylib_vector_tris_t * tris, float x, float y, float r, float tolerance)
+{
+    int32_t n = r > tolerance ? (int32_t)ceilf(PI / acosf(1.0f - tolerance / r)) : 8;
+    n = LV_CLAMP(8, n, 64);
+    float px = x + r, py = y;
+    for (int32_t i = 1; i <= n; i++) {
+        float a = 2.0f * PI * i / n;
+        float qx = x + cosf(a) * r, qy = y + sinf(a) * r;
+        lvgl_raylib_draw_gpu_vector_tri(tris, x, y, px, py, qx, qy, true);
+        px = qx;
+        py = qy;
+    }
+}
+
+static void lvgl_raylib_draw_gpu_vector_tri(lvgl_raylib_vector_tris_t * tris, float x0, float y0, float x1, float y1, float x2, float y2, bool positive_only)
+{
+    float area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+    if (area == 0.0f) {
+        return;
+    }
+
+    bool negative = area < 0.0f && !positive_only;
+    float ** data = negative ? &tris->neg : &tris->pos;
+    uint32_t * cnt = negative ? &tris->neg_cnt : &tris->pos_cnt;
+    uint32_t * cap = negative ? &tris->neg_cap : &tris->pos_cap;
+    if (!lvgl_raylib_draw_gpu_vector_reserve((void **)data, cap, *cnt + 6, sizeof(float))) {
+        return;
+    }
+
+    float * v = *data + *cnt;
+    v[0] = x0;
+    v[1] = y0;
+    v[2] = x1;
+    v[3] = y1;
+    v[4] = x2;
+    v[5] = y2;
+    *cnt += 6;
+}
+
+static void lvgl_raylib_draw_gpu_vector_point(lvgl_raylib_vector_poly_t * poly, float x, float y)
+{
+    if (poly->subs_cnt == 0) {
+        lvgl_raylib_draw_gpu_vector_begin_sub(poly);
+    }
+
+    // Repeated points would give zero length segments
+    lvgl_raylib_vector_sub_t * sub = &poly->subs[poly->subs_cnt - 1];
+    if (sub->cnt > 0 && poly->pts[poly->pts_cnt * 2 - 2] == x && poly->pts[poly->pts_cnt * 2 - 1] == y) {
+        return;
+    }
+    if (!lvgl_raylib_draw_gpu_vector_reserve((void **)&poly->pts, &poly->pts_cap, (poly->pts_cnt + 1) * 2, sizeof(float))) {
+        return;
+    }
+    poly->pts[poly->pts_cnt * 2] = x;
+    poly->pts[poly->pts_cnt * 2 + 1] = y;
+    poly->pts_cnt++;
+    sub->cnt++;
+}
+
+static void lvgl_raylib_draw_gpu_vector_begin_sub(lvgl_raylib_vector_poly_t * poly)
+{
+    if (poly->subs_cnt > 0 && poly->subs[poly->subs_cnt - 1].cnt == 0) {
+        return;
+    }
+    if (!lvgl_raylib_draw_gpu_vector_reserve((void **)&poly->subs, &poly->subs_cap, poly->subs_cnt + 1, sizeof(lvgl_raylib_vector_sub_t))) {
+        return;
+    }
+    poly->subs[poly->subs_cnt].start = poly->pts_cnt;
+    poly->subs[poly->subs_cnt].cnt = 0;
+    poly->subs[poly->subs_cnt].closed = false;
+    poly->subs_cnt++;
+}
+
+static void lvgl_raylib_draw_gpu_vector_poly_free(lvgl_raylib_vector_poly_t * poly)
+{
+    lv_free(poly->pts);
+    lv_free(poly->subs);
+    memset(poly, 0, sizeof(*poly));
+}
+
+static bool lvgl_raylib_draw_gpu_vector_reserve(void ** data, uint32_t * cap, uint32_t need, size_t elem_size)
+{
+    if (need <= *cap) {
+        return true;
+    }
+
+    uint32_t new_cap = LV_MAX(need, *cap * 2);
+    new_cap = LV_MAX(new_cap, 64);
+    void * new_data = lv_realloc(*data, new_cap * elem_size);
+    if (new_data == NULL) {
+        TraceLog(LOG_ERROR, "Failed to grow vector tessellation buffer");
+        return false;
+    }
+    *data = new_data;
+    *cap = new_cap;
+    return true;
+}
+
+static void lvgl_raylib_draw_gpu_vector_transform(const lv_matrix_t * m, float x, float y, float * out_x, float * out_y)
+{
+    *out_x = m->m[0][0] * x + m->m[0][1] * y + m->m[0][2];
+    *out_y = m->m[1][0] * x + m->m[1][1] * y + m->m[1][2];
+}
+
+static bool lvgl_raylib_draw_gpu_vector_invert(const lv_matrix_t * m, float inv[6])
+{
+    // Affine only, vector paths don't use perspective
+    float det = m->m[0][0] * m->m[1][1] - m->m[0][1] * m->m[1][0];
+    if (det == 0.0f) {
+        return false;
+    }
+    inv[0] = m->m[1][1] / det;
+    inv[1] = -m->m[0][1] / det;
+    inv[2] = (m->m[0][1] * m->m[1][2] - m->m[1][1] * m->m[0][2]) / det;
+    inv[3] = -m->m[1][0] / det;
+    inv[4] = m->m[0][0] / det;
+    inv[5] = (m->m[1][0] * m->m[0][2] - m->m[0][0] * m->m[1][2]) / det;
+    return true;
+}
+
+static uint32_t lvgl_raylib_draw_gpu_vector_hash(uint32_t hash, const void * data, size_t size)
+{
+    // FNV-1a
+    const uint8_t * bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool lvgl_raylib_draw_gpu_vector_key_equal(const uint8_t * key, const lvgl_raylib_vector_key_part_t * parts, uint32_t parts_cnt)
+{
+    for (uint32_t i = 0; i < parts_cnt; i++) {
+        if (parts[i].size > 0 && memcmp(key, parts[i].data, parts[i].size) != 0) {
+            return false;
+        }
+        key += parts[i].size;
+    }
+    return true;
+}
+
+static void lvgl_raylib_draw_gpu_vector_trim(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    while (unit->path_stats.entries > LVGL_RAYLIB_DRAW_GPU_PATH_CACHE_CNT) {
+        lvgl_raylib_draw_gpu_vector_evict(unit, lvgl_raylib_draw_gpu_vector_oldest(unit));
+    }
+}
+
+#else /* LV_USE_VECTOR_GRAPHIC */
+
+bool lvgl_raylib_draw_gpu_vector_supported(const lv_draw_task_t * t)
+{
+    LV_UNUSED(t);
+    return false;
+}
+
+void lvgl_raylib_draw_gpu_vector_init(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    LV_UNUSED(unit);
+}
+
+void lvgl_raylib_draw_gpu_vector(lvgl_raylib_draw_gpu_unit_t * unit, lv_draw_task_t * t, lv_layer_t * layer)
+{
+    LV_UNUSED(unit);
+    LV_UNUSED(t);
+    LV_UNUSED(layer);
+}
+
+lvgl_raylib_draw_gpu_path_t * lvgl_raylib_draw_gpu_vector_oldest(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    LV_UNUSED(unit);
+    return NULL;
+}
+
+void lvgl_raylib_draw_gpu_vector_evict(lvgl_raylib_draw_gpu_unit_t * unit, lvgl_raylib_draw_gpu_path_t * mesh)
+{
+    LV_UNUSED(unit);
+    LV_UNUSED(mesh);
+}
+
+void lvgl_raylib_draw_gpu_vector_deinit(lvgl_raylib_draw_gpu_unit_t * unit)
+{
+    LV_UNUSED(unit);
+}
+
+#endif /* LV_USE_VECTOR_GRAPHIC */
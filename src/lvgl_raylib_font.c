@@ -0,0 +1,507 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_font.h"
+#include "lvgl_raylib_fs.h"
+#include "lvgl_raylib_budget.h"
+#include "lvgl_raylib_mem.h"
+
+// raylib rasterizes the glyphs but keeps the vertical metrics and kerning to itself,
+// a private copy of its stb_truetype reads those from the same font data
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_STATIC
+#include "external/stb_truetype.h"
+
+/* private types */
+
+/** A TTF file, loaded once and shared by every size created from it */
+typedef struct {
+    char * path;
+    const unsigned char * data;
+    int data_size;
+    unsigned char * loaded;     // read by raylib, NULL when the file is mapped
+    lv_fs_file_t file;          // kept open while mapped
+    stbtt_fontinfo info;
+    uint32_t ref_cnt;
+} lvgl_raylib_font_face_t;
+
+/** The lv_font_t descriptor of one size */
+typedef struct {
+    lvgl_raylib_font_face_t * face;
+    int32_t size;
+    float scale;
+    int32_t ascent;             // truncated the same way raylib offsets its glyphs
+} lvgl_raylib_font_dsc_t;
+
+/* private prototypes */
+
+static bool lvgl_raylib_font_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc, uint32_t letter, uint32_t letter_next);
+static const void * lvgl_raylib_font_get_glyph_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
+static void lvgl_raylib_font_release_glyph_cb(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc);
+static lvgl_raylib_font_face_t * lvgl_raylib_font_get_face(const char * path);
+static void lvgl_raylib_font_release_face(lvgl_raylib_font_face_t * face);
+static void lvgl_raylib_font_unload_face(lvgl_raylib_font_face_t * face);
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_get(const lv_font_t * font, uint32_t letter);
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_find(const lv_font_t * font, uint32_t letter);
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_rasterize(const lv_font_t * font, uint32_t letter);
+static void lvgl_raylib_font_remove(lvgl_raylib_font_glyph_t * glyph);
+static void lvgl_raylib_font_trim(uint32_t max_size);
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_oldest(void);
+static uint32_t lvgl_raylib_font_hash(const lv_font_t * font, uint32_t letter);
+static uint32_t lvgl_raylib_font_budget_size_cb(void);
+static bool lvgl_raylib_font_budget_oldest_cb(uint32_t * last_used);
+static void lvgl_raylib_font_budget_evict_cb(void);
+static void lvgl_raylib_font_lock(void);
+static void lvgl_raylib_font_unlock(void);
+
+/* static variables */
+
+static lv_ll_t _faces;
+static lv_ll_t _glyphs;
+static lvgl_raylib_font_glyph_t * _buckets[LVGL_RAYLIB_FONT_BUCKETS];
+static lvgl_raylib_font_stats_t _stats = {0};
+#if LV_USE_OS != LV_OS_NONE
+// Labels are measured on the main thread and drawn on the draw threads, both fill the cache
+static lv_mutex_t _mutex;
+#endif
+static lvgl_raylib_budget_cache_t _budget = {
+    .name = "TTF glyphs",
+    .cost = LVGL_RAYLIB_BUDGET_COST_RASTER,
+    .get_size_cb = &lvgl_raylib_font_budget_size_cb,
+    .get_oldest_cb = &lvgl_raylib_font_budget_oldest_cb,
+    .evict_oldest_cb = &lvgl_raylib_font_budget_evict_cb,
+};
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_font_init(void)
+{
+    lv_ll_init(&_faces, sizeof(lvgl_raylib_font_face_t));
+    lv_ll_init(&_glyphs, sizeof(lvgl_raylib_font_glyph_t));
+    memset(_buckets, 0, sizeof(_buckets));
+    _stats.max_size = LVGL_RAYLIB_FONT_CACHE_SIZE;
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&_mutex);
+#endif
+    lvgl_raylib_budget_register(&_budget);
+}
+
+lv_font_t * lvgl_raylib_font_create(const char * path, int32_t size)
+{
+    if (size <= 0) {
+        TraceLog(LOG_WARNING, "Invalid font size %d for %s", (int)size, path);
+        return NULL;
+    }
+
+    // Fonts and faces outlive the screen being built, they never come from its arena
+    lvgl_raylib_font_lock();
+    lvgl_raylib_mem_main_begin();
+    lvgl_raylib_font_face_t * face = lvgl_raylib_font_get_face(path);
+    lv_font_t * font = face != NULL ? lv_malloc_zeroed(sizeof(lv_font_t)) : NULL;
+    lvgl_raylib_font_dsc_t * dsc = face != NULL ? lv_malloc_zeroed(sizeof(lvgl_raylib_font_dsc_t)) : NULL;
+    lvgl_raylib_mem_main_end();
+    if (face != NULL && (font == NULL || dsc == NULL)) {
+        TraceLog(LOG_ERROR, "Failed to allocate font %s", path);
+        lv_free(font);
+        lv_free(dsc);
+        lvgl_raylib_font_release_face(face);
+        face = NULL;
+    }
+    lvgl_raylib_font_unlock();
+    if (face == NULL) {
+        return NULL;
+    }
+
+    // Same scale as raylib's LoadFontData, so its glyphs line up with these metrics
+    int ascent, descent, line_gap;
+    stbtt_GetFontVMetrics(&face->info, &ascent, &descent, &line_gap);
+    dsc->face = face;
+    dsc->size = size;
+    dsc->scale = stbtt_ScaleForPixelHeight(&face->info, (float)size);
+    dsc->ascent = (int32_t)((float)ascent * dsc->scale);
+
+    font->get_glyph_dsc = &lvgl_raylib_font_get_glyph_dsc_cb;
+    font->get_glyph_bitmap = &lvgl_raylib_font_get_glyph_bitmap_cb;
+    font->release_glyph = &lvgl_raylib_font_release_glyph_cb;
+    font->line_height = (int32_t)((float)(ascent - descent + line_gap) * dsc->scale + 0.5f);
+    font->base_line = (int32_t)((float)-descent * dsc->scale + 0.5f);
+    font->subpx = LV_FONT_SUBPX_NONE;
+    font->kerning = LV_FONT_KERNING_NORMAL;
+    font->underline_position = (int8_t)-(font->base_line / 2);
+    font->underline_thickness = (int8_t)LV_MAX(1, size / 14);
+    font->dsc = dsc;
+    return font;
+}
+
+void lvgl_raylib_font_delete(lv_font_t * font)
+{
+    if (font == NULL || font->get_glyph_dsc != &lvgl_raylib_font_get_glyph_dsc_cb) {
+        return;
+    }
+
+    lvgl_raylib_font_lock();
+    lvgl_raylib_font_glyph_t * glyph = lv_ll_get_head(&_glyphs);
+    while (glyph != NULL) {
+        lvgl_raylib_font_glyph_t * next = lv_ll_get_next(&_glyphs, glyph);
+        if (glyph->font == font) {
+            lvgl_raylib_font_remove(glyph);
+        }
+        glyph = next;
+    }
+
+    lvgl_raylib_font_dsc_t * dsc = (lvgl_raylib_font_dsc_t *)font->dsc;
+    lvgl_raylib_font_release_face(dsc->face);
+    lvgl_raylib_font_unlock();
+    lvgl_raylib_draw_gpu_font_drop(font);
+    lv_free(dsc);
+    lv_free(font);
+}
+
+void lvgl_raylib_font_set_cache_size(uint32_t max_size)
+{
+    lvgl_raylib_font_lock();
+    _stats.max_size = max_size;
+    lvgl_raylib_font_trim(max_size);
+    lvgl_raylib_font_unlock();
+}
+
+void lvgl_raylib_font_get_stats(lvgl_raylib_font_stats_t * stats)
+{
+    lvgl_raylib_font_lock();
+    *stats = _stats;
+    lvgl_raylib_font_unlock();
+}
+
+void lvgl_raylib_font_deinit(void)
+{
+    lvgl_raylib_budget_unregister(&_budget);
+    lvgl_raylib_font_glyph_t * glyph = lv_ll_get_head(&_glyphs);
+    while (glyph != NULL) {
+        lvgl_raylib_font_glyph_t * next = lv_ll_get_next(&_glyphs, glyph);
+        lvgl_raylib_font_remove(glyph);
+        glyph = next;
+    }
+
+    // Fonts still alive keep pointing at their faces, they are the application's to delete
+    lvgl_raylib_font_face_t * face = lv_ll_get_head(&_faces);
+    while (face != NULL) {
+        lvgl_raylib_font_face_t * next = lv_ll_get_next(&_faces, face);
+        lvgl_raylib_font_unload_face(face);
+        face = next;
+    }
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_delete(&_mutex);
+#endif
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool lvgl_raylib_font_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc, uint32_t letter, uint32_t letter_next)
+{
+    lvgl_raylib_font_dsc_t * font_dsc = (lvgl_raylib_font_dsc_t *)font->dsc;
+
+    // Missing glyphs fail so LVGL tries the fallback font
+    if (stbtt_FindGlyphIndex(&font_dsc->face->info, (int)letter) == 0) {
+        return false;
+    }
+
+    // Copied under the lock, another thread may evict the glyph right after
+    lvgl_raylib_font_lock();
+    lvgl_raylib_font_glyph_t * glyph = lvgl_raylib_font_get(font, letter);
+    if (glyph == NULL) {
+        lvgl_raylib_font_unlock();
+        return false;
+    }
+    dsc->adv_w = glyph->adv_w;
+    dsc->box_w = glyph->box_w;
+    dsc->box_h = glyph->box_h;
+    dsc->ofs_x = glyph->ofs_x;
+    dsc->ofs_y = glyph->ofs_y;
+    lvgl_raylib_font_unlock();
+
+    if (letter_next != 0 && font->kerning != LV_FONT_KERNING_NONE) {
+        float k = (float)stbtt_GetCodepointKernAdvance(&font_dsc->face->info, (int)letter, (int)letter_next) * font_dsc->scale;
+        dsc->adv_w += (int32_t)(k < 0.0f ? k - 0.5f : k + 0.5f);
+    }
+    dsc->format = LV_FONT_GLYPH_FORMAT_A8;
+    dsc->is_placeholder = false;
+    dsc->gid.index = letter;
+    return true;
+}
+
+static const void * lvgl_raylib_font_get_glyph_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    LV_UNUSED(draw_buf);
+
+    // Normally a hit, the descriptor was just looked up; a glyph evicted meanwhile is redone
+    lvgl_raylib_font_lock();
+    lvgl_raylib_font_glyph_t * glyph = lvgl_raylib_font_get(g_dsc->resolved_font, g_dsc->gid.index);
+    if (glyph == NULL || glyph->bitmap == NULL) {
+        lvgl_raylib_font_unlock();
+        return NULL;
+    }
+
+    // Pinned until release_glyph so drawing never reads an evicted bitmap
+    glyph->ref_cnt++;
+    lvgl_raylib_font_unlock();
+    return glyph->bitmap;
+}
+
+static void lvgl_raylib_font_release_glyph_cb(const lv_font_t * font, lv_font_glyph_dsc_t * g_dsc)
+{
+    lvgl_raylib_font_lock();
+    lvgl_raylib_font_glyph_t * glyph = lvgl_raylib_font_find(font, g_dsc->gid.index);
+    if (glyph != NULL && glyph->ref_cnt > 0) {
+        glyph->ref_cnt--;
+    }
+    lvgl_raylib_font_unlock();
+}
+
+static lvgl_raylib_font_face_t * lvgl_raylib_font_get_face(const char * path)
+{
+    lvgl_raylib_font_face_t * face;
+    LV_LL_READ(&_faces, face) {
+        if (strcmp(face->path, path) == 0) {
+            face->ref_cnt++;
+            return face;
+        }
+    }
+
+    face = lv_ll_ins_tail(&_faces);
+    if (face == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate font face %s", path);
+        return NULL;
+    }
+    memset(face, 0, sizeof(*face));
+
+    // Fonts on the mapped drive are used in place, anything else is loaded by raylib
+    uint32_t size = 0;
+    if (lv_fs_open(&face->file, path, LV_FS_MODE_RD) == LV_FS_RES_OK) {
+        face->data = lvgl_raylib_fs_get_data(&face->file, &size);
+        face->data_size = (int)size;
+        if (face->data == NULL) {
+            lv_fs_close(&face->file);
+        }
+    }
+    if (face->data == NULL) {
+        face->loaded = LoadFileData(path, &face->data_size);
+        face->data = face->loaded;
+    }
+    if (face->data == NULL || !stbtt_InitFont(&face->info, face->data, stbtt_GetFontOffsetForIndex(face->data, 0))) {
+        TraceLog(LOG_WARNING, "Failed to load font %s", path);
+        lvgl_raylib_font_unload_face(face);
+        return NULL;
+    }
+    face->path = lv_strdup(path);
+    face->ref_cnt = 1;
+    return face;
+}
+
+static void lvgl_raylib_font_release_face(lvgl_raylib_font_face_t * face)
+{
+    if (face->ref_cnt > 1) {
+        face->ref_cnt--;
+        return;
+    }
+    lvgl_raylib_font_unload_face(face);
+}
+
+static void lvgl_raylib_font_unload_face(lvgl_raylib_font_face_t * face)
+{
+    if (face->loaded != NULL) {
+        UnloadFileData(face->loaded);
+    } else if (face->data != NULL) {
+        lv_fs_close(&face->file);
+    }
+    lv_free(face->path);
+    lv_ll_remove(&_faces, face);
+    lv_free(face);
+}
+
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_get(const lv_font_t * font, uint32_t letter)
+{
+    lvgl_raylib_font_glyph_t * glyph = lvgl_raylib_font_find(font, letter);
+    if (glyph != NULL) {
+        _stats.hits++;
+        glyph->last_used = lvgl_raylib_budget_touch();
+        lvgl_raylib_font_glyph_t * head = lv_ll_get_head(&_glyphs);
+        if (glyph != head) {
+            lv_ll_move_before(&_glyphs, glyph, head);
+        }
+        return glyph;
+    }
+    _stats.misses++;
+
+    // Labels measure their text while a screen is built, the cache is not part of it
+    double start = GetTime();
+    lvgl_raylib_mem_main_begin();
+    glyph = lvgl_raylib_font_rasterize(font, letter);
+    lvgl_raylib_mem_main_end();
+    if (glyph != NULL) {
+        _stats.raster_ms_last = (float)((GetTime() - start) * 1000.0);
+        _stats.raster_ms_total += _stats.raster_ms_last;
+    }
+    return glyph;
+}
+
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_find(const lv_font_t * font, uint32_t letter)
+{
+    lvgl_raylib_font_glyph_t * glyph = _buckets[lvgl_raylib_font_hash(font, letter)];
+    while (glyph != NULL && (glyph->font != font || glyph->letter != letter)) {
+        glyph = glyph->next;
+    }
+    return glyph;
+}
+
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_rasterize(const lv_font_t * font, uint32_t letter)
+{
+    lvgl_raylib_font_dsc_t * dsc = (lvgl_raylib_font_dsc_t *)font->dsc;
+    int codepoint = (int)letter;
+    GlyphInfo * info = LoadFontData(dsc->face->data, dsc->face->data_size, dsc->size, &codepoint, 1, FONT_DEFAULT);
+    if (info == NULL) {
+        return NULL;
+    }
+
+    // raylib measures from the top of the line, LVGL from the baseline up to the bottom
+    int32_t box_w = letter == ' ' ? 0 : info->image.width;
+    int32_t box_h = letter == ' ' ? 0 : info->image.height;
+    lv_draw_buf_t * bitmap = NULL;
+    if (box_w > 0 && box_h > 0 && info->image.data != NULL) {
+        bitmap = lv_draw_buf_create((uint32_t)box_w, (uint32_t)box_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+        if (bitmap == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate %dx%d glyph", (int)box_w, (int)box_h);
+            UnloadFontData(info, 1);
+            return NULL;
+        }
+        for (int32_t y = 0; y < box_h; y++) {
+            memcpy(bitmap->data + y * bitmap->header.stride, (const uint8_t *)info->image.data + y * box_w, (size_t)box_w);
+        }
+    }
+
+    uint32_t size = sizeof(lvgl_raylib_font_glyph_t) + (bitmap != NULL ? bitmap->data_size : 0);
+    lvgl_raylib_font_trim(size < _stats.max_size ? _stats.max_size - size : 0);
+
+    lvgl_raylib_font_glyph_t * glyph = lv_ll_ins_head(&_glyphs);
+    if (glyph == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate glyph cache entry");
+        if (bitmap != NULL) {
+            lv_draw_buf_destroy(bitmap);
+        }
+        UnloadFontData(info, 1);
+        return NULL;
+    }
+    glyph->font = font;
+    glyph->letter = letter;
+    glyph->adv_w = info->advanceX;
+    glyph->ofs_x = info->offsetX;
+    glyph->ofs_y = -(info->offsetY - dsc->ascent + box_h);
+    glyph->box_w = box_w;
+    glyph->box_h = box_h;
+    glyph->bitmap = bitmap;
+    glyph->size = size;
+    glyph->ref_cnt = 0;
+    glyph->last_used = lvgl_raylib_budget_touch();
+    UnloadFontData(info, 1);
+
+    uint32_t bucket = lvgl_raylib_font_hash(font, letter);
+    glyph->next = _buckets[bucket];
+    _buckets[bucket] = glyph;
+    _stats.glyphs++;
+    _stats.size += size;
+    return glyph;
+}
+
+static void lvgl_raylib_font_remove(lvgl_raylib_font_glyph_t * glyph)
+{
+    lvgl_raylib_font_glyph_t ** link = &_buckets[lvgl_raylib_font_hash(glyph->font, glyph->letter)];
+    while (*link != NULL && *link != glyph) {
+        link = &(*link)->next;
+    }
+    if (*link == glyph) {
+        *link = glyph->next;
+    }
+
+    _stats.glyphs--;
+    _stats.size -= glyph->size;
+    if (glyph->bitmap != NULL) {
+        lv_draw_buf_destroy(glyph->bitmap);
+    }
+    lv_ll_remove(&_glyphs, glyph);
+    lv_free(glyph);
+}
+
+static void lvgl_raylib_font_trim(uint32_t max_size)
+{
+    // From the least recently used end, glyphs being drawn stay
+    lvgl_raylib_font_glyph_t * glyph = lv_ll_get_tail(&_glyphs);
+    while (glyph != NULL && _stats.size > max_size) {
+        lvgl_raylib_font_glyph_t * prev = lv_ll_get_prev(&_glyphs, glyph);
+        if (glyph->ref_cnt == 0) {
+            lvgl_raylib_font_remove(glyph);
+            _stats.evictions++;
+        }
+        glyph = prev;
+    }
+}
+
+static lvgl_raylib_font_glyph_t * lvgl_raylib_font_oldest(void)
+{
+    lvgl_raylib_font_glyph_t * glyph = lv_ll_get_tail(&_glyphs);
+    while (glyph != NULL && glyph->ref_cnt > 0) {
+        glyph = lv_ll_get_prev(&_glyphs, glyph);
+    }
+    return glyph;
+}
+
+static uint32_t lvgl_raylib_font_hash(const lv_font_t * font, uint32_t letter)
+{
+    uintptr_t key = (uintptr_t)font ^ ((uintptr_t)letter * 2654435761u);
+    return (uint32_t)((key ^ (key >> 15)) % LVGL_RAYLIB_FONT_BUCKETS);
+}
+
+static uint32_t lvgl_raylib_font_budget_size_cb(void)
+{
+    lvgl_raylib_font_lock();
+    uint32_t size = _stats.size;
+    lvgl_raylib_font_unlock();
+    return size;
+}
+
+static bool lvgl_raylib_font_budget_oldest_cb(uint32_t * last_used)
+{
+    lvgl_raylib_font_lock();
+    lvgl_raylib_font_glyph_t * oldest = lvgl_raylib_font_oldest();
+    if (oldest != NULL) {
+        *last_used = oldest->last_used;
+    }
+    lvgl_raylib_font_unlock();
+    return oldest != NULL;
+}
+
+static void lvgl_raylib_font_budget_evict_cb(void)
+{
+    lvgl_raylib_font_lock();
+    lvgl_raylib_font_glyph_t * oldest = lvgl_raylib_font_oldest();
+    if (oldest != NULL) {
+        lvgl_raylib_font_remove(oldest);
+        _stats.evictions++;
+    }
+    lvgl_raylib_font_unlock();
+}
+
+static void lvgl_raylib_font_lock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_lock(&_mutex);
+#endif
+}
+
+static void lvgl_raylib_font_unlock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_unlock(&_mutex);
+#endif
+}
@@ -0,0 +1,41 @@
+#ifndef LVGL_RAYLIB_FONT_H
+#define LVGL_RAYLIB_FONT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Default budget of rasterized glyphs in bytes, shared by every font and size */
+#define LVGL_RAYLIB_FONT_CACHE_SIZE (1024 * 1024)
+
+/** Hash buckets of the glyph cache */
+#define LVGL_RAYLIB_FONT_BUCKETS 1024
+
+/* public types */
+
+/** A rasterized glyph, also a node of the LRU list, most recent first */
+typedef struct lvgl_raylib_font_glyph {
+    struct lvgl_raylib_font_glyph * next;   // bucket chain
+    const lv_font_t * font;
+    uint32_t letter;
+    int32_t adv_w;
+    int32_t ofs_x;
+    int32_t ofs_y;
+    int32_t box_w;
+    int32_t box_h;
+    lv_draw_buf_t * bitmap;                 // A8, NULL for blank glyphs
+    uint32_t size;
+    uint32_t ref_cnt;                       // bitmaps handed out and not released yet
+    uint32_t last_used;
+} lvgl_raylib_font_glyph_t;
+
+/* public functions */
+
+void lvgl_raylib_font_init(void);
+void lvgl_raylib_font_deinit(void);
+
+#endif
@@ -0,0 +1,321 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_fs.h"
+#include "lvgl_raylib_mem.h"
+
+/* private prototypes */
+
+static void * lvgl_raylib_fs_open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t lvgl_raylib_fs_close_cb(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t lvgl_raylib_fs_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t lvgl_raylib_fs_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
+static lv_fs_res_t lvgl_raylib_fs_tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lvgl_raylib_fs_mapping_t * lvgl_raylib_fs_acquire(const char * path);
+static bool lvgl_raylib_fs_map(lvgl_raylib_fs_mapping_t * mapping);
+static void lvgl_raylib_fs_unmap(lvgl_raylib_fs_mapping_t * mapping);
+static void lvgl_raylib_fs_remove(lvgl_raylib_fs_mapping_t * mapping);
+static void lvgl_raylib_fs_trim(void);
+static void lvgl_raylib_fs_lock(void);
+static void lvgl_raylib_fs_unlock(void);
+
+/* static variables */
+
+static lv_fs_drv_t _drv;
+static lv_ll_t _mappings;
+static uint32_t _use_counter = 0;
+static lvgl_raylib_fs_stats_t _stats = {0};
+#if LV_USE_OS != LV_OS_NONE
+// Images are also decoded on the loader thread
+static lv_mutex_t _mutex;
+#endif
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_fs_init(void)
+{
+    lv_ll_init(&_mappings, sizeof(lvgl_raylib_fs_mapping_t));
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&_mutex);
+#endif
+
+    // Every read is a memcpy from the mapping, LVGL's own read cache would only add one
+    lv_fs_drv_init(&_drv);
+    _drv.letter = LVGL_RAYLIB_FS_LETTER;
+    _drv.cache_size = 0;
+    _drv.open_cb = &lvgl_raylib_fs_open_cb;
+    _drv.close_cb = &lvgl_raylib_fs_close_cb;
+    _drv.read_cb = &lvgl_raylib_fs_read_cb;
+    _drv.seek_cb = &lvgl_raylib_fs_seek_cb;
+    _drv.tell_cb = &lvgl_raylib_fs_tell_cb;
+    lv_fs_drv_register(&_drv);
+}
+
+const void * lvgl_raylib_fs_get_data(lv_fs_file_t * file, uint32_t * size)
+{
+    if (file == NULL || file->drv != &_drv || file->file_d == NULL) {
+        return NULL;
+    }
+
+    // Valid until the file is closed
+    lvgl_raylib_fs_file_t * handle = file->file_d;
+    *size = handle->mapping->size;
+    return handle->mapping->data;
+}
+
+void lvgl_raylib_fs_get_stats(lvgl_raylib_fs_stats_t * stats)
+{
+    lvgl_raylib_fs_lock();
+    *stats = _stats;
+    lvgl_raylib_fs_unlock();
+}
+
+void lvgl_raylib_fs_deinit(void)
+{
+    lvgl_raylib_fs_mapping_t * mapping = lv_ll_get_head(&_mappings);
+    while (mapping != NULL) {
+        lvgl_raylib_fs_mapping_t * next = lv_ll_get_next(&_mappings, mapping);
+        lvgl_raylib_fs_remove(mapping);
+        mapping = next;
+    }
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_delete(&_mutex);
+#endif
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static void * lvgl_raylib_fs_open_cb(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    if (mode != LV_FS_MODE_RD) {
+        return NULL;
+    }
+
+    // Open files, e.g. of fonts, and the mappings outlive the screen being built
+    lvgl_raylib_mem_main_begin();
+    lvgl_raylib_fs_file_t * handle = lv_malloc(sizeof(lvgl_raylib_fs_file_t));
+    if (handle == NULL) {
+        lvgl_raylib_mem_main_end();
+        return NULL;
+    }
+
+    double start = GetTime();
+    lvgl_raylib_fs_lock();
+    handle->mapping = lvgl_raylib_fs_acquire(path);
+    lvgl_raylib_mem_main_end();
+    handle->pos = 0;
+    if (handle->mapping != NULL) {
+        _stats.opens++;
+        _stats.open_ms_last = (float)((GetTime() - start) * 1000.0);
+        _stats.open_ms_total += _stats.open_ms_last;
+    }
+    lvgl_raylib_fs_unlock();
+
+    if (handle->mapping == NULL) {
+        lv_free(handle);
+        return NULL;
+    }
+    return handle;
+}
+
+static lv_fs_res_t lvgl_raylib_fs_close_cb(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    lvgl_raylib_fs_file_t * handle = file_p;
+    lvgl_raylib_fs_lock();
+    handle->mapping->ref_cnt--;
+    lvgl_raylib_fs_trim();
+    lvgl_raylib_fs_unlock();
+    lv_free(handle);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t lvgl_raylib_fs_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    lvgl_raylib_fs_file_t * handle = file_p;
+    uint32_t size = handle->mapping->size;
+    uint32_t n = handle->pos < size ? LV_MIN(btr, size - handle->pos) : 0;
+    if (n > 0) {
+        memcpy(buf, handle->mapping->data + handle->pos, n);
+        handle->pos += n;
+    }
+    *br = n;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t lvgl_raylib_fs_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    lvgl_raylib_fs_file_t * handle = file_p;
+    switch (whence) {
+        case LV_FS_SEEK_SET:
+            handle->pos = pos;
+            break;
+        case LV_FS_SEEK_CUR:
+            handle->pos += pos;
+            break;
+        case LV_FS_SEEK_END:
+            handle->pos = handle->mapping->size + pos;
+            break;
+        default:
+            return LV_FS_RES_INV_PARAM;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t lvgl_raylib_fs_tell_cb(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    lvgl_raylib_fs_file_t * handle = file_p;
+    *pos_p = handle->pos;
+    return LV_FS_RES_OK;
+}
+
+static lvgl_raylib_fs_mapping_t * lvgl_raylib_fs_acquire(const char * path)
+{
+    lvgl_raylib_fs_mapping_t * mapping;
+    LV_LL_READ(&_mappings, mapping) {
+        if (strcmp(mapping->path, path) == 0) {
+            break;
+        }
+    }
+
+    // Idle mappings may be stale, ones in use are served as they are
+    if (mapping != NULL && mapping->ref_cnt == 0 && GetFileModTime(path) != mapping->mod_time) {
+        lvgl_raylib_fs_remove(mapping);
+        mapping = NULL;
+    }
+
+    if (mapping != NULL) {
+        _stats.map_hits++;
+    } else {
+        mapping = lv_ll_ins_head(&_mappings);
+        if (mapping == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate file mapping entry");
+            return NULL;
+        }
+        memset(mapping, 0, sizeof(*mapping));
+        mapping->path = lv_strdup(path);
+        if (mapping->path == NULL || !lvgl_raylib_fs_map(mapping)) {
+            lv_free(mapping->path);
+            lv_ll_remove(&_mappings, mapping);
+            lv_free(mapping);
+            return NULL;
+        }
+        _stats.map_misses++;
+        _stats.mappings++;
+        _stats.mapped_size += mapping->size;
+    }
+
+    mapping->ref_cnt++;
+    mapping->last_used = ++_use_counter;
+    return mapping;
+}
+
+static bool lvgl_raylib_fs_map(lvgl_raylib_fs_mapping_t * mapping)
+{
+    mapping->mod_time = GetFileModTime(mapping->path);
+#if defined(_WIN32)
+    // No mmap, the file is read once and the copy shared instead
+    int size = 0;
+    mapping->data = LoadFileData(mapping->path, &size);
+    mapping->size = (uint32_t)size;
+    return mapping->data != NULL || FileExists(mapping->path);
+#else
+    int fd = open(mapping->path, O_RDONLY);
+    if (fd < 0) {
+        TraceLog(LOG_WARNING, "Failed to open %s for mapping", mapping->path);
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size > (off_t)UINT32_MAX) {
+        TraceLog(LOG_WARNING, "Failed to map %s", mapping->path);
+        close(fd);
+        return false;
+    }
+    mapping->size = (uint32_t)st.st_size;
+    mapping->data = NULL;
+    if (mapping->size > 0) {
+        void * data = mmap(NULL, mapping->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            TraceLog(LOG_WARNING, "Failed to map %s", mapping->path);
+            close(fd);
+            return false;
+        }
+        mapping->data = data;
+    }
+    // The mapping outlives the descriptor
+    close(fd);
+    return true;
+#endif
+}
+
+static void lvgl_raylib_fs_unmap(lvgl_raylib_fs_mapping_t * mapping)
+{
+    if (mapping->data == NULL) {
+        return;
+    }
+#if defined(_WIN32)
+    UnloadFileData(mapping->data);
+#else
+    munmap(mapping->data, mapping->size);
+#endif
+    mapping->data = NULL;
+}
+
+static void lvgl_raylib_fs_remove(lvgl_raylib_fs_mapping_t * mapping)
+{
+    _stats.mappings--;
+    _stats.mapped_size -= mapping->size;
+    lvgl_raylib_fs_unmap(mapping);
+    lv_free(mapping->path);
+    lv_ll_remove(&_mappings, mapping);
+    lv_free(mapping);
+}
+
+static void lvgl_raylib_fs_trim(void)
+{
+    // Unused mappings cost address space only, a few are kept for files opened again soon
+    while (true) {
+        uint32_t idle = 0;
+        lvgl_raylib_fs_mapping_t * oldest = NULL;
+        lvgl_raylib_fs_mapping_t * mapping;
+        LV_LL_READ(&_mappings, mapping) {
+            if (mapping->ref_cnt == 0) {
+                idle++;
+                if (oldest == NULL || mapping->last_used < oldest->last_used) {
+                    oldest = mapping;
+                }
+            }
+        }
+        if (idle <= LVGL_RAYLIB_FS_IDLE_CNT) {
+            break;
+        }
+        lvgl_raylib_fs_remove(oldest);
+    }
+}
+
+static void lvgl_raylib_fs_lock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_lock(&_mutex);
+#endif
+}
+
+static void lvgl_raylib_fs_unlock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_unlock(&_mutex);
+#endif
+}
@@ -0,0 +1,38 @@
+#ifndef LVGL_RAYLIB_FS_H
+#define LVGL_RAYLIB_FS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Unused mappings kept around, LVGL opens a file once for its header and again to decode */
+#define LVGL_RAYLIB_FS_IDLE_CNT 16
+
+/* public types */
+
+/** A file mapped once and shared by every open handle */
+typedef struct {
+    char * path;
+    uint8_t * data;             // NULL for empty files
+    uint32_t size;
+    long mod_time;              // a changed file is mapped again once unused
+    uint32_t ref_cnt;
+    uint32_t last_used;
+} lvgl_raylib_fs_mapping_t;
+
+/** What lv_fs_file_t::file_d points to */
+typedef struct {
+    lvgl_raylib_fs_mapping_t * mapping;
+    uint32_t pos;
+} lvgl_raylib_fs_file_t;
+
+/* public functions */
+
+void lvgl_raylib_fs_init(void);
+void lvgl_raylib_fs_deinit(void);
+
+#endif
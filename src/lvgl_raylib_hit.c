@@ -0,0 +1,570 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_hit.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_HIT_EMPTY UINT32_MAX
+
+/* private prototypes */
+
+static lvgl_raylib_hit_index_t * lvgl_raylib_hit_find(const lv_obj_t * obj);
+static lv_obj_t * lvgl_raylib_hit_search_obj(lv_obj_t * obj, lv_point_t * point);
+static lv_obj_t * lvgl_raylib_hit_query(lvgl_raylib_hit_index_t * index, lv_point_t * point);
+static void lvgl_raylib_hit_narrow_index(lvgl_raylib_hit_index_t * index, lv_obj_t * found);
+static void lvgl_raylib_hit_rebuild(lvgl_raylib_hit_index_t * index);
+static void lvgl_raylib_hit_free(lvgl_raylib_hit_index_t * index);
+static void lvgl_raylib_hit_measure(lvgl_raylib_hit_index_t * index, lv_obj_t * child, lvgl_raylib_hit_entry_t * entry);
+static bool lvgl_raylib_hit_cell_range(const lvgl_raylib_hit_index_t * index, const lv_area_t * area,
+                                       int32_t * col1, int32_t * row1, int32_t * col2, int32_t * row2);
+static void lvgl_raylib_hit_link(lvgl_raylib_hit_index_t * index, uint32_t entry_idx);
+static void lvgl_raylib_hit_unlink(lvgl_raylib_hit_index_t * index, uint32_t entry_idx);
+static bool lvgl_raylib_hit_list_add(lvgl_raylib_hit_list_t * list, uint32_t item);
+static void lvgl_raylib_hit_list_remove(lvgl_raylib_hit_list_t * list, uint32_t item);
+static uint32_t lvgl_raylib_hit_slot(const lvgl_raylib_hit_index_t * index, const lv_obj_t * obj);
+static void lvgl_raylib_hit_child_changed_cb(lv_event_t * e);
+static void lvgl_raylib_hit_children_cb(lv_event_t * e);
+static void lvgl_raylib_hit_delete_cb(lv_event_t * e);
+
+/* static variables */
+
+static lv_ll_t _indexes;
+static lvgl_raylib_hit_stats_t _stats;
+static bool _narrowing = false;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_hit_init(void)
+{
+    lv_ll_init(&_indexes, sizeof(lvgl_raylib_hit_index_t));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void lvgl_raylib_hit_index(lv_obj_t * obj, int32_t cell_size)
+{
+    if (cell_size <= 0) {
+        cell_size = LVGL_RAYLIB_HIT_CELL_SIZE;
+    }
+
+    // Indexing again picks up changes no event reports, like a child's transform
+    lvgl_raylib_hit_index_t * index = lvgl_raylib_hit_find(obj);
+    if (index != NULL) {
+        index->cell_size = cell_size;
+        index->dirty = true;
+        return;
+    }
+
+    index = lv_ll_ins_tail(&_indexes);
+    if (index == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate hit-test index");
+        return;
+    }
+
+    memset(index, 0, sizeof(*index));
+    index->obj = obj;
+    index->cell_size = cell_size;
+    index->dirty = true;
+    lv_obj_add_event_cb(obj, &lvgl_raylib_hit_child_changed_cb, LV_EVENT_CHILD_CHANGED, NULL);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_hit_children_cb, LV_EVENT_CHILD_CREATED, NULL);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_hit_children_cb, LV_EVENT_CHILD_DELETED, NULL);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_hit_delete_cb, LV_EVENT_DELETE, NULL);
+}
+
+void lvgl_raylib_hit_unindex(lv_obj_t * obj)
+{
+    lvgl_raylib_hit_index_t * index = lvgl_raylib_hit_find(obj);
+    if (index == NULL) {
+        return;
+    }
+
+    lv_obj_remove_event_cb_with_user_data(obj, &lvgl_raylib_hit_child_changed_cb, NULL);
+    lv_obj_remove_event_cb_with_user_data(obj, &lvgl_raylib_hit_children_cb, NULL);
+    lv_obj_remove_event_cb_with_user_data(obj, &lvgl_raylib_hit_delete_cb, NULL);
+    lvgl_raylib_hit_free(index);
+    lv_ll_remove(&_indexes, index);
+    lv_free(index);
+}
+
+bool lvgl_raylib_hit_is_active(void)
+{
+    return !lv_ll_is_empty(&_indexes);
+}
+
+lv_obj_t * lvgl_raylib_hit_search(lv_obj_t * obj, const lv_point_t * point)
+{
+    lv_point_t p = *point;
+    if (!lvgl_raylib_hit_is_active()) {
+        return lv_indev_search_obj(obj, &p);
+    }
+    return lvgl_raylib_hit_search_obj(obj, &p);
+}
+
+lv_obj_t * lvgl_raylib_hit_search_display(const lv_point_t * point)
+{
+    lv_obj_t * obj = lvgl_raylib_hit_search(lv_layer_sys(), point);
+    if (obj == NULL) {
+        obj = lvgl_raylib_hit_search(lv_layer_top(), point);
+    }
+    if (obj == NULL) {
+        obj = lvgl_raylib_hit_search(lv_screen_active(), point);
+    }
+    if (obj == NULL) {
+        obj = lvgl_raylib_hit_search(lv_layer_bottom(), point);
+    }
+    return obj;
+}
+
+lv_obj_t * lvgl_raylib_hit_narrow(const lv_point_t * point)
+{
+    _narrowing = true;
+    lv_obj_t * obj = lvgl_raylib_hit_search_display(point);
+    _narrowing = false;
+    return obj;
+}
+
+void lvgl_raylib_hit_widen(void)
+{
+    lvgl_raylib_hit_index_t * index;
+    LV_LL_READ(&_indexes, index) {
+        if (index->narrowed) {
+            index->obj->spec_attr->children = index->saved_children;
+            index->obj->spec_attr->child_cnt = index->saved_child_cnt;
+            index->narrowed = false;
+        }
+    }
+}
+
+void lvgl_raylib_hit_get_stats(lvgl_raylib_hit_stats_t * stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    *stats = _stats;
+    stats->indexes = 0;
+    stats->entries = 0;
+    stats->loose = 0;
+    lvgl_raylib_hit_index_t * index;
+    LV_LL_READ(&_indexes, index) {
+        stats->indexes++;
+        stats->entries += index->entry_cnt;
+        stats->loose += index->loose.cnt;
+    }
+}
+
+void lvgl_raylib_hit_deinit(void)
+{
+    lvgl_raylib_hit_index_t * index;
+    LV_LL_READ(&_indexes, index) {
+        lvgl_raylib_hit_free(index);
+    }
+    lv_ll_clear(&_indexes);
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_hit_index_t * lvgl_raylib_hit_find(const lv_obj_t * obj)
+{
+    lvgl_raylib_hit_index_t * index;
+    LV_LL_READ(&_indexes, index) {
+        if (index->obj == obj) {
+            return index;
+        }
+    }
+    return NULL;
+}
+
+static lv_obj_t * lvgl_raylib_hit_search_obj(lv_obj_t * obj, lv_point_t * point)
+{
+    // Same walk as lv_indev_search_obj(), indexed containers only look at the children near the point
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) {
+        return NULL;
+    }
+
+    lv_point_t p_trans = *point;
+    lv_obj_transform_point(obj, &p_trans, LV_OBJ_POINT_TRANSFORM_FLAG_INVERSE);
+
+    bool hit_test_ok = lv_obj_hit_test(obj, &p_trans);
+
+    lv_area_t obj_coords = obj->coords;
+    bool overflow = lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+    if (overflow) {
+        int32_t ext_draw_size = lv_obj_get_ext_draw_size(obj);
+        lv_area_increase(&obj_coords, ext_draw_size, ext_draw_size);
+    }
+
+    if (lv_area_is_point_on(&obj_coords, &p_trans, 0) || overflow) {
+        lvgl_raylib_hit_index_t * index = lvgl_raylib_hit_find(obj);
+        if (index != NULL) {
+            lv_obj_t * found = lvgl_raylib_hit_query(index, &p_trans);
+            if (_narrowing) {
+                lvgl_raylib_hit_narrow_index(index, found);
+            }
+            if (found != NULL) {
+                return found;
+            }
+        } else {
+            int32_t child_cnt = (int32_t)lv_obj_get_child_count(obj);
+            for (int32_t i = child_cnt - 1; i >= 0; i--) {
+                lv_obj_t * found = lvgl_raylib_hit_search_obj(lv_obj_get_child(obj, i), &p_trans);
+                if (found != NULL) {
+                    return found;
+                }
+            }
+        }
+    }
+
+    return hit_test_ok ? obj : NULL;
+}
+
+static lv_obj_t * lvgl_raylib_hit_query(lvgl_raylib_hit_index_t * index, lv_point_t * point)
+{
+    if (index->dirty) {
+        lvgl_raylib_hit_rebuild(index);
+    }
+
+    lv_point_t content = {
+        point->x - index->obj->coords.x1 + lv_obj_get_scroll_x(index->obj),
+        point->y - index->obj->coords.y1 + lv_obj_get_scroll_y(index->obj),
+    };
+
+    // Children whose area holds the point, plus the loose ones which are always tried
+    lvgl_raylib_hit_list_t * cell = NULL;
+    if (index->cells != NULL && lv_area_is_point_on(&index->bounds, &content, 0)) {
+        int32_t col = (content.x - index->bounds.x1) / index->grid_cell_size;
+        int32_t row = (content.y - index->bounds.y1) / index->grid_cell_size;
+        cell = &index->cells[row * index->cols + col];
+    }
+
+    uint32_t need = index->loose.cnt + (cell != NULL ? cell->cnt : 0);
+    if (need > index->candidate_cap) {
+        uint32_t * candidates = lv_realloc(index->candidates, need * sizeof(uint32_t));
+        if (candidates == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate hit-test candidates");
+            return NULL;
+        }
+        index->candidates = candidates;
+        index->candidate_cap = need;
+    }
+    uint32_t * candidates = index->candidates;
+
+    uint32_t cnt = 0;
+    for (uint32_t i = 0; i < index->loose.cnt; i++) {
+        candidates[cnt++] = index->loose.items[i];
+    }
+    if (cell != NULL) {
+        for (uint32_t i = 0; i < cell->cnt; i++) {
+            if (lv_area_is_point_on(&index->entries[cell->items[i]].area, &content, 0)) {
+                candidates[cnt++] = cell->items[i];
+            }
+        }
+    }
+
+    // Topmost first, there are only a few so insertion sort does
+    for (uint32_t i = 1; i < cnt; i++) {
+        uint32_t item = candidates[i];
+        uint32_t j = i;
+        while (j > 0 && index->entries[candidates[j - 1]].order < index->entries[item].order) {
+            candidates[j] = candidates[j - 1];
+            j--;
+        }
+        candidates[j] = item;
+    }
+
+    _stats.queries++;
+    _stats.candidates += cnt;
+
+    for (uint32_t i = 0; i < cnt; i++) {
+        lv_obj_t * found = lvgl_raylib_hit_search_obj(index->entries[candidates[i]].obj, point);
+        if (found != NULL) {
+            return found;
+        }
+    }
+    return NULL;
+}
+
+static void lvgl_raylib_hit_narrow_index(lvgl_raylib_hit_index_t * index, lv_obj_t * found)
+{
+    if (index->narrowed || index->obj->spec_attr == NULL) {
+        return;
+    }
+
+    // The direct child holding the result, LVGL's search finds the same object through it
+    lv_obj_t * child = found;
+    while (child != NULL && lv_obj_get_parent(child) != index->obj) {
+        child = lv_obj_get_parent(child);
+    }
+
+    lv_obj_spec_attr_t * attr = index->obj->spec_attr;
+    index->narrow_child = child;
+    index->saved_children = attr->children;
+    index->saved_child_cnt = attr->child_cnt;
+    attr->children = &index->narrow_child;
+    attr->child_cnt = child != NULL ? 1 : 0;
+    index->narrowed = true;
+}
+
+static void lvgl_raylib_hit_rebuild(lvgl_raylib_hit_index_t * index)
+{
+    lvgl_raylib_hit_free(index);
+    index->dirty = false;
+    _stats.rebuilds++;
+
+    uint32_t child_cnt = lv_obj_get_child_count(index->obj);
+    if (child_cnt == 0) {
+        return;
+    }
+
+    uint32_t slot_cnt = 16;
+    while (slot_cnt < child_cnt * 2) {
+        slot_cnt *= 2;
+    }
+
+    index->entries = lv_malloc(child_cnt * sizeof(lvgl_raylib_hit_entry_t));
+    index->slots = lv_malloc(slot_cnt * sizeof(uint32_t));
+    if (index->entries == NULL || index->slots == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate hit-test index of %u children", (unsigned)child_cnt);
+        lvgl_raylib_hit_free(index);
+        return;
+    }
+    memset(index->slots, 0xFF, slot_cnt * sizeof(uint32_t));
+    index->slot_mask = slot_cnt - 1;
+    index->entry_cnt = child_cnt;
+
+    // Measure everything first, the grid covers the union of the children in content space
+    bool has_bounds = false;
+    for (uint32_t i = 0; i < child_cnt; i++) {
+        lvgl_raylib_hit_entry_t * entry = &index->entries[i];
+        lvgl_raylib_hit_measure(index, lv_obj_get_child(index->obj, (int32_t)i), entry);
+        entry->order = i;
+        index->slots[lvgl_raylib_hit_slot(index, entry->obj)] = i;
+        if (entry->loose) {
+            continue;
+        }
+        if (!has_bounds) {
+            index->bounds = entry->area;
+            has_bounds = true;
+        } else {
+            lv_area_join(&index->bounds, &index->bounds, &entry->area);
+        }
+    }
+
+    if (has_bounds) {
+        int32_t cell_size = index->cell_size;
+        int32_t w = lv_area_get_width(&index->bounds);
+        int32_t h = lv_area_get_height(&index->bounds);
+        while ((int64_t)((w + cell_size - 1) / cell_size) * ((h + cell_size - 1) / cell_size) > LVGL_RAYLIB_HIT_CELL_MAX) {
+            cell_size *= 2;
+        }
+        index->grid_cell_size = cell_size;
+        index->cols = (w + cell_size - 1) / cell_size;
+        index->rows = (h + cell_size - 1) / cell_size;
+        index->cells = lv_malloc_zeroed((size_t)index->cols * index->rows * sizeof(lvgl_raylib_hit_list_t));
+        if (index->cells == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate hit-test grid of %d x %d cells", (int)index->cols, (int)index->rows);
+            lvgl_raylib_hit_free(index);
+            return;
+        }
+    }
+
+    for (uint32_t i = 0; i < child_cnt; i++) {
+        lvgl_raylib_hit_link(index, i);
+    }
+}
+
+static void lvgl_raylib_hit_free(lvgl_raylib_hit_index_t * index)
+{
+    if (index->cells != NULL) {
+        for (int32_t i = 0; i < index->cols * index->rows; i++) {
+            lv_free(index->cells[i].items);
+        }
+        lv_free(index->cells);
+    }
+    lv_free(index->loose.items);
+    lv_free(index->entries);
+    lv_free(index->slots);
+    lv_free(index->candidates);
+
+    index->cells = NULL;
+    index->cols = 0;
+    index->rows = 0;
+    memset(&index->loose, 0, sizeof(index->loose));
+    index->entries = NULL;
+    index->entry_cnt = 0;
+    index->slots = NULL;
+    index->slot_mask = 0;
+    index->candidates = NULL;
+    index->candidate_cap = 0;
+}
+
+static void lvgl_raylib_hit_measure(lvgl_raylib_hit_index_t * index, lv_obj_t * child, lvgl_raylib_hit_entry_t * entry)
+{
+    entry->obj = child;
+
+    // Content coordinates don't change when the container scrolls or moves
+    lv_obj_get_click_area(child, &entry->area);
+    lv_area_move(&entry->area, lv_obj_get_scroll_x(index->obj) - index->obj->coords.x1,
+                 lv_obj_get_scroll_y(index->obj) - index->obj->coords.y1);
+
+    // Hits outside the click area are possible, or the child doesn't scroll with the rest
+    entry->loose = lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) ||
+                   lv_obj_has_flag(child, LV_OBJ_FLAG_OVERFLOW_VISIBLE) ||
+                   lv_obj_get_style_transform_rotation(child, LV_PART_MAIN) != 0 ||
+                   lv_obj_get_style_transform_scale_x(child, LV_PART_MAIN) != LV_SCALE_NONE ||
+                   lv_obj_get_style_transform_scale_y(child, LV_PART_MAIN) != LV_SCALE_NONE ||
+                   lv_obj_get_style_transform_skew_x(child, LV_PART_MAIN) != 0 ||
+                   lv_obj_get_style_transform_skew_y(child, LV_PART_MAIN) != 0;
+}
+
+static bool lvgl_raylib_hit_cell_range(const lvgl_raylib_hit_index_t * index, const lv_area_t * area,
+                                       int32_t * col1, int32_t * row1, int32_t * col2, int32_t * row2)
+{
+    if (index->cells == NULL || !lv_area_is_in(area, &index->bounds, 0)) {
+        return false;
+    }
+    *col1 = (area->x1 - index->bounds.x1) / index->grid_cell_size;
+    *row1 = (area->y1 - index->bounds.y1) / index->grid_cell_size;
+    *col2 = (area->x2 - index->bounds.x1) / index->grid_cell_size;
+    *row2 = (area->y2 - index->bounds.y1) / index->grid_cell_size;
+    return true;
+}
+
+static void lvgl_raylib_hit_link(lvgl_raylib_hit_index_t * index, uint32_t entry_idx)
+{
+    lvgl_raylib_hit_entry_t * entry = &index->entries[entry_idx];
+
+    // Children as large as the view would sit in every cell, one test per query is cheaper
+    int32_t col1, row1, col2, row2;
+    if (!entry->loose) {
+        if (!lvgl_raylib_hit_cell_range(index, &entry->area, &col1, &row1, &col2, &row2)) {
+            // Moved out of the grid, rebuilt around the new bounds by the next query
+            index->dirty = true;
+            return;
+        }
+        if ((col2 - col1 + 1) * (row2 - row1 + 1) > LVGL_RAYLIB_HIT_SPAN_MAX) {
+            entry->loose = true;
+        }
+    }
+
+    if (entry->loose) {
+        if (!lvgl_raylib_hit_list_add(&index->loose, entry_idx)) {
+            index->dirty = true;
+        }
+        return;
+    }
+
+    for (int32_t row = row1; row <= row2; row++) {
+        for (int32_t col = col1; col <= col2; col++) {
+            if (!lvgl_raylib_hit_list_add(&index->cells[row * index->cols + col], entry_idx)) {
+                index->dirty = true;
+                return;
+            }
+        }
+    }
+}
+
+static void lvgl_raylib_hit_unlink(lvgl_raylib_hit_index_t * index, uint32_t entry_idx)
+{
+    lvgl_raylib_hit_entry_t * entry = &index->entries[entry_idx];
+    if (entry->loose) {
+        lvgl_raylib_hit_list_remove(&index->loose, entry_idx);
+        return;
+    }
+
+    int32_t col1, row1, col2, row2;
+    if (!lvgl_raylib_hit_cell_range(index, &entry->area, &col1, &row1, &col2, &row2)) {
+        return;
+    }
+    for (int32_t row = row1; row <= row2; row++) {
+        for (int32_t col = col1; col <= col2; col++) {
+            lvgl_raylib_hit_list_remove(&index->cells[row * index->cols + col], entry_idx);
+        }
+    }
+}
+
+static bool lvgl_raylib_hit_list_add(lvgl_raylib_hit_list_t * list, uint32_t item)
+{
+    if (list->cnt == list->cap) {
+        uint32_t cap = list->cap ? list->cap * 2 : 4;
+        uint32_t * items = lv_realloc(list->items, cap * sizeof(uint32_t));
+        if (items == NULL) {
+            TraceLog(LOG_ERROR, "Failed to grow hit-test cell");
+            return false;
+        }
+        list->items = items;
+        list->cap = cap;
+    }
+    list->items[list->cnt++] = item;
+    return true;
+}
+
+static void lvgl_raylib_hit_list_remove(lvgl_raylib_hit_list_t * list, uint32_t item)
+{
+    for (uint32_t i = 0; i < list->cnt; i++) {
+        if (list->items[i] == item) {
+            list->items[i] = list->items[--list->cnt];
+            return;
+        }
+    }
+}
+
+static uint32_t lvgl_raylib_hit_slot(const lvgl_raylib_hit_index_t * index, const lv_obj_t * obj)
+{
+    uint32_t slot = (uint32_t)(((uintptr_t)obj >> 4) * 2654435761u) & index->slot_mask;
+    while (index->slots[slot] != LVGL_RAYLIB_HIT_EMPTY && index->entries[index->slots[slot]].obj != obj) {
+        slot = (slot + 1) & index->slot_mask;
+    }
+    return slot;
+}
+
+static void lvgl_raylib_hit_child_changed_cb(lv_event_t * e)
+{
+    lvgl_raylib_hit_index_t * index = lvgl_raylib_hit_find(lv_event_get_target(e));
+    lv_obj_t * child = lv_event_get_param(e);
+    if (index == NULL || index->dirty || index->slots == NULL || child == NULL) {
+        return;
+    }
+
+    uint32_t entry_idx = index->slots[lvgl_raylib_hit_slot(index, child)];
+    if (entry_idx == LVGL_RAYLIB_HIT_EMPTY) {
+        index->dirty = true;
+        return;
+    }
+
+    // A child changing without moving was reordered or restyled, only a rebuild knows
+    lvgl_raylib_hit_entry_t * entry = &index->entries[entry_idx];
+    lvgl_raylib_hit_entry_t measured;
+    lvgl_raylib_hit_measure(index, child, &measured);
+    if (lv_area_is_equal(&measured.area, &entry->area)) {
+        index->dirty = true;
+        return;
+    }
+
+    // Layouts move children one by one, each move only touches the cells of that child
+    lvgl_raylib_hit_unlink(index, entry_idx);
+    entry->area = measured.area;
+    entry->loose = measured.loose;
+    lvgl_raylib_hit_link(index, entry_idx);
+    _stats.updates++;
+}
+
+static void lvgl_raylib_hit_children_cb(lv_event_t * e)
+{
+    lvgl_raylib_hit_index_t * index = lvgl_raylib_hit_find(lv_event_get_target(e));
+    if (index != NULL) {
+        index->dirty = true;
+    }
+}
+
+static void lvgl_raylib_hit_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_hit_index_t * index = lvgl_raylib_hit_find(lv_event_get_target(e));
+    if (index != NULL) {
+        lvgl_raylib_hit_free(index);
+        lv_ll_remove(&_indexes, index);
+        lv_free(index);
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef LVGL_RAYLIB_HIT_H
+#define LVGL_RAYLIB_HIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Default grid cell edge in pixels */
+#define LVGL_RAYLIB_HIT_CELL_SIZE 64
+
+/** Cells of one grid, the cell edge grows for larger content */
+#define LVGL_RAYLIB_HIT_CELL_MAX (64 * 1024)
+
+/** Children covering more cells than this are tested on every query instead */
+#define LVGL_RAYLIB_HIT_SPAN_MAX 64
+
+/* public types */
+
+/** A direct child of the indexed container */
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;             // click area in content coordinates, independent of scrolling
+    uint32_t order;             // index among the siblings, higher is on top
+    bool loose;                 // floating, transformed, overflowing or large: not in the cells
+} lvgl_raylib_hit_entry_t;
+
+typedef struct {
+    uint32_t * items;           // entry indices
+    uint32_t cnt;
+    uint32_t cap;
+} lvgl_raylib_hit_list_t;
+
+typedef struct {
+    lv_obj_t * obj;
+    int32_t cell_size;          // requested, the grid may use a larger one
+    int32_t grid_cell_size;
+    int32_t cols;
+    int32_t rows;
+    lv_area_t bounds;           // content area covered by the cells
+    lvgl_raylib_hit_list_t * cells;
+    lvgl_raylib_hit_list_t loose;
+    lvgl_raylib_hit_entry_t * entries;
+    uint32_t entry_cnt;
+    uint32_t * slots;           // open addressing from child to entry, UINT32_MAX is empty
+    uint32_t slot_mask;
+    uint32_t * candidates;      // children of one query, sorted top down
+    uint32_t candidate_cap;
+    bool dirty;                 // children added, removed or reordered, rebuilt by the next query
+    lv_obj_t * narrow_child;    // the only child LVGL's search sees while narrowed, or none
+    lv_obj_t ** saved_children;
+    uint32_t saved_child_cnt;
+    bool narrowed;
+} lvgl_raylib_hit_index_t;
+
+/* public functions */
+
+void lvgl_raylib_hit_init(void);
+
+/** True once any container is indexed */
+bool lvgl_raylib_hit_is_active(void);
+
+/** The object under a display point, searched like LVGL's pointer: system, top, screen, bottom */
+lv_obj_t * lvgl_raylib_hit_search_display(const lv_point_t * point);
+
+/** Search like lvgl_raylib_hit_search_display() and leave every indexed container it passed
+ *  with only the child on the way to the result, so LVGL's own search at the same point walks
+ *  a path instead of thousands of children. Nothing may look at the children before
+ *  lvgl_raylib_hit_widen() puts them back. */
+lv_obj_t * lvgl_raylib_hit_narrow(const lv_point_t * point);
+void lvgl_raylib_hit_widen(void);
+
+void lvgl_raylib_hit_deinit(void);
+
+#endif
@@ -0,0 +1,214 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_image.h"
+
+/* private types */
+
+typedef struct {
+    const lv_image_dsc_t * dsc;
+    lv_area_t area;
+} lvgl_raylib_image_invalidate_ctx_t;
+
+/* private prototypes */
+
+static lvgl_raylib_shared_image_t * lvgl_raylib_image_find(const Image * image);
+static bool lvgl_raylib_image_clip_area(const Image * image, const lv_area_t * area, lv_area_t * clipped);
+static void lvgl_raylib_image_swap_rb(Image * image, const lv_area_t * area);
+static void lvgl_raylib_image_invalidate(const lv_image_dsc_t * dsc, const lv_area_t * area);
+static lv_obj_tree_walk_res_t lvgl_raylib_image_invalidate_cb(lv_obj_t * obj, void * user_data);
+
+/* static variables */
+
+static lv_ll_t _shared_images;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_image_init(void)
+{
+    lv_ll_init(&_shared_images, sizeof(lvgl_raylib_shared_image_t));
+}
+
+const lv_image_dsc_t * lvgl_raylib_image_share(Image * image)
+{
+    lvgl_raylib_shared_image_t * shared = lvgl_raylib_image_find(image);
+    if (shared != NULL) {
+        return &shared->dsc;
+    }
+
+    if (image->data == NULL || image->mipmaps != 1) {
+        TraceLog(LOG_ERROR, "Only loaded single mipmap images can be shared with LVGL");
+        return NULL;
+    }
+
+    // One time conversion; raylib reallocates image->data, the caller's pointer changes
+    if (image->format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        ImageFormat(image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    }
+
+    // raylib rows are tightly packed, LVGL must accept that stride as is
+    uint32_t stride = (uint32_t)image->width * 4;
+    if (lv_draw_buf_width_to_stride((uint32_t)image->width, LV_COLOR_FORMAT_ARGB8888) != stride) {
+        TraceLog(LOG_ERROR, "Image width %d doesn't match LV_DRAW_BUF_STRIDE_ALIGN, can't share without copying", image->width);
+        return NULL;
+    }
+    // LVGL reads the pixels as 32 bit words. LV_DRAW_BUF_ALIGN is for buffers LVGL draws
+    // into, a source image only needs word alignment, which malloc() always gives.
+    if (((uintptr_t)image->data % sizeof(uint32_t)) != 0) {
+        TraceLog(LOG_ERROR, "Shared image data must be aligned to 4 bytes");
+        return NULL;
+    }
+
+    shared = lv_ll_ins_tail(&_shared_images);
+    if (shared == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate LVGL Raylib shared image");
+        return NULL;
+    }
+
+    shared->image = image;
+    lv_memzero(&shared->dsc, sizeof(shared->dsc));
+    shared->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    shared->dsc.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    shared->dsc.header.w = (uint32_t)image->width;
+    shared->dsc.header.h = (uint32_t)image->height;
+    shared->dsc.header.stride = stride;
+    shared->dsc.data_size = stride * (uint32_t)image->height;
+    shared->dsc.data = image->data;
+
+    // raylib R,G,B,A bytes become LVGL's little-endian ARGB8888 (B,G,R,A) in place. From
+    // here on the image belongs to LVGL: raylib sees swapped colors outside of
+    // begin_edit()/changed() until the image is unshared. Both renderers read the bytes
+    // directly, LVGL's software one has no R,G,B,A source format to swap them on the fly.
+    lv_area_t full = { 0, 0, image->width - 1, image->height - 1 };
+    lvgl_raylib_image_swap_rb(image, &full);
+
+    return &shared->dsc;
+}
+
+void lvgl_raylib_image_begin_edit(Image * image, const lv_area_t * area)
+{
+    lvgl_raylib_shared_image_t * shared = lvgl_raylib_image_find(image);
+    lv_area_t clipped;
+    if (shared == NULL || !lvgl_raylib_image_clip_area(image, area, &clipped)) {
+        return;
+    }
+
+    // Give raylib its own byte order back, only where it is going to draw
+    lvgl_raylib_image_swap_rb(image, &clipped);
+}
+
+void lvgl_raylib_image_changed(Image * image, const lv_area_t * area)
+{
+    lvgl_raylib_shared_image_t * shared = lvgl_raylib_image_find(image);
+    lv_area_t clipped;
+    if (shared == NULL || !lvgl_raylib_image_clip_area(image, area, &clipped)) {
+        return;
+    }
+
+    lvgl_raylib_image_swap_rb(image, &clipped);
+    lv_image_cache_drop(&shared->dsc);
+    lvgl_raylib_draw_gpu_image_drop(&shared->dsc);
+    lvgl_raylib_image_invalidate(&shared->dsc, &clipped);
+}
+
+void lvgl_raylib_image_unshare(Image * image)
+{
+    lvgl_raylib_shared_image_t * shared = lvgl_raylib_image_find(image);
+    if (shared == NULL) {
+        return;
+    }
+
+    lv_area_t full = { 0, 0, image->width - 1, image->height - 1 };
+    lvgl_raylib_image_swap_rb(image, &full);
+    lv_image_cache_drop(&shared->dsc);
+    lvgl_raylib_draw_gpu_image_drop(&shared->dsc);
+
+    lv_ll_remove(&_shared_images, shared);
+    lv_free(shared);
+}
+
+void lvgl_raylib_image_deinit(void)
+{
+    lv_ll_clear(&_shared_images);
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_shared_image_t * lvgl_raylib_image_find(const Image * image)
+{
+    lvgl_raylib_shared_image_t * shared;
+    LV_LL_READ(&_shared_images, shared) {
+        if (shared->image == image) {
+            return shared;
+        }
+    }
+    return NULL;
+}
+
+static bool lvgl_raylib_image_clip_area(const Image * image, const lv_area_t * area, lv_area_t * clipped)
+{
+    lv_area_t full = { 0, 0, image->width - 1, image->height - 1 };
+    if (area == NULL) {
+        *clipped = full;
+        return true;
+    }
+    return lv_area_intersect(clipped, area, &full);
+}
+
+static void lvgl_raylib_image_swap_rb(Image * image, const lv_area_t * area)
+{
+    uint8_t * data = (uint8_t *)image->data;
+    int32_t stride = image->width * 4;
+
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        uint8_t * px = data + y * stride + area->x1 * 4;
+        for (int32_t x = area->x1; x <= area->x2; x++) {
+            uint8_t tmp = px[0];
+            px[0] = px[2];
+            px[2] = tmp;
+            px += 4;
+        }
+    }
+}
+
+static void lvgl_raylib_image_invalidate(const lv_image_dsc_t * dsc, const lv_area_t * area)
+{
+    lvgl_raylib_image_invalidate_ctx_t ctx = { dsc, *area };
+    lv_obj_tree_walk(lv_screen_active(), &lvgl_raylib_image_invalidate_cb, &ctx);
+    lv_obj_tree_walk(lv_layer_top(), &lvgl_raylib_image_invalidate_cb, &ctx);
+}
+
+static lv_obj_tree_walk_res_t lvgl_raylib_image_invalidate_cb(lv_obj_t * obj, void * user_data)
+{
+    lvgl_raylib_image_invalidate_ctx_t * ctx = (lvgl_raylib_image_invalidate_ctx_t *)user_data;
+
+    if (!lv_obj_check_type(obj, &lv_image_class) || lv_image_get_src(obj) != ctx->dsc) {
+        return LV_OBJ_TREE_WALK_NEXT;
+    }
+
+    // Transformed, tiled or stretched images map pixels in ways not worth tracking
+    lv_image_align_t align = lv_image_get_inner_align(obj);
+    if (lv_image_get_rotation(obj) != 0 ||
+        lv_image_get_scale_x(obj) != LV_SCALE_NONE || lv_image_get_scale_y(obj) != LV_SCALE_NONE ||
+        (align != LV_IMAGE_ALIGN_DEFAULT && align != LV_IMAGE_ALIGN_CENTER && align != LV_IMAGE_ALIGN_TOP_LEFT)) {
+        lv_obj_invalidate(obj);
+        return LV_OBJ_TREE_WALK_SKIP_CHILDREN;
+    }
+
+    lv_area_t content;
+    lv_obj_get_content_coords(obj, &content);
+
+    int32_t x = content.x1 + lv_image_get_offset_x(obj);
+    int32_t y = content.y1 + lv_image_get_offset_y(obj);
+    if (align != LV_IMAGE_ALIGN_TOP_LEFT) {
+        x += (lv_area_get_width(&content) - (int32_t)ctx->dsc->header.w) / 2;
+        y += (lv_area_get_height(&content) - (int32_t)ctx->dsc->header.h) / 2;
+    }
+
+    lv_area_t inv = ctx->area;
+    lv_area_move(&inv, x, y);
+    lv_obj_invalidate_area(obj, &inv);
+
+    return LV_OBJ_TREE_WALK_SKIP_CHILDREN;
+}
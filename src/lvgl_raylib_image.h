@@ -0,0 +1,19 @@
+#ifndef LVGL_RAYLIB_IMAGE_H
+#define LVGL_RAYLIB_IMAGE_H
+
+#include "lvgl.h"
+#include "raylib.h"
+
+/* public types */
+
+typedef struct {
+    Image * image;
+    lv_image_dsc_t dsc;
+} lvgl_raylib_shared_image_t;
+
+/* public functions */
+
+void lvgl_raylib_image_init(void);
+void lvgl_raylib_image_deinit(void);
+
+#endif
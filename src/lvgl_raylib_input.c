@@ -1,10 +1,71 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_private.h"
 #include "lvgl_raylib_input.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_hit.h"
 #include "raylib.h"
 #include "lvgl.h"
 
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#endif
+
+/* private prototypes */
+
 static void lvgl_raylib_pointer_read(lv_indev_t * indev, lv_indev_data_t* data);
 static void lvgl_raylib_keyboard_read(lv_indev_t * indev, lv_indev_data_t* data);
+static uint32_t convert_control_key(int key);
+static void lvgl_raylib_input_push(lvgl_raylib_input_queue_t * queue, lvgl_raylib_input_event_type_t type,
+                                   Vector2 pos, int32_t value);
+static bool lvgl_raylib_input_pop(lvgl_raylib_input_queue_t * queue, lvgl_raylib_input_event_t * event);
+static bool lvgl_raylib_input_pending(const lvgl_raylib_input_queue_t * queue);
+static void lvgl_raylib_input_set_timestamp(lv_indev_data_t * data, uint32_t timestamp);
+static bool lvgl_raylib_input_hover_unchanged(void);
+static void lvgl_raylib_input_feed_point(lv_indev_t * indev);
+static bool lvgl_raylib_input_narrow(lv_indev_t * indev);
+static void lvgl_raylib_input_widen(void);
+static void lvgl_raylib_input_widen_cb(lv_event_t * e);
+static void lvgl_raylib_input_read_keys(lvgl_raylib_input_t * input);
+static lv_obj_t * lvgl_raylib_input_text_target(lv_group_t * group);
+static bool lvgl_raylib_input_text_next(void);
+static void lvgl_raylib_input_insert_text(lv_obj_t * textarea);
+static bool lvgl_raylib_input_paste_mods(void);
+static bool lvgl_raylib_input_key_is_printable(int key);
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+static void lvgl_raylib_input_glfw_install(void);
+static void lvgl_raylib_input_glfw_uninstall(void);
+#endif
+
+/* static variables */
 
+static lvgl_raylib_input_queue_t _pointer_queue;
+static lvgl_raylib_input_queue_t _key_queue;
+static lvgl_raylib_input_stats_t _stats;
+static lv_point_t _pointer_point;       // state last reported to LVGL
+static bool _pointer_pressed = false;
+static uint32_t _key_down = 0;          // key reported pressed, released by the next read
+static Vector2 _poll_pos;               // state seen by the last poll
+static bool _poll_down = false;
+static double _rate_start = 0.0;        // window of the per second counters
+static uint32_t _rate_reads = 0;
+static uint32_t _rate_skipped = 0;
+static uint32_t _rate_keystrokes = 0;
+static lv_obj_t * _hover_obj = NULL;    // under the pointer at the last motion read, with a hit-test index
+static bool _hover_valid = false;
+static lv_obj_t * _narrow_objs[2];      // where LVGL's first event after a narrowed search goes
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+static GLFWwindow * _window = NULL;
+static GLFWmousebuttonfun _prev_button_cb = NULL;
+static GLFWcursorposfun _prev_cursor_pos_cb = NULL;
+static GLFWscrollfun _prev_scroll_cb = NULL;
+static GLFWkeyfun _prev_key_cb = NULL;
+static GLFWcharfun _prev_char_cb = NULL;
+#endif
+
+/* PUBLIC IMPLEMENTATION */
 
 void lvgl_raylib_input_create(lvgl_raylib_input_t *input) {
     // Create and initialize the pointer input device (mouse or touch)
@@ -15,6 +76,7 @@ void lvgl_raylib_input_create(lvgl_raylib_input_t *input) {
     }
     
     lv_indev_set_type(input->mouse_indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_mode(input->mouse_indev, LV_INDEV_MODE_EVENT);
     lv_indev_set_read_cb(input->mouse_indev, lvgl_raylib_pointer_read);
     lv_indev_set_display(input->mouse_indev, lv_display_get_default());
     
@@ -35,27 +97,174 @@ void lvgl_raylib_input_create(lvgl_raylib_input_t *input) {
 
     lv_indev_set_group(input->mouse_indev, input->group);
     lv_indev_set_group(input->keyboard_indev, input->group);
+
+    // Start from where the pointer is, the queue only holds what changes from here
+    lv_memzero(&_pointer_queue, sizeof(_pointer_queue));
+    lv_memzero(&_key_queue, sizeof(_key_queue));
+    lv_memzero(&_stats, sizeof(_stats));
+    _poll_pos = GetMousePosition();
+    _poll_down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+    _pointer_point.x = (int32_t)_poll_pos.x;
+    _pointer_point.y = (int32_t)_poll_pos.y;
+    _pointer_pressed = _poll_down;
+    _key_down = 0;
+    _rate_start = GetTime();
+    _rate_reads = 0;
+    _rate_skipped = 0;
+    _rate_keystrokes = 0;
+    _hover_obj = NULL;
+    _hover_valid = false;
+
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+    lvgl_raylib_input_glfw_install();
+#endif
+}
+
+void lvgl_raylib_input_poll(void) {
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+    // The callbacks already queued every event as it arrived
+    if (_window != NULL) return;
+#endif
+
+    // Without callbacks only the state at the end of the frame is known
+    Vector2 pos = GetMousePosition();
+    if (pos.x != _poll_pos.x || pos.y != _poll_pos.y) {
+        lvgl_raylib_input_push(&_pointer_queue, LVGL_RAYLIB_INPUT_EVENT_MOTION, pos, 0);
+        _poll_pos = pos;
+    }
+
+    bool down = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+    if (down != _poll_down) {
+        lvgl_raylib_input_push(&_pointer_queue, down ? LVGL_RAYLIB_INPUT_EVENT_BUTTON_DOWN : LVGL_RAYLIB_INPUT_EVENT_BUTTON_UP,
+                               pos, 0);
+        _poll_down = down;
+    }
+
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f) {
+        lvgl_raylib_input_push(&_pointer_queue, LVGL_RAYLIB_INPUT_EVENT_WHEEL, pos, (int32_t)(wheel * 10.0f));
+    }
+
+    // raylib keeps keys and characters in separate queues. A printable key typed its
+    // character, so taking the next one there restores the order "ab<Backspace>c" was typed
+    // in; characters without a key of their own (input methods, dead keys) come last.
+    bool mods = lvgl_raylib_input_paste_mods();
+    int key;
+    int char_key;
+    while ((key = GetKeyPressed()) != 0) {
+        if (key == KEY_V && mods) {
+            lvgl_raylib_input_push(&_key_queue, LVGL_RAYLIB_INPUT_EVENT_PASTE, pos, 0);
+            continue;
+        }
+        if (!mods && lvgl_raylib_input_key_is_printable(key)) {
+            if ((char_key = GetCharPressed()) != 0) {
+                lvgl_raylib_input_push(&_key_queue, LVGL_RAYLIB_INPUT_EVENT_TEXT, pos, char_key);
+            }
+            continue;
+        }
+        uint32_t lvgl_key = convert_control_key(key);
+        if (lvgl_key && lvgl_key != LV_KEY_ESC) { /* ignore ESC key */
+            lvgl_raylib_input_push(&_key_queue, LVGL_RAYLIB_INPUT_EVENT_KEY, pos, (int32_t)lvgl_key);
+        }
+    }
+
+    while ((char_key = GetCharPressed()) != 0) {
+        lvgl_raylib_input_push(&_key_queue, LVGL_RAYLIB_INPUT_EVENT_TEXT, pos, char_key);
+    }
+}
+
+void lvgl_raylib_input_update(lvgl_raylib_input_t *input) {
+    if (input->keyboard_indev != NULL) {
+        lvgl_raylib_input_read_keys(input);
+    }
+    if (input->mouse_indev == NULL) return;
+
+    // Changes are queued, a held button still needs reads for long press and repeat
+    // and a released throw for its inertia
+    bool throwing = lv_indev_get_scroll_obj(input->mouse_indev) != NULL;
+    bool needed = lvgl_raylib_input_pending(&_pointer_queue) || _pointer_pressed || throwing;
+
+    // Released motion over the same object changes nothing in LVGL, the index tells cheaply
+    if (needed && !_pointer_pressed && !throwing && lvgl_raylib_input_hover_unchanged()) {
+        _stats.hover_skips++;
+        lvgl_raylib_input_feed_point(input->mouse_indev);
+        needed = false;
+    }
+
+    if (needed) {
+        // An event mode indev may read once per call, every queued sample gets its own.
+        // A disabled indev takes nothing, that ends it too.
+        do {
+            uint32_t head = _pointer_queue.head;
+            bool narrowed = lvgl_raylib_input_narrow(input->mouse_indev);
+            lv_indev_read(input->mouse_indev);
+            if (narrowed) {
+                lvgl_raylib_input_widen();
+            }
+            _rate_reads++;
+            if (_pointer_queue.head == head) break;
+        } while (lvgl_raylib_input_pending(&_pointer_queue));
+    } else {
+        _stats.skipped_reads++;
+        _rate_skipped++;
+    }
+
+    double now = GetTime();
+    if (now - _rate_start >= 1.0) {
+        _stats.reads_per_sec = (uint32_t)(_rate_reads / (now - _rate_start) + 0.5);
+        _stats.skipped_reads_per_sec = (uint32_t)(_rate_skipped / (now - _rate_start) + 0.5);
+        _stats.keystrokes_per_sec = (uint32_t)(_rate_keystrokes / (now - _rate_start) + 0.5);
+        _rate_start = now;
+        _rate_reads = 0;
+        _rate_skipped = 0;
+        _rate_keystrokes = 0;
+    }
+}
+
+void lvgl_raylib_input_get_stats(lvgl_raylib_input_stats_t * stats) {
+    if (stats == NULL) return;
+    *stats = _stats;
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+    stats->captured = _window != NULL;
+#else
+    stats->captured = false;
+#endif
 }
 
+void lvgl_raylib_input_destroy(lvgl_raylib_input_t *input) {
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+    lvgl_raylib_input_glfw_uninstall();
+#endif
+    lv_group_delete(input->group);
+    lv_indev_delete(input->mouse_indev);
+    lv_indev_delete(input->keyboard_indev);
+}
+
+/* PRIVATE IMPLEMENTATION */
+
 static void lvgl_raylib_pointer_read(lv_indev_t * indev, lv_indev_data_t* data) {
-    // Get mouse position
-    Vector2 mouse_pos = GetMousePosition();
-    
-    // Update coordinates
-    data->point.x = (int16_t)mouse_pos.x;
-    data->point.y = (int16_t)mouse_pos.y;
-    
-    // Update pointer state (pressed or released)
-    data->state = IsMouseButtonDown(MOUSE_BUTTON_LEFT) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
-    
-    // Get mouse wheel movement since last read
-    int16_t wheel_diff = GetMouseWheelMove();
-    
-    // Update encoder difference for scrolling
-    data->enc_diff = wheel_diff * 10;
-    
-    // We do not need to continue reading
-    data->continue_reading = false;
+    LV_UNUSED(indev);
+
+    // One queued event per read, LVGL processes each before asking for the next
+    data->enc_diff = 0;
+    lvgl_raylib_input_event_t event;
+    if (lvgl_raylib_input_pop(&_pointer_queue, &event)) {
+        _pointer_point.x = event.x;
+        _pointer_point.y = event.y;
+        switch (event.type) {
+            case LVGL_RAYLIB_INPUT_EVENT_BUTTON_DOWN: _pointer_pressed = true; break;
+            case LVGL_RAYLIB_INPUT_EVENT_BUTTON_UP:   _pointer_pressed = false; break;
+            case LVGL_RAYLIB_INPUT_EVENT_WHEEL:       data->enc_diff = (int16_t)event.value; break;
+            default: break;
+        }
+        lvgl_raylib_input_set_timestamp(data, event.timestamp);
+    }
+
+    data->point = _pointer_point;
+    data->state = _pointer_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    // With a hit-test index every sample gets a read of its own, so LVGL's search for it can
+    // be narrowed beforehand
+    data->continue_reading = lvgl_raylib_input_pending(&_pointer_queue) && !lvgl_raylib_hit_is_active();
 }
 
 // Convert Raylib key codes to LVGL key codes
@@ -77,24 +286,32 @@ static uint32_t convert_control_key(int key) {
 }
 
 static void lvgl_raylib_keyboard_read(lv_indev_t * indev, lv_indev_data_t* data) {
-    // First check for special keys
-    int key = GetKeyPressed();
-    if (key) {
-        uint32_t lvgl_key = convert_control_key(key);
-        if (lvgl_key && lvgl_key != LV_KEY_ESC) { /* ignore ESC key */
-            data->key = lvgl_key;
-            data->state = LV_INDEV_STATE_PRESSED;
-            data->continue_reading = true;
-            return;
-        }
+    LV_UNUSED(indev);
+
+    // Every key is released before the next one is pressed, so "aa" types two a's.
+    // Stop before characters a focused textarea takes as one string.
+    if (_key_down) {
+        data->key = _key_down;
+        data->state = LV_INDEV_STATE_RELEASED;
+        data->continue_reading = lvgl_raylib_input_pending(&_key_queue) &&
+                                 !(lvgl_raylib_input_text_next() && lvgl_raylib_input_text_target(lv_indev_get_group(indev)) != NULL);
+        _key_down = 0;
+        return;
     }
-    
-    // If no special key, check for character input
-    int char_key = GetCharPressed();
-    if (char_key) {
-        data->key = char_key;
+
+    // Pasting only means something to a textarea
+    lvgl_raylib_input_event_t event;
+    bool popped = lvgl_raylib_input_pop(&_key_queue, &event);
+    while (popped && event.type == LVGL_RAYLIB_INPUT_EVENT_PASTE) {
+        popped = lvgl_raylib_input_pop(&_key_queue, &event);
+    }
+    if (popped) {
+        _rate_keystrokes++;
+        _key_down = (uint32_t)event.value;
+        data->key = _key_down;
         data->state = LV_INDEV_STATE_PRESSED;
         data->continue_reading = true;
+        lvgl_raylib_input_set_timestamp(data, event.timestamp);
         return;
     }
     
@@ -103,8 +320,319 @@ static void lvgl_raylib_keyboard_read(lv_indev_t * indev, lv_indev_data_t* data)
     data->continue_reading = false;
 }
 
-void lvgl_raylib_input_destroy(lvgl_raylib_input_t *input) {
-    lv_group_delete(input->group);
-    lv_indev_delete(input->mouse_indev);
-    lv_indev_delete(input->keyboard_indev);
-}
\ No newline at end of file
+static void lvgl_raylib_input_push(lvgl_raylib_input_queue_t * queue, lvgl_raylib_input_event_type_t type,
+                                   Vector2 pos, int32_t value) {
+    uint32_t depth = queue->tail - queue->head;
+
+    // Past half full motion samples merge into the newest one, so edges and keys still fit
+    if (type == LVGL_RAYLIB_INPUT_EVENT_MOTION && depth >= LVGL_RAYLIB_INPUT_QUEUE_SIZE / 2) {
+        lvgl_raylib_input_event_t * last = &queue->events[(queue->tail - 1) & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)];
+        if (last->type == LVGL_RAYLIB_INPUT_EVENT_MOTION) {
+            last->x = (int32_t)pos.x;
+            last->y = (int32_t)pos.y;
+            last->timestamp = lv_tick_get();
+            _stats.coalesced++;
+            return;
+        }
+    }
+
+    if (depth == LVGL_RAYLIB_INPUT_QUEUE_SIZE) {
+        _stats.dropped++;
+        return;
+    }
+
+    lvgl_raylib_input_event_t * event = &queue->events[queue->tail & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)];
+    event->type = type;
+    event->x = (int32_t)pos.x;
+    event->y = (int32_t)pos.y;
+    event->value = value;
+    event->timestamp = lv_tick_get();
+    queue->tail++;
+
+    _stats.events++;
+    if (depth + 1 > _stats.max_depth) _stats.max_depth = depth + 1;
+}
+
+static bool lvgl_raylib_input_pop(lvgl_raylib_input_queue_t * queue, lvgl_raylib_input_event_t * event) {
+    if (queue->head == queue->tail) return false;
+    *event = queue->events[queue->head & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)];
+    queue->head++;
+    return true;
+}
+
+static bool lvgl_raylib_input_pending(const lvgl_raylib_input_queue_t * queue) {
+    return queue->head != queue->tail;
+}
+
+static void lvgl_raylib_input_set_timestamp(lv_indev_data_t * data, uint32_t timestamp) {
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 3)
+    data->timestamp = timestamp;
+#else
+    LV_UNUSED(data);
+    LV_UNUSED(timestamp);
+#endif
+}
+
+static void lvgl_raylib_input_read_keys(lvgl_raylib_input_t * input) {
+    // A run of characters for the focused textarea goes in as one string, one relayout and
+    // one invalidation; keys in between are still read by LVGL in their order
+    while (true) {
+        lv_obj_t * textarea = lvgl_raylib_input_text_target(input->group);
+        if (textarea != NULL && _key_down == 0 && lvgl_raylib_input_text_next()) {
+            lvgl_raylib_input_insert_text(textarea);
+            continue;
+        }
+
+        uint32_t head = _key_queue.head;
+        uint32_t down = _key_down;
+        lv_indev_read(input->keyboard_indev);
+
+        // Done, or the indev is disabled and the read neither took a key nor released one.
+        // A read that only released a key stops at characters for a textarea, go on with them.
+        if (!lvgl_raylib_input_pending(&_key_queue) || (_key_queue.head == head && _key_down == down)) {
+            break;
+        }
+    }
+}
+
+static lv_obj_t * lvgl_raylib_input_text_target(lv_group_t * group) {
+#if LV_USE_TEXTAREA
+    lv_obj_t * obj = group != NULL ? lv_group_get_focused(group) : NULL;
+    if (obj == NULL || !lv_obj_check_type(obj, &lv_textarea_class) || lv_obj_has_state(obj, LV_STATE_DISABLED)) {
+        return NULL;
+    }
+    return obj;
+#else
+    LV_UNUSED(group);
+    return NULL;
+#endif
+}
+
+static bool lvgl_raylib_input_text_next(void) {
+    if (!lvgl_raylib_input_pending(&_key_queue)) return false;
+    lvgl_raylib_input_event_type_t type = _key_queue.events[_key_queue.head & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)].type;
+    return type == LVGL_RAYLIB_INPUT_EVENT_TEXT || type == LVGL_RAYLIB_INPUT_EVENT_PASTE;
+}
+
+static void lvgl_raylib_input_insert_text(lv_obj_t * textarea) {
+#if LV_USE_TEXTAREA
+    // Size the run first: characters up to the next key, a paste ends it
+    const char * clipboard = NULL;
+    size_t size = 1;
+    uint32_t chars = 0;
+    uint32_t end = _key_queue.head;
+    while (end != _key_queue.tail) {
+        const lvgl_raylib_input_event_t * event = &_key_queue.events[end & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)];
+        if (event->type == LVGL_RAYLIB_INPUT_EVENT_TEXT) {
+            size += 4;
+            chars++;
+            end++;
+        } else if (event->type == LVGL_RAYLIB_INPUT_EVENT_PASTE) {
+            clipboard = GetClipboardText();
+            if (clipboard != NULL) size += strlen(clipboard);
+            end++;
+            break;
+        } else {
+            break;
+        }
+    }
+
+    char * text = lv_malloc(size);
+    if (text == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate %u bytes of typed text", (unsigned)size);
+        _key_queue.head = end;
+        return;
+    }
+
+    size_t len = 0;
+    for (uint32_t i = _key_queue.head; i != end; i++) {
+        const lvgl_raylib_input_event_t * event = &_key_queue.events[i & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)];
+        if (event->type == LVGL_RAYLIB_INPUT_EVENT_TEXT) {
+            int utf8_size = 0;
+            const char * utf8 = CodepointToUTF8(event->value, &utf8_size);
+            memcpy(text + len, utf8, (size_t)utf8_size);
+            len += (size_t)utf8_size;
+        } else if (clipboard != NULL) {
+            size_t clipboard_len = strlen(clipboard);
+            memcpy(text + len, clipboard, clipboard_len);
+            len += clipboard_len;
+            _stats.pastes++;
+        }
+    }
+    text[len] = '\0';
+    _key_queue.head = end;
+
+    if (len > 0) {
+        lv_textarea_add_text(textarea, text);
+        _stats.text_batches++;
+        _stats.text_bytes += (uint32_t)len;
+    }
+    _rate_keystrokes += chars;
+    lv_free(text);
+#else
+    LV_UNUSED(textarea);
+#endif
+}
+
+static bool lvgl_raylib_input_paste_mods(void) {
+    return IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL) ||
+           IsKeyDown(KEY_LEFT_SUPER) || IsKeyDown(KEY_RIGHT_SUPER);
+}
+
+static bool lvgl_raylib_input_key_is_printable(int key) {
+    return (key >= KEY_SPACE && key <= KEY_GRAVE) || (key >= KEY_KP_0 && key <= KEY_KP_ADD);
+}
+
+static bool lvgl_raylib_input_hover_unchanged(void) {
+    if (!lvgl_raylib_hit_is_active()) {
+        _hover_valid = false;
+        return false;
+    }
+
+    for (uint32_t i = _pointer_queue.head; i != _pointer_queue.tail; i++) {
+        if (_pointer_queue.events[i & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)].type != LVGL_RAYLIB_INPUT_EVENT_MOTION) {
+            _hover_valid = false;
+            return false;
+        }
+    }
+
+    const lvgl_raylib_input_event_t * last = &_pointer_queue.events[(_pointer_queue.tail - 1) & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)];
+    lv_point_t point = { last->x, last->y };
+    lv_obj_t * obj = lvgl_raylib_hit_search_display(&point);
+    if (_hover_valid && obj == _hover_obj) {
+        // The next read starts from here
+        _pointer_point = point;
+        _pointer_queue.head = _pointer_queue.tail;
+        return true;
+    }
+
+    _hover_obj = obj;
+    _hover_valid = true;
+    return false;
+}
+
+static void lvgl_raylib_input_feed_point(lv_indev_t * indev) {
+    // Skipped motion still moves the point lv_indev_get_point() and the next read's
+    // movement vector start from, only LVGL's search and events are saved
+    indev->pointer.act_point = _pointer_point;
+    indev->pointer.last_point = _pointer_point;
+    indev->pointer.last_raw_point = _pointer_point;
+}
+
+static bool lvgl_raylib_input_narrow(lv_indev_t * indev) {
+    // LVGL searches the whole tree when a press starts, and for every sample dragged over an
+    // object without LV_OBJ_FLAG_PRESS_LOCK. The index finds the object first and LVGL's
+    // search only walks the path to it. A scroll or throw in progress keeps its object.
+    if (!lvgl_raylib_hit_is_active() || !lvgl_raylib_input_pending(&_pointer_queue)) return false;
+    const lvgl_raylib_input_event_t * event = &_pointer_queue.events[_pointer_queue.head & (LVGL_RAYLIB_INPUT_QUEUE_SIZE - 1)];
+    bool pressed = event->type == LVGL_RAYLIB_INPUT_EVENT_BUTTON_DOWN ||
+                   (_pointer_pressed && event->type != LVGL_RAYLIB_INPUT_EVENT_BUTTON_UP);
+    lv_obj_t * act = indev->pointer.act_obj;
+    if (!pressed || lv_indev_get_scroll_obj(indev) != NULL || (act != NULL && lv_obj_has_flag(act, LV_OBJ_FLAG_PRESS_LOCK))) {
+        return false;
+    }
+
+    lv_point_t point = { event->x, event->y };
+    lv_obj_t * found = lvgl_raylib_hit_narrow(&point);
+
+    // The first event after the search goes to the object found or the one pressed so far,
+    // the children are back before any handler runs
+    _narrow_objs[0] = found;
+    _narrow_objs[1] = act != found ? act : NULL;
+    for (int i = 0; i < 2; i++) {
+        if (_narrow_objs[i] != NULL) {
+            lv_obj_add_event_cb(_narrow_objs[i], lvgl_raylib_input_widen_cb, LV_EVENT_PREPROCESS, NULL);
+        }
+    }
+    return true;
+}
+
+static void lvgl_raylib_input_widen(void) {
+    lvgl_raylib_hit_widen();
+    for (int i = 0; i < 2; i++) {
+        if (_narrow_objs[i] != NULL) {
+            lv_obj_remove_event_cb(_narrow_objs[i], lvgl_raylib_input_widen_cb);
+            _narrow_objs[i] = NULL;
+        }
+    }
+}
+
+static void lvgl_raylib_input_widen_cb(lv_event_t * e) {
+    // Hit tests come from the search itself
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_HIT_TEST) return;
+
+    if (code == LV_EVENT_DELETE) {
+        lv_obj_t * obj = lv_event_get_current_target_obj(e);
+        for (int i = 0; i < 2; i++) {
+            if (_narrow_objs[i] == obj) _narrow_objs[i] = NULL;
+        }
+    }
+    lvgl_raylib_hit_widen();
+}
+
+#if defined(LVGL_RAYLIB_INPUT_GLFW)
+
+// raylib's callbacks run first, so GetMousePosition() already has its offset and scale applied
+
+static void lvgl_raylib_input_button_cb(GLFWwindow * window, int button, int action, int mods) {
+    if (_prev_button_cb) _prev_button_cb(window, button, action, mods);
+    if (button != GLFW_MOUSE_BUTTON_LEFT) return;
+    lvgl_raylib_input_push(&_pointer_queue, action == GLFW_PRESS ? LVGL_RAYLIB_INPUT_EVENT_BUTTON_DOWN : LVGL_RAYLIB_INPUT_EVENT_BUTTON_UP,
+                           GetMousePosition(), 0);
+}
+
+static void lvgl_raylib_input_cursor_pos_cb(GLFWwindow * window, double x, double y) {
+    if (_prev_cursor_pos_cb) _prev_cursor_pos_cb(window, x, y);
+    lvgl_raylib_input_push(&_pointer_queue, LVGL_RAYLIB_INPUT_EVENT_MOTION, GetMousePosition(), 0);
+}
+
+static void lvgl_raylib_input_scroll_cb(GLFWwindow * window, double x_offset, double y_offset) {
+    if (_prev_scroll_cb) _prev_scroll_cb(window, x_offset, y_offset);
+    if (y_offset == 0.0) return;
+    lvgl_raylib_input_push(&_pointer_queue, LVGL_RAYLIB_INPUT_EVENT_WHEEL, GetMousePosition(), (int32_t)(y_offset * 10.0));
+}
+
+static void lvgl_raylib_input_key_cb(GLFWwindow * window, int key, int scancode, int action, int mods) {
+    if (_prev_key_cb) _prev_key_cb(window, key, scancode, action, mods);
+    if (action == GLFW_RELEASE) return;
+    if (key == GLFW_KEY_V && (mods & (GLFW_MOD_CONTROL | GLFW_MOD_SUPER)) && action == GLFW_PRESS) {
+        lvgl_raylib_input_push(&_key_queue, LVGL_RAYLIB_INPUT_EVENT_PASTE, GetMousePosition(), 0);
+        return;
+    }
+    // raylib key codes are GLFW's, auto repeat arrives as GLFW_REPEAT
+    uint32_t lvgl_key = convert_control_key(key);
+    if (lvgl_key && lvgl_key != LV_KEY_ESC) { /* ignore ESC key */
+        lvgl_raylib_input_push(&_key_queue, LVGL_RAYLIB_INPUT_EVENT_KEY, GetMousePosition(), (int32_t)lvgl_key);
+    }
+}
+
+static void lvgl_raylib_input_char_cb(GLFWwindow * window, unsigned int codepoint) {
+    if (_prev_char_cb) _prev_char_cb(window, codepoint);
+    lvgl_raylib_input_push(&_key_queue, LVGL_RAYLIB_INPUT_EVENT_TEXT, GetMousePosition(), (int32_t)codepoint);
+}
+
+static void lvgl_raylib_input_glfw_install(void) {
+    _window = (GLFWwindow *)GetWindowHandle();
+    if (_window == NULL) {
+        TraceLog(LOG_WARNING, "LVGL Raylib: no GLFW window, input is sampled once per frame");
+        return;
+    }
+    _prev_button_cb = glfwSetMouseButtonCallback(_window, lvgl_raylib_input_button_cb);
+    _prev_cursor_pos_cb = glfwSetCursorPosCallback(_window, lvgl_raylib_input_cursor_pos_cb);
+    _prev_scroll_cb = glfwSetScrollCallback(_window, lvgl_raylib_input_scroll_cb);
+    _prev_key_cb = glfwSetKeyCallback(_window, lvgl_raylib_input_key_cb);
+    _prev_char_cb = glfwSetCharCallback(_window, lvgl_raylib_input_char_cb);
+}
+
+static void lvgl_raylib_input_glfw_uninstall(void) {
+    if (_window == NULL) return;
+    glfwSetMouseButtonCallback(_window, _prev_button_cb);
+    glfwSetCursorPosCallback(_window, _prev_cursor_pos_cb);
+    glfwSetScrollCallback(_window, _prev_scroll_cb);
+    glfwSetKeyCallback(_window, _prev_key_cb);
+    glfwSetCharCallback(_window, _prev_char_cb);
+    _window = NULL;
+}
+
+#endif
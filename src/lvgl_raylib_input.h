@@ -1,15 +1,58 @@
 #ifndef LVGL_RAYLIB_INPUT_H
 #define LVGL_RAYLIB_INPUT_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "lvgl.h"
 
+/* public defines */
+
+/** Events kept between two reads of an indev, a power of two */
+#define LVGL_RAYLIB_INPUT_QUEUE_SIZE 256
+
+/* public types */
+
+typedef enum {
+    LVGL_RAYLIB_INPUT_EVENT_MOTION,
+    LVGL_RAYLIB_INPUT_EVENT_BUTTON_DOWN,
+    LVGL_RAYLIB_INPUT_EVENT_BUTTON_UP,
+    LVGL_RAYLIB_INPUT_EVENT_WHEEL,
+    LVGL_RAYLIB_INPUT_EVENT_KEY,
+    LVGL_RAYLIB_INPUT_EVENT_TEXT,       // a typed character
+    LVGL_RAYLIB_INPUT_EVENT_PASTE,      // Ctrl+V or Cmd+V, the clipboard is read when inserted
+} lvgl_raylib_input_event_type_t;
+
+/** One input sample, in the order raylib (or GLFW below it) received them */
+typedef struct {
+    lvgl_raylib_input_event_type_t type;
+    int32_t x;                  // pointer position after the event
+    int32_t y;
+    int32_t value;              // wheel movement in tenths of a step, the LVGL key or the codepoint
+    uint32_t timestamp;         // ms on the lv_tick clock
+} lvgl_raylib_input_event_t;
+
+typedef struct {
+    lvgl_raylib_input_event_t events[LVGL_RAYLIB_INPUT_QUEUE_SIZE];
+    uint32_t head;              // next to read
+    uint32_t tail;              // next to write
+} lvgl_raylib_input_queue_t;
+
 typedef struct {
     lv_indev_t *mouse_indev;
     lv_indev_t *keyboard_indev;
     lv_group_t *group;
 } lvgl_raylib_input_t;
 
+/* public functions */
+
 void lvgl_raylib_input_create(lvgl_raylib_input_t *input);
+
+/** Queue what happened since the last frame when no callbacks capture it, before the reads */
+void lvgl_raylib_input_poll(void);
+
+/** Read the keys, then the pointer if anything changed or a press or throw is in progress, once per frame */
+void lvgl_raylib_input_update(lvgl_raylib_input_t *input);
+
 void lvgl_raylib_input_destroy(lvgl_raylib_input_t *input);
 
-#endif
\ No newline at end of file
+#endif
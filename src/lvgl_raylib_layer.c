@@ -0,0 +1,526 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <math.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_compose.h"
+#include "lvgl_raylib_layer.h"
+#include "lvgl_raylib_budget.h"
+
+/* private prototypes */
+
+static lvgl_raylib_layer_t * lvgl_raylib_layer_find(const lv_obj_t * obj);
+static void lvgl_raylib_layer_get_area(const lvgl_raylib_layer_t * layer, lv_area_t * area);
+static void lvgl_raylib_layer_invalidate(lv_obj_t * obj);
+static void lvgl_raylib_layer_invalidate_area(const lv_obj_t * obj, const lv_area_t * area);
+static void lvgl_raylib_layer_refresh_ext_draw_size(lv_obj_t * obj);
+static void lvgl_raylib_layer_rasterize(lvgl_raylib_layer_t * layer);
+static void lvgl_raylib_layer_update_cover(lvgl_raylib_layer_t * layer, bool rasterized);
+static Rectangle lvgl_raylib_layer_get_dest(const lvgl_raylib_layer_t * layer);
+static void lvgl_raylib_layer_get_dest_area(const lvgl_raylib_layer_t * layer, lv_area_t * area);
+static void lvgl_raylib_layer_drop_snapshot(lvgl_raylib_layer_t * layer);
+static void lvgl_raylib_layer_release(lvgl_raylib_layer_t * layer);
+static void lvgl_raylib_layer_draw_main_cb(lv_event_t * e);
+static void lvgl_raylib_layer_ext_draw_size_cb(lv_event_t * e);
+static void lvgl_raylib_layer_delete_cb(lv_event_t * e);
+static void lvgl_raylib_layer_invalidate_area_cb(lv_event_t * e);
+static bool lvgl_raylib_layer_skip_cb(const lv_obj_t * obj);
+static uint32_t lvgl_raylib_layer_budget_size_cb(void);
+
+/* static variables */
+
+static lvgl_raylib_display_t * _display = NULL;
+static lv_ll_t _layers;
+static bool _rasterizing = false;
+static bool _invalidating = false;
+static bool _capturing = false;
+
+// Promoted layers are drawn every frame, they count against the budget but never go
+static lvgl_raylib_budget_cache_t _budget = {
+    .name = "layers",
+    .cost = LVGL_RAYLIB_BUDGET_COST_RENDER,
+    .get_size_cb = &lvgl_raylib_layer_budget_size_cb,
+};
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_layer_init(lvgl_raylib_display_t * display)
+{
+    _display = display;
+    lv_ll_init(&_layers, sizeof(lvgl_raylib_layer_t));
+    lv_display_add_event_cb(display->disp, &lvgl_raylib_layer_invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lvgl_raylib_compose_set_skip_cb(&lvgl_raylib_layer_skip_cb);
+    lvgl_raylib_budget_register(&_budget);
+}
+
+void lvgl_raylib_layer_promote(lv_obj_t * obj)
+{
+    if (lvgl_raylib_layer_find(obj) != NULL) {
+        return;
+    }
+
+    lvgl_raylib_layer_t * layer = lv_ll_ins_tail(&_layers);
+    if (layer == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate LVGL Raylib layer");
+        return;
+    }
+
+    lv_memzero(layer, sizeof(*layer));
+    layer->obj = obj;
+    layer->scale = 1.0f;
+    layer->opa = LV_OPA_COVER;
+    layer->dirty = true;
+    layer->ext = lv_obj_get_ext_draw_size(obj);
+
+    lv_obj_add_event_cb(obj, &lvgl_raylib_layer_draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_layer_ext_draw_size_cb, LV_EVENT_REFR_EXT_DRAW_SIZE, NULL);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_layer_delete_cb, LV_EVENT_DELETE, NULL);
+    lvgl_raylib_layer_rasterize(layer);
+
+    // From now on the display is drawn without the subtree
+    lvgl_raylib_layer_invalidate(obj);
+}
+
+void lvgl_raylib_layer_demote(lv_obj_t * obj)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(obj);
+    if (layer == NULL) {
+        return;
+    }
+
+    lv_obj_remove_event_cb_with_user_data(obj, &lvgl_raylib_layer_draw_main_cb, NULL);
+    lv_obj_remove_event_cb_with_user_data(obj, &lvgl_raylib_layer_ext_draw_size_cb, NULL);
+    lv_obj_remove_event_cb_with_user_data(obj, &lvgl_raylib_layer_delete_cb, NULL);
+    bool covered = layer->covered;
+    if (covered) {
+        lvgl_raylib_layer_invalidate_area(obj, &layer->drawn);
+    }
+    lvgl_raylib_layer_release(layer);
+    if (covered) {
+        lvgl_raylib_layer_refresh_ext_draw_size(obj);
+    }
+    lvgl_raylib_layer_invalidate(obj);
+}
+
+void lvgl_raylib_layer_set_offset(lv_obj_t * obj, float x, float y)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(obj);
+    if (layer != NULL) {
+        layer->offset_x = x;
+        layer->offset_y = y;
+    }
+}
+
+void lvgl_raylib_layer_set_scale(lv_obj_t * obj, float scale)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(obj);
+    if (layer != NULL) {
+        layer->scale = scale;
+    }
+}
+
+void lvgl_raylib_layer_set_opa(lv_obj_t * obj, lv_opa_t opa)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(obj);
+    if (layer != NULL) {
+        layer->opa = opa;
+    }
+}
+
+void lvgl_raylib_layer_anim_x_cb(void * obj, int32_t value)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(obj);
+    if (layer != NULL) {
+        layer->offset_x = (float)value;
+    }
+}
+
+void lvgl_raylib_layer_anim_y_cb(void * obj, int32_t value)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(obj);
+    if (layer != NULL) {
+        layer->offset_y = (float)value;
+    }
+}
+
+void lvgl_raylib_layer_anim_scale_cb(void * obj, int32_t value)
+{
+    lvgl_raylib_layer_set_scale(obj, (float)value / LV_SCALE_NONE);
+}
+
+void lvgl_raylib_layer_anim_opa_cb(void * obj, int32_t value)
+{
+    lvgl_raylib_layer_set_opa(obj, (lv_opa_t)LV_CLAMP(LV_OPA_TRANSP, value, LV_OPA_COVER));
+}
+
+void lvgl_raylib_layer_update(void)
+{
+    // Content changes are picked up once per frame, after LVGL processed its timers.
+    // Moving the object, e.g. by scrolling its parent, only moves the texture.
+    lvgl_raylib_layer_t * layer;
+    LV_LL_READ(&_layers, layer) {
+        if (!layer->dirty) {
+            lv_area_t area;
+            lvgl_raylib_layer_get_area(layer, &area);
+            if (lv_area_get_width(&area) != lv_area_get_width(&layer->area)
+                || lv_area_get_height(&area) != lv_area_get_height(&layer->area)) {
+                layer->dirty = true;
+            } else {
+                layer->area = area;
+            }
+        }
+        bool rasterized = layer->dirty;
+        if (layer->dirty) {
+            lvgl_raylib_layer_rasterize(layer);
+        }
+        lvgl_raylib_layer_update_cover(layer, rasterized);
+    }
+}
+
+void lvgl_raylib_layer_render(const lvgl_raylib_display_t * display)
+{
+    lvgl_raylib_layer_t * layer;
+    LV_LL_READ(&_layers, layer) {
+        // Covered layers are drawn by LVGL, under the objects above them
+        if (layer->texture.id == 0 || layer->opa <= LV_OPA_MIN || layer->covered) {
+            continue;
+        }
+
+        // Layers are clipped like their parent clips the object
+        lv_area_t clip;
+        lv_obj_t * parent = lv_obj_get_parent(layer->obj);
+        if (lv_obj_has_flag(layer->obj, LV_OBJ_FLAG_HIDDEN)) {
+            continue;
+        }
+        if (parent != NULL) {
+            if (!lvgl_raylib_compose_get_clip(parent, &clip)) {
+                continue;
+            }
+        } else {
+            if (layer->obj != lv_screen_active()) {
+                continue;
+            }
+            clip = (lv_area_t){ 0, 0, display->raylib_img.width - 1, display->raylib_img.height - 1 };
+        }
+
+        Rectangle dst = lvgl_raylib_layer_get_dest(layer);
+        lv_area_t dst_area;
+        lvgl_raylib_layer_get_dest_area(layer, &dst_area);
+        if (!lv_area_intersect(&clip, &clip, &dst_area)) {
+            continue;
+        }
+
+        // Nothing is above the layer here, it goes over the LVGL texture
+        Rectangle src = { 0, 0, (float)layer->texture.width, (float)layer->texture.height };
+        BeginScissorMode(clip.x1, clip.y1, lv_area_get_width(&clip), lv_area_get_height(&clip));
+        DrawTexturePro(layer->texture, src, dst, (Vector2){ 0, 0 }, 0.0f, Fade(WHITE, layer->opa / 255.0f));
+        EndScissorMode();
+    }
+}
+
+void lvgl_raylib_layer_capture_begin(void)
+{
+    // Snapshots taken meanwhile show every layer with its transform, not only covered ones
+    _capturing = true;
+}
+
+void lvgl_raylib_layer_capture_end(void)
+{
+    _capturing = false;
+}
+
+void lvgl_raylib_layer_deinit(void)
+{
+    lvgl_raylib_budget_unregister(&_budget);
+    lvgl_raylib_layer_t * layer;
+    LV_LL_READ(&_layers, layer) {
+        if (layer->texture.id != 0) {
+            UnloadTexture(layer->texture);
+        }
+        lvgl_raylib_layer_drop_snapshot(layer);
+    }
+    lv_ll_clear(&_layers);
+
+    if (_display != NULL && _display->disp != NULL) {
+        lv_display_remove_event_cb_with_user_data(_display->disp, &lvgl_raylib_layer_invalidate_area_cb, NULL);
+    }
+    lvgl_raylib_compose_set_skip_cb(NULL);
+    _display = NULL;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_layer_t * lvgl_raylib_layer_find(const lv_obj_t * obj)
+{
+    lvgl_raylib_layer_t * layer;
+    LV_LL_READ(&_layers, layer) {
+        if (layer->obj == obj) {
+            return layer;
+        }
+    }
+    return NULL;
+}
+
+static void lvgl_raylib_layer_get_area(const lvgl_raylib_layer_t * layer, lv_area_t * area)
+{
+    // What a snapshot covers: the object's coordinates plus its own extra draw size,
+    // not the room a covered layer reserves for its transform
+    lv_obj_get_coords(layer->obj, area);
+    lv_area_increase(area, layer->ext, layer->ext);
+}
+
+static void lvgl_raylib_layer_invalidate(lv_obj_t * obj)
+{
+    // Redraws the display around the object, that isn't a change of its content
+    _invalidating = true;
+    lv_obj_invalidate(obj);
+    _invalidating = false;
+}
+
+static void lvgl_raylib_layer_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
+{
+    // The transformed layer may reach outside of the object and its parent
+    _invalidating = true;
+    lv_inv_area(lv_obj_get_display(obj), area);
+    _invalidating = false;
+}
+
+static void lvgl_raylib_layer_refresh_ext_draw_size(lv_obj_t * obj)
+{
+    // Invalidates the object if the size changes
+    _invalidating = true;
+    lv_obj_refresh_ext_draw_size(obj);
+    _invalidating = false;
+}
+
+static void lvgl_raylib_layer_rasterize(lvgl_raylib_layer_t * layer)
+{
+    // The snapshot draws the subtree the display skips; a layout update may invalidate it.
+    // A covered layer's extra draw size holds its transform, the snapshot needs its own.
+    _rasterizing = true;
+    lv_obj_update_layout(layer->obj);
+    if (layer->covered) {
+        lv_obj_refresh_ext_draw_size(layer->obj);
+    }
+    lv_draw_buf_t * snapshot = lv_snapshot_take(layer->obj, LV_COLOR_FORMAT_ARGB8888);
+    _rasterizing = false;
+    if (layer->covered) {
+        lvgl_raylib_layer_refresh_ext_draw_size(layer->obj);
+    }
+
+    layer->dirty = false;
+    if (snapshot == NULL) {
+        TraceLog(LOG_ERROR, "Failed to rasterize LVGL Raylib layer");
+        return;
+    }
+
+    int32_t w = (int32_t)snapshot->header.w;
+    int32_t h = (int32_t)snapshot->header.h;
+    lvgl_raylib_layer_get_area(layer, &layer->area);
+
+    // Kept for LVGL to draw the layer while other objects cover it
+    lvgl_raylib_layer_drop_snapshot(layer);
+    layer->snapshot = snapshot;
+
+    uint8_t * pixels = malloc((size_t)w * h * 4);
+    if (pixels == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate LVGL Raylib layer pixels");
+        return;
+    }
+    lvgl_raylib_display_convert_argb8888(pixels, (uint32_t)w * 4, snapshot->data, snapshot->header.stride, (uint32_t)w, (uint32_t)h);
+
+    if (layer->texture.id != 0 && (layer->texture.width != w || layer->texture.height != h)) {
+        UnloadTexture(layer->texture);
+        layer->texture.id = 0;
+    }
+    if (layer->texture.id == 0) {
+        Image image = { pixels, w, h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        layer->texture = LoadTextureFromImage(image);
+        SetTextureFilter(layer->texture, TEXTURE_FILTER_BILINEAR);
+    } else {
+        UpdateTexture(layer->texture, pixels);
+    }
+    free(pixels);
+}
+
+static void lvgl_raylib_layer_update_cover(lvgl_raylib_layer_t * layer, bool rasterized)
+{
+    // Drawn on top of the LVGL texture the layer would hide the objects above it. While any
+    // overlaps it, LVGL draws the snapshot in z-order with the transform instead.
+    lv_area_t dest;
+    lvgl_raylib_layer_get_dest_area(layer, &dest);
+    bool covered = layer->snapshot != NULL && !lv_obj_has_flag(layer->obj, LV_OBJ_FLAG_HIDDEN)
+                   && lvgl_raylib_compose_is_covered(layer->obj, &dest);
+    if (!covered && !layer->covered) {
+        return;
+    }
+    if (covered && layer->covered && !rasterized && layer->opa == layer->drawn_opa && lv_area_is_equal(&dest, &layer->drawn)) {
+        return;
+    }
+
+    if (layer->covered) {
+        lvgl_raylib_layer_invalidate_area(layer->obj, &layer->drawn);
+    }
+    layer->covered = covered;
+    layer->drawn = dest;
+    layer->drawn_opa = layer->opa;
+    lvgl_raylib_layer_refresh_ext_draw_size(layer->obj);
+    if (covered) {
+        lvgl_raylib_layer_invalidate_area(layer->obj, &dest);
+    }
+}
+
+static Rectangle lvgl_raylib_layer_get_dest(const lvgl_raylib_layer_t * layer)
+{
+    // Scale around the center like LVGL's transform pivot default
+    float w = (float)lv_area_get_width(&layer->area);
+    float h = (float)lv_area_get_height(&layer->area);
+    float cx = layer->area.x1 + w / 2.0f + layer->offset_x;
+    float cy = layer->area.y1 + h / 2.0f + layer->offset_y;
+
+    return (Rectangle){ cx - w * layer->scale / 2.0f, cy - h * layer->scale / 2.0f, w * layer->scale, h * layer->scale };
+}
+
+static void lvgl_raylib_layer_get_dest_area(const lvgl_raylib_layer_t * layer, lv_area_t * area)
+{
+    // Rounded outwards, the edge pixels are partly covered
+    Rectangle dst = lvgl_raylib_layer_get_dest(layer);
+    area->x1 = (int32_t)floorf(dst.x);
+    area->y1 = (int32_t)floorf(dst.y);
+    area->x2 = (int32_t)ceilf(dst.x + dst.width);
+    area->y2 = (int32_t)ceilf(dst.y + dst.height);
+}
+
+static void lvgl_raylib_layer_drop_snapshot(lvgl_raylib_layer_t * layer)
+{
+    if (layer->snapshot == NULL) {
+        return;
+    }
+
+    // The image caches know it by its address, a new snapshot may get the same one
+    lv_image_cache_drop(layer->snapshot);
+    lvgl_raylib_draw_gpu_image_drop(layer->snapshot);
+    lv_draw_buf_destroy(layer->snapshot);
+    layer->snapshot = NULL;
+}
+
+static void lvgl_raylib_layer_release(lvgl_raylib_layer_t * layer)
+{
+    if (layer->texture.id != 0) {
+        UnloadTexture(layer->texture);
+    }
+    lvgl_raylib_layer_drop_snapshot(layer);
+    lv_ll_remove(&_layers, layer);
+    lv_free(layer);
+}
+
+static void lvgl_raylib_layer_draw_main_cb(lv_event_t * e)
+{
+    // The subtree's own tasks are dropped, this one has no object and is kept
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(lv_event_get_target(e));
+    if (layer == NULL || (!layer->covered && !_capturing) || _rasterizing || layer->snapshot == NULL) {
+        return;
+    }
+
+    int32_t scale = (int32_t)(layer->scale * LV_SCALE_NONE);
+    if (scale <= 0) {
+        return;
+    }
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.src = layer->snapshot;
+    dsc.opa = layer->opa;
+    dsc.scale_x = scale;
+    dsc.scale_y = scale;
+    dsc.pivot.x = lv_area_get_width(&layer->area) / 2;
+    dsc.pivot.y = lv_area_get_height(&layer->area) / 2;
+    dsc.antialias = true;
+
+    lv_area_t coords = layer->area;
+    lv_area_move(&coords, (int32_t)lroundf(layer->offset_x), (int32_t)lroundf(layer->offset_y));
+    lv_draw_image(lv_event_get_layer(e), &dsc, &coords);
+}
+
+static void lvgl_raylib_layer_ext_draw_size_cb(lv_event_t * e)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(lv_event_get_target(e));
+    if (layer == NULL) {
+        return;
+    }
+
+    // The object's own size comes first, a covered layer adds room for its transform,
+    // LVGL only redraws and clips the object within it
+    layer->ext = *(int32_t *)lv_event_get_param(e);
+    if (!layer->covered || _rasterizing) {
+        return;
+    }
+
+    lv_area_t coords;
+    lv_area_t dest;
+    lv_obj_get_coords(layer->obj, &coords);
+    lvgl_raylib_layer_get_dest_area(layer, &dest);
+    int32_t ext = LV_MAX(LV_MAX(coords.x1 - dest.x1, dest.x2 - coords.x2), LV_MAX(coords.y1 - dest.y1, dest.y2 - coords.y2));
+    lv_event_set_ext_draw_size(e, ext);
+}
+
+static void lvgl_raylib_layer_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_layer_t * layer = lvgl_raylib_layer_find(lv_event_get_target(e));
+    if (layer != NULL) {
+        lvgl_raylib_layer_release(layer);
+    }
+}
+
+static void lvgl_raylib_layer_invalidate_area_cb(lv_event_t * e)
+{
+    if (_rasterizing || _invalidating) {
+        return;
+    }
+
+    // LVGL doesn't tell which object invalidated an area, but objects of the subtree are
+    // clipped to the layer's area. Larger areas come from the parent or other objects
+    // around it, e.g. an animated background, and don't change the layer's content.
+    const lv_area_t * area = lv_event_get_invalidated_area(e);
+    lvgl_raylib_layer_t * layer;
+    LV_LL_READ(&_layers, layer) {
+        lv_area_t layer_area;
+        int32_t ext = lv_obj_get_ext_draw_size(layer->obj);
+        lv_obj_get_coords(layer->obj, &layer_area);
+        lv_area_increase(&layer_area, ext, ext);
+        if (lv_area_is_in(area, &layer_area, 0)) {
+            layer->dirty = true;
+        }
+    }
+}
+
+static bool lvgl_raylib_layer_skip_cb(const lv_obj_t * obj)
+{
+    // The texture stands in for the subtree, only the snapshot draws it
+    if (_rasterizing) {
+        return false;
+    }
+
+    for (const lv_obj_t * cur = obj; cur != NULL; cur = lv_obj_get_parent(cur)) {
+        if (lvgl_raylib_layer_find(cur) != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t lvgl_raylib_layer_budget_size_cb(void)
+{
+    uint32_t size = 0;
+    lvgl_raylib_layer_t * layer;
+    LV_LL_READ(&_layers, layer) {
+        if (layer->texture.id != 0) {
+            size += (uint32_t)layer->texture.width * layer->texture.height * 4;
+        }
+        if (layer->snapshot != NULL) {
+            size += layer->snapshot->data_size;
+        }
+    }
+    return size;
+}
@@ -0,0 +1,36 @@
+#ifndef LVGL_RAYLIB_LAYER_H
+#define LVGL_RAYLIB_LAYER_H
+
+#include <stdbool.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib_display.h"
+
+/* public types */
+
+typedef struct {
+    lv_obj_t * obj;
+    Texture2D texture;
+    lv_draw_buf_t * snapshot;   // the texture's pixels, LVGL draws them while the layer is covered
+    lv_area_t area;             // screen area the texture was rasterized from
+    int32_t ext;                // the object's extra draw size without the transform
+    bool dirty;
+    bool covered;               // objects above overlap it, LVGL draws it in z-order
+    lv_area_t drawn;            // where LVGL draws the covered layer
+    lv_opa_t drawn_opa;
+    float offset_x;
+    float offset_y;
+    float scale;
+    lv_opa_t opa;
+} lvgl_raylib_layer_t;
+
+/* public functions */
+
+void lvgl_raylib_layer_init(lvgl_raylib_display_t * display);
+void lvgl_raylib_layer_update(void);
+void lvgl_raylib_layer_render(const lvgl_raylib_display_t * display);
+void lvgl_raylib_layer_capture_begin(void);
+void lvgl_raylib_layer_capture_end(void);
+void lvgl_raylib_layer_deinit(void);
+
+#endif
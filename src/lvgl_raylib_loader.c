@@ -0,0 +1,529 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_decoder.h"
+#include "lvgl_raylib_loader.h"
+#include "lvgl_raylib_mem.h"
+
+#if LV_USE_OS != LV_OS_NONE
+
+/* private defines */
+
+// Ancestors checked for scrollable content once per update
+#define LVGL_RAYLIB_LOADER_MEMO_CNT 4
+
+/* private prototypes */
+
+static bool lvgl_raylib_loader_start(void);
+static void lvgl_raylib_loader_thread_cb(void * user_data);
+static lvgl_raylib_loader_image_t * lvgl_raylib_loader_find(const lv_obj_t * obj);
+static void lvgl_raylib_loader_detach(lv_obj_t * obj);
+static void lvgl_raylib_loader_finish(lvgl_raylib_loader_image_t * image);
+static bool lvgl_raylib_loader_schedule(lvgl_raylib_loader_image_t * image);
+static lv_obj_t * lvgl_raylib_loader_get_view(lv_obj_t * obj);
+static bool lvgl_raylib_loader_peek_size(const char * path, int32_t * w, int32_t * h);
+static void lvgl_raylib_loader_free(lvgl_raylib_loader_image_t * image);
+static void lvgl_raylib_loader_draw_cb(lv_event_t * e);
+static void lvgl_raylib_loader_delete_cb(lv_event_t * e);
+
+/* static variables */
+
+// The list is only changed by the UI thread with the mutex held. The decoding thread
+// walks it and writes state and results under the mutex, so the UI thread may read
+// the fields it owns without locking.
+static lv_ll_t _images;
+static lv_mutex_t _mutex;
+static lv_thread_sync_t _sync;
+static lv_thread_t _thread;
+static bool _running = false;
+static bool _quit = false;
+static lvgl_raylib_loader_stats_t _stats = {0};
+
+static struct {
+    lv_obj_t * obj;
+    bool scrolls;
+} _memo[LVGL_RAYLIB_LOADER_MEMO_CNT];
+static uint32_t _memo_cnt = 0;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_loader_init(void)
+{
+    lv_ll_init(&_images, sizeof(lvgl_raylib_loader_image_t));
+}
+
+void lvgl_raylib_loader_set_src(lv_obj_t * obj, const char * path, lv_color_t placeholder)
+{
+    if (lvgl_raylib_loader_find(obj) != NULL) {
+        lv_obj_remove_event_cb(obj, &lvgl_raylib_loader_draw_cb);
+        lv_obj_remove_event_cb(obj, &lvgl_raylib_loader_delete_cb);
+        lvgl_raylib_loader_detach(obj);
+    }
+
+    // Decoded before, or no thread to decode on: nothing to wait for
+    if (lvgl_raylib_decoder_is_cached(path, LV_IMAGE_SRC_FILE) || !lvgl_raylib_loader_start()) {
+        lv_image_set_src(obj, path);
+        return;
+    }
+
+    // The decoding thread may still hold the entry after the object is gone
+    lv_mutex_lock(&_mutex);
+    lvgl_raylib_mem_main_begin();
+    lvgl_raylib_loader_image_t * image = lv_ll_ins_tail(&_images);
+    if (image != NULL) {
+        memset(image, 0, sizeof(*image));
+        image->obj = obj;
+        image->path = lv_strdup(path);
+        image->placeholder = placeholder;
+        image->state = LVGL_RAYLIB_LOADER_IDLE;
+    }
+    lvgl_raylib_mem_main_end();
+    lv_mutex_unlock(&_mutex);
+    if (image == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate async image entry");
+        lv_image_set_src(obj, path);
+        return;
+    }
+
+    // Reserve the final size up front so the layout, and with it prefetching, is right
+    lv_image_set_src(obj, NULL);
+    int32_t w, h;
+    if (lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT
+        && lv_obj_get_style_height(obj, LV_PART_MAIN) == LV_SIZE_CONTENT
+        && lvgl_raylib_loader_peek_size(path, &w, &h)) {
+        lv_obj_set_size(obj, w, h);
+        image->sized = true;
+    }
+    lv_obj_add_event_cb(obj, &lvgl_raylib_loader_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_loader_delete_cb, LV_EVENT_DELETE, NULL);
+    lv_obj_invalidate(obj);
+}
+
+void lvgl_raylib_loader_get_stats(lvgl_raylib_loader_stats_t * stats)
+{
+    *stats = _stats;
+    stats->pending = lv_ll_get_len(&_images);
+}
+
+void lvgl_raylib_loader_update(void)
+{
+    if (!_running) {
+        return;
+    }
+
+    // Results are unlinked first, setting the source runs LVGL code that must not hold the mutex
+    while (true) {
+        lvgl_raylib_loader_image_t * done = NULL;
+        lvgl_raylib_loader_image_t * image;
+        lv_mutex_lock(&_mutex);
+        LV_LL_READ(&_images, image) {
+            if (image->state != LVGL_RAYLIB_LOADER_DECODED) {
+                continue;
+            }
+            if (image->obj != NULL && image->cancelled && image->ok) {
+                // Scrolled away meanwhile, decoded again once it comes back
+                UnloadImage(image->result);
+                image->ok = false;
+                image->state = LVGL_RAYLIB_LOADER_IDLE;
+                continue;
+            }
+            done = image;
+            break;
+        }
+        if (done != NULL) {
+            lv_ll_remove(&_images, done);
+        }
+        lv_mutex_unlock(&_mutex);
+        if (done == NULL) {
+            break;
+        }
+        lvgl_raylib_loader_finish(done);
+    }
+
+    bool wake = false;
+    _memo_cnt = 0;
+    lv_mutex_lock(&_mutex);
+    lvgl_raylib_loader_image_t * image;
+    LV_LL_READ(&_images, image) {
+        if (image->obj != NULL) {
+            wake |= lvgl_raylib_loader_schedule(image);
+        }
+    }
+    lv_mutex_unlock(&_mutex);
+
+    if (wake) {
+        lv_thread_sync_signal(&_sync);
+    }
+}
+
+void lvgl_raylib_loader_deinit(void)
+{
+    if (_running) {
+        lv_mutex_lock(&_mutex);
+        _quit = true;
+        lv_mutex_unlock(&_mutex);
+        lv_thread_sync_signal(&_sync);
+        lv_thread_delete(&_thread);
+        lv_thread_sync_delete(&_sync);
+        lv_mutex_delete(&_mutex);
+        _running = false;
+        _quit = false;
+    }
+
+    lvgl_raylib_loader_image_t * image = lv_ll_get_head(&_images);
+    while (image != NULL) {
+        lvgl_raylib_loader_image_t * next = lv_ll_get_next(&_images, image);
+        if (image->obj != NULL) {
+            lv_obj_remove_event_cb(image->obj, &lvgl_raylib_loader_draw_cb);
+            lv_obj_remove_event_cb(image->obj, &lvgl_raylib_loader_delete_cb);
+        }
+        lv_ll_remove(&_images, image);
+        lvgl_raylib_loader_free(image);
+        image = next;
+    }
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool lvgl_raylib_loader_start(void)
+{
+    if (_running) {
+        return true;
+    }
+
+    // The thread only exists once an application loads something asynchronously
+    lv_mutex_init(&_mutex);
+    lv_thread_sync_init(&_sync);
+#if LV_VERSION_CHECK(9, 3, 0)
+    lv_result_t res = lv_thread_init(&_thread, "lvgl_raylib_loader", LV_THREAD_PRIO_LOW, &lvgl_raylib_loader_thread_cb, LVGL_RAYLIB_LOADER_STACK_SIZE, NULL);
+#else
+    lv_result_t res = lv_thread_init(&_thread, LV_THREAD_PRIO_LOW, &lvgl_raylib_loader_thread_cb, LVGL_RAYLIB_LOADER_STACK_SIZE, NULL);
+#endif
+    if (res != LV_RESULT_OK) {
+        TraceLog(LOG_WARNING, "Failed to start image decoding thread, decoding synchronously");
+        lv_thread_sync_delete(&_sync);
+        lv_mutex_delete(&_mutex);
+        return false;
+    }
+    _running = true;
+    return true;
+}
+
+static void lvgl_raylib_loader_thread_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+    while (true) {
+        lvgl_raylib_loader_image_t * next = NULL;
+        lvgl_raylib_loader_image_t * image;
+        lv_mutex_lock(&_mutex);
+        if (_quit) {
+            lv_mutex_unlock(&_mutex);
+            break;
+        }
+        LV_LL_READ(&_images, image) {
+            if (image->state == LVGL_RAYLIB_LOADER_QUEUED && (next == NULL || image->priority < next->priority)) {
+                next = image;
+            }
+        }
+        if (next != NULL) {
+            next->state = LVGL_RAYLIB_LOADER_DECODING;
+            next->cancelled = false;
+        }
+        lv_mutex_unlock(&_mutex);
+
+        if (next == NULL) {
+            lv_thread_sync_wait(&_sync);
+            continue;
+        }
+
+        // The path is not touched by the UI thread while the entry is decoding
+        double start = GetTime();
+        Image result = { 0 };
+        bool ok = lvgl_raylib_decoder_load(next->path, LV_IMAGE_SRC_FILE, &result);
+
+        lv_mutex_lock(&_mutex);
+        next->ok = ok;
+        next->result = result;
+        next->decode_ms = (float)((GetTime() - start) * 1000.0);
+        next->state = LVGL_RAYLIB_LOADER_DECODED;
+        lv_mutex_unlock(&_mutex);
+    }
+}
+
+static lvgl_raylib_loader_image_t * lvgl_raylib_loader_find(const lv_obj_t * obj)
+{
+    lvgl_raylib_loader_image_t * image;
+    LV_LL_READ(&_images, image) {
+        if (image->obj == obj) {
+            return image;
+        }
+    }
+    return NULL;
+}
+
+static void lvgl_raylib_loader_detach(lv_obj_t * obj)
+{
+    lvgl_raylib_loader_image_t * image = lvgl_raylib_loader_find(obj);
+    if (image == NULL) {
+        return;
+    }
+
+    lv_mutex_lock(&_mutex);
+    if (image->state == LVGL_RAYLIB_LOADER_DECODING) {
+        // The decoding thread still owns it, the result is dropped by the next update
+        image->obj = NULL;
+        image->cancelled = true;
+        image = NULL;
+    } else {
+        lv_ll_remove(&_images, image);
+    }
+    lv_mutex_unlock(&_mutex);
+
+    if (image != NULL) {
+        if (image->state != LVGL_RAYLIB_LOADER_DECODED) {
+            _stats.cancelled++;
+        }
+        lvgl_raylib_loader_free(image);
+    }
+}
+
+static void lvgl_raylib_loader_finish(lvgl_raylib_loader_image_t * image)
+{
+    lv_obj_t * obj = image->obj;
+    if (obj == NULL) {
+        _stats.cancelled++;
+        lvgl_raylib_loader_free(image);
+        return;
+    }
+
+    lv_obj_remove_event_cb(obj, &lvgl_raylib_loader_draw_cb);
+    lv_obj_remove_event_cb(obj, &lvgl_raylib_loader_delete_cb);
+
+    if (image->ok && lvgl_raylib_decoder_insert(image->path, LV_IMAGE_SRC_FILE, &image->result, image->decode_ms)) {
+        // Setting the source invalidates just the image, its size is already reserved
+        image->ok = false;
+        lv_image_set_src(obj, image->path);
+        if (image->sized) {
+            lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        }
+        _stats.decoded++;
+    } else {
+        TraceLog(LOG_WARNING, "Failed to decode image %s", image->path);
+        image->ok = false;
+        lv_obj_invalidate(obj);
+        _stats.failed++;
+    }
+    lvgl_raylib_loader_free(image);
+}
+
+static bool lvgl_raylib_loader_schedule(lvgl_raylib_loader_image_t * image)
+{
+    lv_obj_t * obj = image->obj;
+    lv_obj_t * screen = lv_obj_get_screen(obj);
+    bool shown = !lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)
+                 && (screen == lv_screen_active() || screen == lv_layer_top() || screen == lv_layer_sys());
+
+    // Look ahead in the direction the nearest scrolling ancestor last moved
+    lv_area_t view;
+    lv_obj_get_coords(screen, &view);
+    lv_obj_t * scroller = lvgl_raylib_loader_get_view(obj);
+    if (scroller != image->view) {
+        image->view = scroller;
+        image->dir_x = image->dir_y = 0;
+        image->scroll_x = scroller != NULL ? lv_obj_get_scroll_x(scroller) : 0;
+        image->scroll_y = scroller != NULL ? lv_obj_get_scroll_y(scroller) : 0;
+    }
+    lv_area_t window = view;
+    if (scroller != NULL) {
+        lv_area_t scroller_area;
+        lv_obj_get_coords(scroller, &scroller_area);
+        if (!lv_area_intersect(&view, &view, &scroller_area)) {
+            shown = false;
+        }
+        window = view;
+
+        int32_t scroll_x = lv_obj_get_scroll_x(scroller);
+        int32_t scroll_y = lv_obj_get_scroll_y(scroller);
+        if (scroll_x != image->scroll_x) {
+            image->dir_x = scroll_x > image->scroll_x ? 1 : -1;
+        }
+        if (scroll_y != image->scroll_y) {
+            image->dir_y = scroll_y > image->scroll_y ? 1 : -1;
+        }
+        image->scroll_x = scroll_x;
+        image->scroll_y = scroll_y;
+
+        int32_t ahead_x = lv_area_get_width(&view) * LVGL_RAYLIB_LOADER_PREFETCH;
+        int32_t ahead_y = lv_area_get_height(&view) * LVGL_RAYLIB_LOADER_PREFETCH;
+        if (image->dir_x > 0) window.x2 += ahead_x;
+        if (image->dir_x < 0) window.x1 -= ahead_x;
+        if (image->dir_y > 0) window.y2 += ahead_y;
+        if (image->dir_y < 0) window.y1 -= ahead_y;
+    }
+    lv_area_increase(&window, LVGL_RAYLIB_LOADER_MARGIN, LVGL_RAYLIB_LOADER_MARGIN);
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    bool near = shown && lv_area_is_on(&window, &coords);
+
+    switch (image->state) {
+        case LVGL_RAYLIB_LOADER_IDLE:
+        case LVGL_RAYLIB_LOADER_QUEUED:
+            if (!near) {
+                if (image->state == LVGL_RAYLIB_LOADER_QUEUED) {
+                    image->state = LVGL_RAYLIB_LOADER_IDLE;
+                    _stats.cancelled++;
+                }
+                return false;
+            }
+            image->priority = LV_MAX(LV_MAX(view.y1 - coords.y2, coords.y1 - view.y2), LV_MAX(view.x1 - coords.x2, coords.x1 - view.x2));
+            image->priority = LV_MAX(image->priority, 0);
+            if (image->state == LVGL_RAYLIB_LOADER_IDLE) {
+                image->state = LVGL_RAYLIB_LOADER_QUEUED;
+                _stats.queued++;
+                return true;
+            }
+            return false;
+        case LVGL_RAYLIB_LOADER_DECODING:
+            // Can't be interrupted, only its result is dropped
+            if (!near && !image->cancelled) {
+                _stats.cancelled++;
+            }
+            image->cancelled = !near;
+            return false;
+        default:
+            return false;
+    }
+}
+
+static lv_obj_t * lvgl_raylib_loader_get_view(lv_obj_t * obj)
+{
+    // Nearest ancestor whose content overflows; computing that walks its children, so
+    // the answers are kept for the rest of the update as siblings share ancestors
+    for (lv_obj_t * parent = lv_obj_get_parent(obj); parent != NULL; parent = lv_obj_get_parent(parent)) {
+        if (!lv_obj_has_flag(parent, LV_OBJ_FLAG_SCROLLABLE)) {
+            continue;
+        }
+
+        int32_t memo = -1;
+        for (uint32_t i = 0; i < _memo_cnt; i++) {
+            if (_memo[i].obj == parent) {
+                memo = (int32_t)i;
+                break;
+            }
+        }
+        bool scrolls;
+        if (memo >= 0) {
+            scrolls = _memo[memo].scrolls;
+        } else {
+            scrolls = lv_obj_get_scroll_top(parent) > 0 || lv_obj_get_scroll_bottom(parent) > 0
+                      || lv_obj_get_scroll_left(parent) > 0 || lv_obj_get_scroll_right(parent) > 0;
+            if (_memo_cnt < LVGL_RAYLIB_LOADER_MEMO_CNT) {
+                _memo[_memo_cnt].obj = parent;
+                _memo[_memo_cnt].scrolls = scrolls;
+                _memo_cnt++;
+            }
+        }
+        if (scrolls) {
+            return parent;
+        }
+    }
+    return NULL;
+}
+
+static bool lvgl_raylib_loader_peek_size(const char * path, int32_t * w, int32_t * h)
+{
+    lv_fs_file_t file;
+    if (lv_fs_open(&file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        return false;
+    }
+    uint8_t d[26] = {0};
+    uint32_t read = 0;
+    lv_fs_res_t res = lv_fs_read(&file, d, sizeof(d), &read);
+    lv_fs_close(&file);
+    if (res != LV_FS_RES_OK || read < 10) {
+        return false;
+    }
+
+    // Only formats with the size at a fixed offset, the rest resize once decoded
+    if (read >= 24 && d[0] == 0x89 && d[1] == 'P' && d[2] == 'N' && d[3] == 'G') {
+        *w = (int32_t)((d[16] << 24) | (d[17] << 16) | (d[18] << 8) | d[19]);
+        *h = (int32_t)((d[20] << 24) | (d[21] << 16) | (d[22] << 8) | d[23]);
+    } else if (read >= 12 && d[0] == 'q' && d[1] == 'o' && d[2] == 'i' && d[3] == 'f') {
+        *w = (int32_t)((d[4] << 24) | (d[5] << 16) | (d[6] << 8) | d[7]);
+        *h = (int32_t)((d[8] << 24) | (d[9] << 16) | (d[10] << 8) | d[11]);
+    } else if (d[0] == 'G' && d[1] == 'I' && d[2] == 'F') {
+        *w = d[6] | (d[7] << 8);
+        *h = d[8] | (d[9] << 8);
+    } else if (read >= 26 && d[0] == 'B' && d[1] == 'M') {
+        *w = (int32_t)(d[18] | (d[19] << 8) | (d[20] << 16) | ((uint32_t)d[21] << 24));
+        *h = (int32_t)(d[22] | (d[23] << 8) | (d[24] << 16) | ((uint32_t)d[25] << 24));
+        *h = LV_ABS(*h);
+    } else {
+        return false;
+    }
+    return *w > 0 && *h > 0;
+}
+
+static void lvgl_raylib_loader_free(lvgl_raylib_loader_image_t * image)
+{
+    if (image->ok) {
+        UnloadImage(image->result);
+    }
+    lv_free(image->path);
+    lv_free(image);
+}
+
+static void lvgl_raylib_loader_draw_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lvgl_raylib_loader_image_t * image = lvgl_raylib_loader_find(obj);
+    if (image == NULL) {
+        return;
+    }
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = image->placeholder;
+    dsc.bg_opa = LV_OPA_COVER;
+    dsc.radius = lv_obj_get_style_radius(obj, LV_PART_MAIN);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_draw_rect(lv_event_get_layer(e), &dsc, &coords);
+}
+
+static void lvgl_raylib_loader_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_loader_detach(lv_event_get_target(e));
+}
+
+#else
+
+void lvgl_raylib_loader_init(void)
+{
+}
+
+void lvgl_raylib_loader_set_src(lv_obj_t * obj, const char * path, lv_color_t placeholder)
+{
+    // Without LV_USE_OS there is no thread to decode on
+    LV_UNUSED(placeholder);
+    lv_image_set_src(obj, path);
+}
+
+void lvgl_raylib_loader_get_stats(lvgl_raylib_loader_stats_t * stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+void lvgl_raylib_loader_update(void)
+{
+}
+
+void lvgl_raylib_loader_deinit(void)
+{
+}
+
+#endif
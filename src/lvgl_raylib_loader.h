@@ -0,0 +1,59 @@
+#ifndef LVGL_RAYLIB_LOADER_H
+#define LVGL_RAYLIB_LOADER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Stack of the decoding thread, stb_image needs a few pages of its own */
+#define LVGL_RAYLIB_LOADER_STACK_SIZE (256 * 1024)
+
+/** Viewports looked ahead in the scroll direction of the parent */
+#define LVGL_RAYLIB_LOADER_PREFETCH 1
+
+/** Pixels around the viewport that count as visible, also keeps queued images from flapping */
+#define LVGL_RAYLIB_LOADER_MARGIN 32
+
+/* public types */
+
+typedef enum {
+    LVGL_RAYLIB_LOADER_IDLE,        // out of reach, nothing to do yet
+    LVGL_RAYLIB_LOADER_QUEUED,      // waiting for the decoding thread
+    LVGL_RAYLIB_LOADER_DECODING,    // owned by the decoding thread
+    LVGL_RAYLIB_LOADER_DECODED,     // result ready for the UI thread
+} lvgl_raylib_loader_state_t;
+
+/** An image waiting for its file, shown as a placeholder meanwhile */
+typedef struct {
+    lv_obj_t * obj;                 // NULL once the image is gone while still decoding
+    char * path;
+    lv_color_t placeholder;
+    bool sized;                     // size taken from the file header, back to content once loaded
+
+    // scroll tracking of the nearest scrolling ancestor
+    lv_obj_t * view;
+    int32_t scroll_x;
+    int32_t scroll_y;
+    int32_t dir_x;
+    int32_t dir_y;
+
+    // shared with the decoding thread, under the mutex
+    lvgl_raylib_loader_state_t state;
+    bool cancelled;
+    int32_t priority;               // distance to the viewport, nearest decodes first
+    bool ok;
+    Image result;
+    float decode_ms;
+} lvgl_raylib_loader_image_t;
+
+/* public functions */
+
+void lvgl_raylib_loader_init(void);
+void lvgl_raylib_loader_update(void);
+void lvgl_raylib_loader_deinit(void);
+
+#endif
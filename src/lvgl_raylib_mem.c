@@ -0,0 +1,698 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+    #include <sys/mman.h>
+#endif
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_mem.h"
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+/* private defines */
+
+#define LVGL_RAYLIB_MEM_HEADER LVGL_RAYLIB_MEM_ALIGN
+#define LVGL_RAYLIB_MEM_MIN_SIZE LVGL_RAYLIB_MEM_ALIGN
+#define LVGL_RAYLIB_MEM_FREE ((size_t)1)
+#define LVGL_RAYLIB_MEM_SMALL_SIZE ((size_t)1 << LVGL_RAYLIB_MEM_FL_SHIFT)
+#define LVGL_RAYLIB_MEM_MAX_REQUEST ((size_t)1 << (LVGL_RAYLIB_MEM_FL_MAX - 1))
+#define LVGL_RAYLIB_MEM_MAX_BLOCK (((size_t)1 << LVGL_RAYLIB_MEM_FL_MAX) - LVGL_RAYLIB_MEM_ALIGN)
+
+#if defined(_MSC_VER)
+    #define LVGL_RAYLIB_MEM_THREAD_LOCAL __declspec(thread)
+#else
+    #define LVGL_RAYLIB_MEM_THREAD_LOCAL _Thread_local
+#endif
+
+/* private prototypes */
+
+static size_t lvgl_raylib_mem_block_size(const lvgl_raylib_mem_block_t * block);
+static bool lvgl_raylib_mem_block_is_free(const lvgl_raylib_mem_block_t * block);
+static lvgl_raylib_mem_block_t * lvgl_raylib_mem_block_next(const lvgl_raylib_mem_block_t * block);
+static lvgl_raylib_mem_block_t * lvgl_raylib_mem_block_from(const void * p);
+static int lvgl_raylib_mem_fls(size_t word);
+static int lvgl_raylib_mem_ffs(uint32_t word);
+static void lvgl_raylib_mem_mapping(size_t size, int * fl, int * sl);
+static void lvgl_raylib_mem_insert(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block);
+static void lvgl_raylib_mem_remove(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block);
+static lvgl_raylib_mem_block_t * lvgl_raylib_mem_find(lvgl_raylib_mem_tlsf_t * tlsf, size_t size);
+static void lvgl_raylib_mem_release(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block);
+static void lvgl_raylib_mem_split(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block, size_t size);
+static bool lvgl_raylib_mem_tlsf_add(lvgl_raylib_mem_tlsf_t * tlsf, uint8_t * mem, size_t bytes, lvgl_raylib_mem_pool_t * pool);
+static void * lvgl_raylib_mem_tlsf_malloc(lvgl_raylib_mem_tlsf_t * tlsf, size_t size);
+static void * lvgl_raylib_mem_tlsf_realloc(lvgl_raylib_mem_tlsf_t * tlsf, void * p, size_t size);
+static void lvgl_raylib_mem_tlsf_free(lvgl_raylib_mem_tlsf_t * tlsf, void * p);
+static bool lvgl_raylib_mem_check_pool(const lvgl_raylib_mem_pool_t * pool);
+static lvgl_raylib_mem_arena_t * lvgl_raylib_mem_find_arena(const void * p);
+static uint8_t * lvgl_raylib_mem_reserve(size_t size);
+static void lvgl_raylib_mem_unreserve(uint8_t * mem, size_t size);
+static void * lvgl_raylib_mem_malloc_in(lvgl_raylib_mem_arena_t * arena, size_t size);
+static void lvgl_raylib_mem_arena_delete_cb(lv_event_t * e);
+static void lvgl_raylib_mem_lock(void);
+static void lvgl_raylib_mem_unlock(void);
+
+/* static variables */
+
+static lvgl_raylib_mem_tlsf_t _heap;
+static lvgl_raylib_mem_pool_t _pools[LVGL_RAYLIB_MEM_POOL_CNT];
+static uint8_t * _reserved = NULL;
+static lvgl_raylib_mem_arena_t _arenas[LVGL_RAYLIB_MEM_ARENA_CNT];
+static lvgl_raylib_mem_stats_t _stats = {0};
+#if LV_USE_OS != LV_OS_NONE
+static lv_mutex_t _mutex;
+#endif
+
+// Only the thread building the screen allocates from its arena, draw threads don't
+static LVGL_RAYLIB_MEM_THREAD_LOCAL lvgl_raylib_mem_arena_t * _current_arena = NULL;
+static LVGL_RAYLIB_MEM_THREAD_LOCAL uint32_t _main_depth = 0;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lv_mem_init(void)
+{
+    memset(&_heap, 0, sizeof(_heap));
+    memset(_pools, 0, sizeof(_pools));
+    memset(_arenas, 0, sizeof(_arenas));
+    memset(&_stats, 0, sizeof(_stats));
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_init(&_mutex);
+#endif
+
+    _reserved = lvgl_raylib_mem_reserve(LVGL_RAYLIB_MEM_SIZE);
+    if (_reserved == NULL) {
+        TraceLog(LOG_ERROR, "Failed to reserve %u bytes for the LVGL heap", (unsigned)LVGL_RAYLIB_MEM_SIZE);
+        return;
+    }
+    lv_mem_add_pool(_reserved, LVGL_RAYLIB_MEM_SIZE);
+}
+
+void lv_mem_deinit(void)
+{
+    for (int i = 0; i < LVGL_RAYLIB_MEM_ARENA_CNT; i++) {
+        if (_arenas[i].start != NULL) {
+            lvgl_raylib_mem_unreserve(_arenas[i].start, _arenas[i].size);
+        }
+    }
+    memset(_arenas, 0, sizeof(_arenas));
+    if (_reserved != NULL) {
+        lvgl_raylib_mem_unreserve(_reserved, LVGL_RAYLIB_MEM_SIZE);
+        _reserved = NULL;
+    }
+    memset(&_heap, 0, sizeof(_heap));
+    memset(_pools, 0, sizeof(_pools));
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_delete(&_mutex);
+#endif
+}
+
+lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
+{
+    lvgl_raylib_mem_lock();
+    lvgl_raylib_mem_pool_t * pool = NULL;
+    for (int i = 0; i < LVGL_RAYLIB_MEM_POOL_CNT && pool == NULL; i++) {
+        if (_pools[i].start == NULL) {
+            pool = &_pools[i];
+        }
+    }
+    if (pool == NULL || !lvgl_raylib_mem_tlsf_add(&_heap, mem, bytes, pool)) {
+        lvgl_raylib_mem_unlock();
+        TraceLog(LOG_ERROR, "Failed to add a %u byte pool to the LVGL heap", (unsigned)bytes);
+        return NULL;
+    }
+    lvgl_raylib_mem_unlock();
+    return pool;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+    lvgl_raylib_mem_pool_t * p = pool;
+    if (p == NULL || p->start == NULL) {
+        return;
+    }
+
+    // Only a pool without allocations left can go: one free block up to the sentinel
+    lvgl_raylib_mem_lock();
+    lvgl_raylib_mem_block_t * block = (lvgl_raylib_mem_block_t *)p->start;
+    lvgl_raylib_mem_block_t * sentinel = lvgl_raylib_mem_block_next(block);
+    if (!lvgl_raylib_mem_block_is_free(block) || lvgl_raylib_mem_block_size(sentinel) != 0) {
+        lvgl_raylib_mem_unlock();
+        TraceLog(LOG_WARNING, "LVGL heap pool is still in use, not removed");
+        return;
+    }
+    lvgl_raylib_mem_remove(&_heap, block);
+    memset(p, 0, sizeof(*p));
+    lvgl_raylib_mem_unlock();
+}
+
+void * lv_malloc_core(size_t size)
+{
+    return lvgl_raylib_mem_malloc_in(_main_depth == 0 ? _current_arena : NULL, size);
+}
+
+void * lv_realloc_core(void * p, size_t new_size)
+{
+    if (p == NULL) {
+        return lv_malloc_core(new_size);
+    }
+
+    // In place when the block or its free neighbour is big enough, moved otherwise. A block
+    // stays in its heap: one from the main heap may be long lived, it never moves into an arena.
+    lvgl_raylib_mem_lock();
+    lvgl_raylib_mem_arena_t * arena = lvgl_raylib_mem_find_arena(p);
+    size_t old_size = lvgl_raylib_mem_block_size(lvgl_raylib_mem_block_from(p));
+    void * resized = lvgl_raylib_mem_tlsf_realloc(arena != NULL ? &arena->tlsf : &_heap, p, new_size);
+    _stats.reallocs++;
+    lvgl_raylib_mem_unlock();
+    if (resized != NULL) {
+        return resized;
+    }
+
+    resized = lvgl_raylib_mem_malloc_in(arena, new_size);
+    if (resized == NULL) {
+        return NULL;
+    }
+    memcpy(resized, p, LV_MIN(old_size, new_size));
+    lv_free_core(p);
+    return resized;
+}
+
+void lv_free_core(void * p)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    lvgl_raylib_mem_lock();
+    lvgl_raylib_mem_arena_t * arena = lvgl_raylib_mem_find_arena(p);
+    lvgl_raylib_mem_tlsf_free(arena != NULL ? &arena->tlsf : &_heap, p);
+    _stats.frees++;
+    lvgl_raylib_mem_unlock();
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
+{
+    lvgl_raylib_mem_lock();
+    size_t total_size = 0;
+    size_t free_size = 0;
+    for (int i = 0; i < LVGL_RAYLIB_MEM_POOL_CNT; i++) {
+        if (_pools[i].start == NULL) {
+            continue;
+        }
+        total_size += _pools[i].size;
+        lvgl_raylib_mem_block_t * block = (lvgl_raylib_mem_block_t *)_pools[i].start;
+        while (lvgl_raylib_mem_block_size(block) != 0) {
+            size_t size = lvgl_raylib_mem_block_size(block);
+            if (lvgl_raylib_mem_block_is_free(block)) {
+                mon_p->free_cnt++;
+                free_size += size;
+                mon_p->free_biggest_size = LV_MAX(mon_p->free_biggest_size, size);
+            } else {
+                mon_p->used_cnt++;
+            }
+            block = lvgl_raylib_mem_block_next(block);
+        }
+    }
+    mon_p->total_size = total_size;
+    mon_p->free_size = free_size;
+    mon_p->max_used = _heap.max_used_size;
+    mon_p->used_pct = total_size > 0 ? (uint8_t)(100 - (uint64_t)free_size * 100 / total_size) : 0;
+    mon_p->frag_pct = free_size > 0 ? (uint8_t)(100 - (uint64_t)mon_p->free_biggest_size * 100 / free_size) : 0;
+    lvgl_raylib_mem_unlock();
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    lvgl_raylib_mem_lock();
+    bool ok = true;
+    for (int i = 0; i < LVGL_RAYLIB_MEM_POOL_CNT && ok; i++) {
+        if (_pools[i].start != NULL) {
+            ok = lvgl_raylib_mem_check_pool(&_pools[i]);
+        }
+    }
+    for (int i = 0; i < LVGL_RAYLIB_MEM_ARENA_CNT && ok; i++) {
+        if (_arenas[i].start != NULL) {
+            lvgl_raylib_mem_pool_t pool = { _arenas[i].start, _arenas[i].size };
+            ok = lvgl_raylib_mem_check_pool(&pool);
+        }
+    }
+    lvgl_raylib_mem_unlock();
+    return ok ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+void lvgl_raylib_mem_arena_begin(lv_obj_t * scr, uint32_t size)
+{
+    if (size == 0) {
+        size = LVGL_RAYLIB_MEM_ARENA_SIZE;
+    }
+
+    lvgl_raylib_mem_lock();
+    lvgl_raylib_mem_arena_t * arena = NULL;
+    for (int i = 0; i < LVGL_RAYLIB_MEM_ARENA_CNT && arena == NULL; i++) {
+        if (_arenas[i].start == NULL) {
+            arena = &_arenas[i];
+        }
+    }
+    uint8_t * start = arena != NULL ? lvgl_raylib_mem_reserve(size) : NULL;
+    lvgl_raylib_mem_pool_t pool;
+    if (start == NULL || !lvgl_raylib_mem_tlsf_add(&arena->tlsf, start, size, &pool)) {
+        if (start != NULL) {
+            lvgl_raylib_mem_unreserve(start, size);
+        }
+        lvgl_raylib_mem_unlock();
+        TraceLog(LOG_WARNING, "No LVGL heap arena available, the screen uses the main heap");
+        return;
+    }
+    arena->scr = scr;
+    arena->start = start;
+    arena->size = size;
+    arena->dying = false;
+    _stats.arenas++;
+    lvgl_raylib_mem_unlock();
+
+    // The callback itself lives in the main heap
+    lv_obj_add_event_cb(scr, &lvgl_raylib_mem_arena_delete_cb, LV_EVENT_DELETE, arena);
+    _current_arena = arena;
+}
+
+void lvgl_raylib_mem_arena_end(void)
+{
+    _current_arena = NULL;
+}
+
+void lvgl_raylib_mem_main_begin(void)
+{
+    _main_depth++;
+}
+
+void lvgl_raylib_mem_main_end(void)
+{
+    if (_main_depth > 0) {
+        _main_depth--;
+    }
+}
+
+void lvgl_raylib_mem_get_stats(lvgl_raylib_mem_stats_t * stats)
+{
+    lvgl_raylib_mem_lock();
+    *stats = _stats;
+    lvgl_raylib_mem_unlock();
+}
+
+void lvgl_raylib_mem_update(void)
+{
+    // An allocation that outlived its screen, e.g. a cache entry, pins the arena: unmapping it
+    // would leave the entry dangling
+    lvgl_raylib_mem_lock();
+    uint32_t pinned = 0;
+    for (int i = 0; i < LVGL_RAYLIB_MEM_ARENA_CNT; i++) {
+        lvgl_raylib_mem_arena_t * arena = &_arenas[i];
+        if (arena->start == NULL || !arena->dying) {
+            continue;
+        }
+        if (arena->tlsf.used_size > 0) {
+            pinned++;
+            continue;
+        }
+        lvgl_raylib_mem_unreserve(arena->start, arena->size);
+        memset(arena, 0, sizeof(*arena));
+        _stats.arenas--;
+        _stats.arena_releases++;
+    }
+    _stats.arenas_pinned = pinned;
+    lvgl_raylib_mem_unlock();
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static size_t lvgl_raylib_mem_block_size(const lvgl_raylib_mem_block_t * block)
+{
+    return block->size & ~LVGL_RAYLIB_MEM_FREE;
+}
+
+static bool lvgl_raylib_mem_block_is_free(const lvgl_raylib_mem_block_t * block)
+{
+    return (block->size & LVGL_RAYLIB_MEM_FREE) != 0;
+}
+
+static lvgl_raylib_mem_block_t * lvgl_raylib_mem_block_next(const lvgl_raylib_mem_block_t * block)
+{
+    return (lvgl_raylib_mem_block_t *)((uint8_t *)block + LVGL_RAYLIB_MEM_HEADER + lvgl_raylib_mem_block_size(block));
+}
+
+static lvgl_raylib_mem_block_t * lvgl_raylib_mem_block_from(const void * p)
+{
+    return (lvgl_raylib_mem_block_t *)((uint8_t *)p - LVGL_RAYLIB_MEM_HEADER);
+}
+
+static int lvgl_raylib_mem_fls(size_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (int)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)word);
+#else
+    int bit = -1;
+    while (word != 0) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static int lvgl_raylib_mem_ffs(uint32_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(word);
+#else
+    int bit = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+
+static void lvgl_raylib_mem_mapping(size_t size, int * fl, int * sl)
+{
+    // Small sizes in linear steps, the rest in SL_CNT steps per power of two
+    if (size < LVGL_RAYLIB_MEM_SMALL_SIZE) {
+        *fl = 0;
+        *sl = (int)(size / (LVGL_RAYLIB_MEM_SMALL_SIZE / LVGL_RAYLIB_MEM_SL_CNT));
+    } else {
+        int bit = lvgl_raylib_mem_fls(size);
+        *sl = (int)(size >> (bit - LVGL_RAYLIB_MEM_SL_SHIFT)) ^ LVGL_RAYLIB_MEM_SL_CNT;
+        *fl = bit - (LVGL_RAYLIB_MEM_FL_SHIFT - 1);
+    }
+}
+
+static void lvgl_raylib_mem_insert(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block)
+{
+    int fl, sl;
+    lvgl_raylib_mem_mapping(lvgl_raylib_mem_block_size(block), &fl, &sl);
+    lvgl_raylib_mem_block_t * head = tlsf->blocks[fl][sl];
+    block->prev_free = NULL;
+    block->next_free = head;
+    if (head != NULL) {
+        head->prev_free = block;
+    }
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= 1u << fl;
+    tlsf->sl_bitmap[fl] |= 1u << sl;
+}
+
+static void lvgl_raylib_mem_remove(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block)
+{
+    int fl, sl;
+    lvgl_raylib_mem_mapping(lvgl_raylib_mem_block_size(block), &fl, &sl);
+    if (block->prev_free != NULL) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        tlsf->blocks[fl][sl] = block->next_free;
+    }
+    if (block->next_free != NULL) {
+        block->next_free->prev_free = block->prev_free;
+    }
+    if (tlsf->blocks[fl][sl] == NULL) {
+        tlsf->sl_bitmap[fl] &= ~(1u << sl);
+        if (tlsf->sl_bitmap[fl] == 0) {
+            tlsf->fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+static lvgl_raylib_mem_block_t * lvgl_raylib_mem_find(lvgl_raylib_mem_tlsf_t * tlsf, size_t size)
+{
+    // Round up to the next list so any block of it fits, good fit in O(1)
+    if (size >= LVGL_RAYLIB_MEM_SMALL_SIZE) {
+        size += ((size_t)1 << (lvgl_raylib_mem_fls(size) - LVGL_RAYLIB_MEM_SL_SHIFT)) - 1;
+    }
+    int fl, sl;
+    lvgl_raylib_mem_mapping(size, &fl, &sl);
+    if (fl >= LVGL_RAYLIB_MEM_FL_CNT) {
+        return NULL;
+    }
+
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0u << sl);
+    if (sl_map == 0) {
+        uint32_t fl_map = tlsf->fl_bitmap & (~0u << (fl + 1));
+        if (fl_map == 0) {
+            return NULL;
+        }
+        fl = lvgl_raylib_mem_ffs(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    return tlsf->blocks[fl][lvgl_raylib_mem_ffs(sl_map)];
+}
+
+static void lvgl_raylib_mem_release(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block)
+{
+    // Merge with free neighbours, two free blocks are never adjacent
+    lvgl_raylib_mem_block_t * prev = block->prev_phys;
+    if (prev != NULL && lvgl_raylib_mem_block_is_free(prev)) {
+        lvgl_raylib_mem_remove(tlsf, prev);
+        prev->size = lvgl_raylib_mem_block_size(prev) + LVGL_RAYLIB_MEM_HEADER + lvgl_raylib_mem_block_size(block);
+        block = prev;
+        lvgl_raylib_mem_block_next(block)->prev_phys = block;
+    }
+    lvgl_raylib_mem_block_t * next = lvgl_raylib_mem_block_next(block);
+    if (lvgl_raylib_mem_block_is_free(next)) {
+        lvgl_raylib_mem_remove(tlsf, next);
+        block->size = lvgl_raylib_mem_block_size(block) + LVGL_RAYLIB_MEM_HEADER + lvgl_raylib_mem_block_size(next);
+        lvgl_raylib_mem_block_next(block)->prev_phys = block;
+    }
+    block->size |= LVGL_RAYLIB_MEM_FREE;
+    lvgl_raylib_mem_insert(tlsf, block);
+}
+
+static void lvgl_raylib_mem_split(lvgl_raylib_mem_tlsf_t * tlsf, lvgl_raylib_mem_block_t * block, size_t size)
+{
+    size_t total = lvgl_raylib_mem_block_size(block);
+    if (total < size + LVGL_RAYLIB_MEM_HEADER + LVGL_RAYLIB_MEM_MIN_SIZE) {
+        return;
+    }
+    lvgl_raylib_mem_block_t * rest = (lvgl_raylib_mem_block_t *)((uint8_t *)block + LVGL_RAYLIB_MEM_HEADER + size);
+    rest->prev_phys = block;
+    rest->size = total - size - LVGL_RAYLIB_MEM_HEADER;
+    block->size = size;
+    lvgl_raylib_mem_block_next(rest)->prev_phys = rest;
+    lvgl_raylib_mem_release(tlsf, rest);
+}
+
+static bool lvgl_raylib_mem_tlsf_add(lvgl_raylib_mem_tlsf_t * tlsf, uint8_t * mem, size_t bytes, lvgl_raylib_mem_pool_t * pool)
+{
+    // One free block spanning the pool, closed by a used empty sentinel
+    uint8_t * start = (uint8_t *)(((uintptr_t)mem + LVGL_RAYLIB_MEM_ALIGN - 1) & ~(uintptr_t)(LVGL_RAYLIB_MEM_ALIGN - 1));
+    if (bytes < (size_t)(start - mem) + 2 * LVGL_RAYLIB_MEM_HEADER + LVGL_RAYLIB_MEM_MIN_SIZE) {
+        return false;
+    }
+    size_t size = (bytes - (size_t)(start - mem)) & ~(size_t)(LVGL_RAYLIB_MEM_ALIGN - 1);
+    size_t block_size = LV_MIN(size - 2 * LVGL_RAYLIB_MEM_HEADER, LVGL_RAYLIB_MEM_MAX_BLOCK);
+
+    lvgl_raylib_mem_block_t * block = (lvgl_raylib_mem_block_t *)start;
+    block->prev_phys = NULL;
+    block->size = block_size;
+    lvgl_raylib_mem_block_t * sentinel = lvgl_raylib_mem_block_next(block);
+    sentinel->prev_phys = block;
+    sentinel->size = 0;
+    block->size |= LVGL_RAYLIB_MEM_FREE;
+    lvgl_raylib_mem_insert(tlsf, block);
+
+    pool->start = start;
+    pool->size = block_size + 2 * LVGL_RAYLIB_MEM_HEADER;
+    return true;
+}
+
+static void * lvgl_raylib_mem_tlsf_malloc(lvgl_raylib_mem_tlsf_t * tlsf, size_t size)
+{
+    if (size > LVGL_RAYLIB_MEM_MAX_REQUEST) {
+        return NULL;
+    }
+    size = LV_MAX((size + LVGL_RAYLIB_MEM_ALIGN - 1) & ~(size_t)(LVGL_RAYLIB_MEM_ALIGN - 1), LVGL_RAYLIB_MEM_MIN_SIZE);
+
+    lvgl_raylib_mem_block_t * block = lvgl_raylib_mem_find(tlsf, size);
+    if (block == NULL) {
+        return NULL;
+    }
+    lvgl_raylib_mem_remove(tlsf, block);
+    block->size = lvgl_raylib_mem_block_size(block);
+    lvgl_raylib_mem_split(tlsf, block, size);
+
+    tlsf->used_size += lvgl_raylib_mem_block_size(block);
+    tlsf->max_used_size = LV_MAX(tlsf->max_used_size, tlsf->used_size);
+    return (uint8_t *)block + LVGL_RAYLIB_MEM_HEADER;
+}
+
+static void * lvgl_raylib_mem_tlsf_realloc(lvgl_raylib_mem_tlsf_t * tlsf, void * p, size_t size)
+{
+    if (size > LVGL_RAYLIB_MEM_MAX_REQUEST) {
+        return NULL;
+    }
+    size = LV_MAX((size + LVGL_RAYLIB_MEM_ALIGN - 1) & ~(size_t)(LVGL_RAYLIB_MEM_ALIGN - 1), LVGL_RAYLIB_MEM_MIN_SIZE);
+
+    lvgl_raylib_mem_block_t * block = lvgl_raylib_mem_block_from(p);
+    size_t old_size = lvgl_raylib_mem_block_size(block);
+    if (size > old_size) {
+        lvgl_raylib_mem_block_t * next = lvgl_raylib_mem_block_next(block);
+        if (!lvgl_raylib_mem_block_is_free(next) || old_size + LVGL_RAYLIB_MEM_HEADER + lvgl_raylib_mem_block_size(next) < size) {
+            return NULL;
+        }
+        lvgl_raylib_mem_remove(tlsf, next);
+        block->size = old_size + LVGL_RAYLIB_MEM_HEADER + lvgl_raylib_mem_block_size(next);
+        lvgl_raylib_mem_block_next(block)->prev_phys = block;
+    }
+    lvgl_raylib_mem_split(tlsf, block, size);
+
+    tlsf->used_size = tlsf->used_size - old_size + lvgl_raylib_mem_block_size(block);
+    tlsf->max_used_size = LV_MAX(tlsf->max_used_size, tlsf->used_size);
+    return p;
+}
+
+static void lvgl_raylib_mem_tlsf_free(lvgl_raylib_mem_tlsf_t * tlsf, void * p)
+{
+    lvgl_raylib_mem_block_t * block = lvgl_raylib_mem_block_from(p);
+    tlsf->used_size -= lvgl_raylib_mem_block_size(block);
+    lvgl_raylib_mem_release(tlsf, block);
+}
+
+static bool lvgl_raylib_mem_check_pool(const lvgl_raylib_mem_pool_t * pool)
+{
+    lvgl_raylib_mem_block_t * prev = NULL;
+    lvgl_raylib_mem_block_t * block = (lvgl_raylib_mem_block_t *)pool->start;
+    uint8_t * end = pool->start + pool->size;
+    while (true) {
+        if ((uint8_t *)block + LVGL_RAYLIB_MEM_HEADER > end || block->prev_phys != prev) {
+            return false;
+        }
+        size_t size = lvgl_raylib_mem_block_size(block);
+        if (size == 0) {
+            return !lvgl_raylib_mem_block_is_free(block);
+        }
+        if (size % LVGL_RAYLIB_MEM_ALIGN != 0) {
+            return false;
+        }
+        if (prev != NULL && lvgl_raylib_mem_block_is_free(prev) && lvgl_raylib_mem_block_is_free(block)) {
+            return false;
+        }
+        prev = block;
+        block = lvgl_raylib_mem_block_next(block);
+    }
+}
+
+static void * lvgl_raylib_mem_malloc_in(lvgl_raylib_mem_arena_t * arena, size_t size)
+{
+    lvgl_raylib_mem_lock();
+    void * p = NULL;
+    if (arena != NULL && !arena->dying) {
+        p = lvgl_raylib_mem_tlsf_malloc(&arena->tlsf, size);
+        if (p != NULL) {
+            _stats.arena_allocs++;
+        } else {
+            _stats.arena_fallbacks++;
+        }
+    }
+    if (p == NULL) {
+        p = lvgl_raylib_mem_tlsf_malloc(&_heap, size);
+    }
+    if (p != NULL) {
+        _stats.allocs++;
+    } else {
+        _stats.failed++;
+    }
+    lvgl_raylib_mem_unlock();
+    return p;
+}
+
+static lvgl_raylib_mem_arena_t * lvgl_raylib_mem_find_arena(const void * p)
+{
+    const uint8_t * addr = p;
+    for (int i = 0; i < LVGL_RAYLIB_MEM_ARENA_CNT; i++) {
+        if (_arenas[i].start != NULL && addr >= _arenas[i].start && addr < _arenas[i].start + _arenas[i].size) {
+            return &_arenas[i];
+        }
+    }
+    return NULL;
+}
+
+static uint8_t * lvgl_raylib_mem_reserve(size_t size)
+{
+#if defined(_WIN32)
+    return malloc(size);
+#else
+    // Address space only, untouched pages of the heap cost no memory
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_NORESERVE)
+    flags |= MAP_NORESERVE;
+#endif
+    void * mem = mmap(NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    return mem != MAP_FAILED ? mem : NULL;
+#endif
+}
+
+static void lvgl_raylib_mem_unreserve(uint8_t * mem, size_t size)
+{
+#if defined(_WIN32)
+    LV_UNUSED(size);
+    free(mem);
+#else
+    munmap(mem, size);
+#endif
+}
+
+static void lvgl_raylib_mem_arena_delete_cb(lv_event_t * e)
+{
+    // No more allocations from the arena, it is released once the screen's objects are freed
+    lvgl_raylib_mem_arena_t * arena = lv_event_get_user_data(e);
+    lvgl_raylib_mem_lock();
+    arena->dying = true;
+    lvgl_raylib_mem_unlock();
+    if (_current_arena == arena) {
+        _current_arena = NULL;
+    }
+}
+
+static void lvgl_raylib_mem_lock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_lock(&_mutex);
+#endif
+}
+
+static void lvgl_raylib_mem_unlock(void)
+{
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_unlock(&_mutex);
+#endif
+}
+
+#else /* LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM */
+
+void lvgl_raylib_mem_arena_begin(lv_obj_t * scr, uint32_t size)
+{
+    LV_UNUSED(scr);
+    LV_UNUSED(size);
+}
+
+void lvgl_raylib_mem_arena_end(void)
+{
+}
+
+void lvgl_raylib_mem_main_begin(void)
+{
+}
+
+void lvgl_raylib_mem_main_end(void)
+{
+}
+
+void lvgl_raylib_mem_get_stats(lvgl_raylib_mem_stats_t * stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+void lvgl_raylib_mem_update(void)
+{
+}
+
+#endif /* LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM */
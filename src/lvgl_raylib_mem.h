@@ -0,0 +1,76 @@
+#ifndef LVGL_RAYLIB_MEM_H
+#define LVGL_RAYLIB_MEM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public defines */
+
+/** Address space reserved for the LVGL heap, pages are committed by the OS once touched */
+#ifndef LVGL_RAYLIB_MEM_SIZE
+#define LVGL_RAYLIB_MEM_SIZE (64 * 1024 * 1024U)
+#endif
+
+/** Pools lv_mem_add_pool() can add on top of the reserved region */
+#define LVGL_RAYLIB_MEM_POOL_CNT 8
+
+/** Screen arenas alive at the same time, and the default size of one */
+#define LVGL_RAYLIB_MEM_ARENA_CNT 16
+#define LVGL_RAYLIB_MEM_ARENA_SIZE (1024 * 1024)
+
+/** TLSF geometry: 32 second level lists, 16 byte granules, blocks up to 1 GiB */
+#define LVGL_RAYLIB_MEM_SL_SHIFT 5
+#define LVGL_RAYLIB_MEM_SL_CNT (1 << LVGL_RAYLIB_MEM_SL_SHIFT)
+#define LVGL_RAYLIB_MEM_FL_SHIFT 8
+#define LVGL_RAYLIB_MEM_FL_MAX 30
+#define LVGL_RAYLIB_MEM_FL_CNT (LVGL_RAYLIB_MEM_FL_MAX - LVGL_RAYLIB_MEM_FL_SHIFT + 1)
+#define LVGL_RAYLIB_MEM_ALIGN 16
+
+/* public types */
+
+/** Header of every block, the free list links overlay the payload of free blocks */
+typedef struct lvgl_raylib_mem_block {
+    struct lvgl_raylib_mem_block * prev_phys;
+    size_t size;                                // payload bytes, bit 0 set while free
+    struct lvgl_raylib_mem_block * next_free;
+    struct lvgl_raylib_mem_block * prev_free;
+} lvgl_raylib_mem_block_t;
+
+/** One TLSF heap over one or more pools */
+typedef struct {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[LVGL_RAYLIB_MEM_FL_CNT];
+    lvgl_raylib_mem_block_t * blocks[LVGL_RAYLIB_MEM_FL_CNT][LVGL_RAYLIB_MEM_SL_CNT];
+    size_t used_size;
+    size_t max_used_size;
+} lvgl_raylib_mem_tlsf_t;
+
+typedef struct {
+    uint8_t * start;
+    size_t size;
+} lvgl_raylib_mem_pool_t;
+
+/** Allocations made while a screen was built, released together with the screen */
+typedef struct {
+    lv_obj_t * scr;
+    lvgl_raylib_mem_tlsf_t tlsf;
+    uint8_t * start;
+    size_t size;
+    bool dying;                 // screen deleted, released once empty
+} lvgl_raylib_mem_arena_t;
+
+/* public functions */
+
+/** Release the arenas of deleted screens once nothing is left in them */
+void lvgl_raylib_mem_update(void);
+
+/** Allocations of the calling thread up to main_end() bypass the screen arena being built,
+ *  for caches that outlive screens. Calls nest. */
+void lvgl_raylib_mem_main_begin(void);
+void lvgl_raylib_mem_main_end(void);
+
+#endif
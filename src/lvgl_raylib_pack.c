@@ -0,0 +1,328 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_pack.h"
+#include "lvgl_raylib_mem.h"
+
+/* private prototypes */
+
+static bool lvgl_raylib_pack_open_pack(const char * path);
+static bool lvgl_raylib_pack_validate(lvgl_raylib_pack_t * pack);
+static const lvgl_raylib_pack_entry_t * lvgl_raylib_pack_find(const char * name, uint32_t type, lvgl_raylib_pack_t ** pack_out);
+static lvgl_raylib_pack_font_inst_t * lvgl_raylib_pack_create_font(lvgl_raylib_pack_t * pack, const lvgl_raylib_pack_entry_t * entry);
+static bool lvgl_raylib_pack_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc, uint32_t letter, uint32_t letter_next);
+static const void * lvgl_raylib_pack_get_glyph_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf);
+static void lvgl_raylib_pack_close_pack(lvgl_raylib_pack_t * pack);
+
+/* static variables */
+
+static lv_ll_t _packs;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_pack_init(void)
+{
+    lv_ll_init(&_packs, sizeof(lvgl_raylib_pack_t));
+}
+
+bool lvgl_raylib_pack_open(const char * path)
+{
+    // Packs and their fonts outlive the screen being built, they never come from its arena
+    lvgl_raylib_mem_main_begin();
+    bool ok = lvgl_raylib_pack_open_pack(path);
+    lvgl_raylib_mem_main_end();
+    return ok;
+}
+
+const lv_image_dsc_t * lvgl_raylib_pack_get_image(const char * name)
+{
+    lvgl_raylib_pack_t * pack;
+    const lvgl_raylib_pack_entry_t * entry = lvgl_raylib_pack_find(name, LVGL_RAYLIB_PACK_IMAGE, &pack);
+    return entry != NULL ? &pack->images[entry - pack->entries] : NULL;
+}
+
+const lv_font_t * lvgl_raylib_pack_get_font(const char * name)
+{
+    lvgl_raylib_pack_t * pack;
+    const lvgl_raylib_pack_entry_t * entry = lvgl_raylib_pack_find(name, LVGL_RAYLIB_PACK_FONT, &pack);
+    if (entry == NULL) {
+        return NULL;
+    }
+
+    uint32_t i = (uint32_t)(entry - pack->entries);
+    if (pack->fonts[i] == NULL) {
+        lvgl_raylib_mem_main_begin();
+        pack->fonts[i] = lvgl_raylib_pack_create_font(pack, entry);
+        lvgl_raylib_mem_main_end();
+    }
+    return pack->fonts[i] != NULL ? &pack->fonts[i]->font : NULL;
+}
+
+void lvgl_raylib_pack_close(const char * path)
+{
+    lvgl_raylib_pack_t * pack;
+    LV_LL_READ(&_packs, pack) {
+        if (strcmp(pack->path, path) == 0) {
+            lvgl_raylib_pack_close_pack(pack);
+            return;
+        }
+    }
+}
+
+void lvgl_raylib_pack_deinit(void)
+{
+    lvgl_raylib_pack_t * pack = lv_ll_get_head(&_packs);
+    while (pack != NULL) {
+        lvgl_raylib_pack_t * next = lv_ll_get_next(&_packs, pack);
+        lvgl_raylib_pack_close_pack(pack);
+        pack = next;
+    }
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool lvgl_raylib_pack_open_pack(const char * path)
+{
+    lvgl_raylib_pack_t * pack = lv_ll_ins_tail(&_packs);
+    if (pack == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate asset pack %s", path);
+        return false;
+    }
+    memset(pack, 0, sizeof(*pack));
+    pack->path = lv_strdup(path);
+
+    // One mapping for the whole pack, plain paths go through the mapped drive
+    char * fs_path = lv_malloc(lv_strlen(path) + 3);
+    if (fs_path == NULL || pack->path == NULL) {
+        lv_free(fs_path);
+        lvgl_raylib_pack_close_pack(pack);
+        return false;
+    }
+    if (path[0] != '\0' && path[1] == ':') {
+        lv_strcpy(fs_path, path);
+    } else {
+        fs_path[0] = LVGL_RAYLIB_FS_LETTER;
+        fs_path[1] = ':';
+        lv_strcpy(fs_path + 2, path);
+    }
+    lv_fs_res_t res = lv_fs_open(&pack->file, fs_path, LV_FS_MODE_RD);
+    lv_free(fs_path);
+    if (res != LV_FS_RES_OK) {
+        TraceLog(LOG_WARNING, "Failed to open asset pack %s", path);
+        memset(&pack->file, 0, sizeof(pack->file));
+        lvgl_raylib_pack_close_pack(pack);
+        return false;
+    }
+    pack->data = lvgl_raylib_fs_get_data(&pack->file, &pack->size);
+    if (pack->data == NULL || !lvgl_raylib_pack_validate(pack)) {
+        TraceLog(LOG_WARNING, "Not a valid asset pack: %s", path);
+        lvgl_raylib_pack_close_pack(pack);
+        return false;
+    }
+
+    pack->images = lv_malloc_zeroed(pack->entry_cnt * sizeof(lv_image_dsc_t));
+    pack->fonts = lv_malloc_zeroed(pack->entry_cnt * sizeof(lvgl_raylib_pack_font_inst_t *));
+    if (pack->images == NULL || pack->fonts == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate asset pack index %s", path);
+        lvgl_raylib_pack_close_pack(pack);
+        return false;
+    }
+
+    // The descriptors point into the mapping, images are used as they are stored
+    for (uint32_t i = 0; i < pack->entry_cnt; i++) {
+        const lvgl_raylib_pack_entry_t * entry = &pack->entries[i];
+        if (entry->type != LVGL_RAYLIB_PACK_IMAGE) {
+            continue;
+        }
+        lv_image_dsc_t * dsc = &pack->images[i];
+        dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+        dsc->header.cf = LV_COLOR_FORMAT_ARGB8888;
+        dsc->header.flags = LV_IMAGE_FLAGS_PREMULTIPLIED;
+        dsc->header.w = entry->w;
+        dsc->header.h = entry->h;
+        dsc->header.stride = entry->stride;
+        dsc->data_size = entry->size;
+        dsc->data = pack->data + entry->offset;
+    }
+    return true;
+}
+
+static bool lvgl_raylib_pack_validate(lvgl_raylib_pack_t * pack)
+{
+    const lvgl_raylib_pack_header_t * header = (const lvgl_raylib_pack_header_t *)pack->data;
+    if (pack->size < sizeof(*header) || header->magic != LVGL_RAYLIB_PACK_MAGIC || header->version != LVGL_RAYLIB_PACK_VERSION) {
+        return false;
+    }
+    uint64_t index_end = sizeof(*header) + (uint64_t)header->entry_cnt * sizeof(lvgl_raylib_pack_entry_t);
+    if (index_end > pack->size) {
+        return false;
+    }
+
+    // Everything read later is checked once here
+    const lvgl_raylib_pack_entry_t * entries = (const lvgl_raylib_pack_entry_t *)(header + 1);
+    for (uint32_t i = 0; i < header->entry_cnt; i++) {
+        const lvgl_raylib_pack_entry_t * entry = &entries[i];
+        if (entry->name[LVGL_RAYLIB_PACK_NAME_LEN - 1] != '\0' || (uint64_t)entry->offset + entry->size > pack->size) {
+            return false;
+        }
+        if (entry->type == LVGL_RAYLIB_PACK_IMAGE) {
+            if (entry->stride < entry->w * 4 || (uint64_t)entry->stride * entry->h > entry->size) {
+                return false;
+            }
+        } else if (entry->type == LVGL_RAYLIB_PACK_FONT) {
+            const lvgl_raylib_pack_font_t * font = (const lvgl_raylib_pack_font_t *)(pack->data + entry->offset);
+            if (entry->size < sizeof(*font)
+                || sizeof(*font) + (uint64_t)font->glyph_cnt * sizeof(lvgl_raylib_pack_glyph_t) > entry->size) {
+                return false;
+            }
+            const lvgl_raylib_pack_glyph_t * glyphs = (const lvgl_raylib_pack_glyph_t *)(font + 1);
+            for (uint32_t g = 0; g < font->glyph_cnt; g++) {
+                if ((uint64_t)glyphs[g].bitmap + (uint64_t)glyphs[g].box_w * glyphs[g].box_h > entry->size) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    pack->entries = entries;
+    pack->entry_cnt = header->entry_cnt;
+    return true;
+}
+
+static const lvgl_raylib_pack_entry_t * lvgl_raylib_pack_find(const char * name, uint32_t type, lvgl_raylib_pack_t ** pack_out)
+{
+    // The index is sorted by name
+    lvgl_raylib_pack_t * pack;
+    LV_LL_READ(&_packs, pack) {
+        uint32_t lo = 0;
+        uint32_t hi = pack->entry_cnt;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            int cmp = strcmp(pack->entries[mid].name, name);
+            if (cmp == 0) {
+                if (pack->entries[mid].type != type) {
+                    break;
+                }
+                *pack_out = pack;
+                return &pack->entries[mid];
+            }
+            if (cmp < 0) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+    }
+    return NULL;
+}
+
+static lvgl_raylib_pack_font_inst_t * lvgl_raylib_pack_create_font(lvgl_raylib_pack_t * pack, const lvgl_raylib_pack_entry_t * entry)
+{
+    const uint8_t * base = pack->data + entry->offset;
+    const lvgl_raylib_pack_font_t * header = (const lvgl_raylib_pack_font_t *)base;
+
+    lvgl_raylib_pack_font_inst_t * inst = lv_malloc_zeroed(sizeof(lvgl_raylib_pack_font_inst_t));
+    lv_draw_buf_t * bitmaps = lv_malloc_zeroed(LV_MAX(header->glyph_cnt, 1) * sizeof(lv_draw_buf_t));
+    if (inst == NULL || bitmaps == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate font %s", entry->name);
+        lv_free(inst);
+        lv_free(bitmaps);
+        return NULL;
+    }
+    inst->header = header;
+    inst->glyphs = (const lvgl_raylib_pack_glyph_t *)(header + 1);
+    inst->bitmaps = bitmaps;
+
+    // Only the draw buffer headers are built, LVGL reads the glyphs from the mapping
+    for (uint32_t i = 0; i < header->glyph_cnt; i++) {
+        const lvgl_raylib_pack_glyph_t * glyph = &inst->glyphs[i];
+        if (glyph->box_w > 0 && glyph->box_h > 0) {
+            lv_draw_buf_init(&bitmaps[i], glyph->box_w, glyph->box_h, LV_COLOR_FORMAT_A8, glyph->box_w,
+                             (void *)(base + glyph->bitmap), (uint32_t)glyph->box_w * glyph->box_h);
+        }
+    }
+
+    lv_font_t * font = &inst->font;
+    font->get_glyph_dsc = &lvgl_raylib_pack_get_glyph_dsc_cb;
+    font->get_glyph_bitmap = &lvgl_raylib_pack_get_glyph_bitmap_cb;
+    font->line_height = header->line_height;
+    font->base_line = header->base_line;
+    font->subpx = LV_FONT_SUBPX_NONE;
+    font->underline_position = (int8_t)header->underline_position;
+    font->underline_thickness = (int8_t)header->underline_thickness;
+    font->dsc = inst;
+    return inst;
+}
+
+static bool lvgl_raylib_pack_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * dsc, uint32_t letter, uint32_t letter_next)
+{
+    LV_UNUSED(letter_next);
+    const lvgl_raylib_pack_font_inst_t * inst = (const lvgl_raylib_pack_font_inst_t *)font->dsc;
+
+    // Glyphs are sorted by codepoint, the table index doubles as the glyph id
+    uint32_t lo = 0;
+    uint32_t hi = inst->header->glyph_cnt;
+    while (lo < hi) {
+        uint32_t mid = (lo + hi) / 2;
+        const lvgl_raylib_pack_glyph_t * glyph = &inst->glyphs[mid];
+        if (glyph->letter == letter) {
+            dsc->adv_w = glyph->adv_w;
+            dsc->box_w = glyph->box_w;
+            dsc->box_h = glyph->box_h;
+            dsc->ofs_x = glyph->ofs_x;
+            dsc->ofs_y = glyph->ofs_y;
+            dsc->format = LV_FONT_GLYPH_FORMAT_A8;
+            dsc->is_placeholder = false;
+            dsc->gid.index = mid;
+            return true;
+        }
+        if (glyph->letter < letter) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
+
+static const void * lvgl_raylib_pack_get_glyph_bitmap_cb(lv_font_glyph_dsc_t * g_dsc, lv_draw_buf_t * draw_buf)
+{
+    LV_UNUSED(draw_buf);
+    const lvgl_raylib_pack_font_inst_t * inst = (const lvgl_raylib_pack_font_inst_t *)g_dsc->resolved_font->dsc;
+    if (g_dsc->gid.index >= inst->header->glyph_cnt || g_dsc->box_w == 0 || g_dsc->box_h == 0) {
+        return NULL;
+    }
+    return &inst->bitmaps[g_dsc->gid.index];
+}
+
+static void lvgl_raylib_pack_close_pack(lvgl_raylib_pack_t * pack)
+{
+    // Images and fonts handed out are gone with the pack
+    if (pack->fonts != NULL) {
+        for (uint32_t i = 0; i < pack->entry_cnt; i++) {
+            if (pack->fonts[i] != NULL) {
+                lvgl_raylib_draw_gpu_font_drop(&pack->fonts[i]->font);
+                lv_free(pack->fonts[i]->bitmaps);
+                lv_free(pack->fonts[i]);
+            }
+        }
+    }
+    if (pack->images != NULL) {
+        for (uint32_t i = 0; i < pack->entry_cnt; i++) {
+            if (pack->entries[i].type == LVGL_RAYLIB_PACK_IMAGE) {
+                lv_image_cache_drop(&pack->images[i]);
+                lvgl_raylib_draw_gpu_image_drop(&pack->images[i]);
+            }
+        }
+    }
+    lv_free(pack->fonts);
+    lv_free(pack->images);
+    if (pack->file.drv != NULL) {
+        lv_fs_close(&pack->file);
+    }
+    lv_free(pack->path);
+    lv_ll_remove(&_packs, pack);
+    lv_free(pack);
+}
@@ -0,0 +1,38 @@
+#ifndef LVGL_RAYLIB_PACK_H
+#define LVGL_RAYLIB_PACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_pack_format.h"
+
+/* public types */
+
+/** A font of a pack, its glyph bitmaps point into the mapping */
+typedef struct {
+    lv_font_t font;
+    const lvgl_raylib_pack_font_t * header;
+    const lvgl_raylib_pack_glyph_t * glyphs;
+    lv_draw_buf_t * bitmaps;                    // one per glyph
+} lvgl_raylib_pack_font_inst_t;
+
+/** An open pack, mapped once and kept open until closed */
+typedef struct {
+    char * path;
+    lv_fs_file_t file;
+    const uint8_t * data;
+    uint32_t size;
+    const lvgl_raylib_pack_entry_t * entries;
+    uint32_t entry_cnt;
+    lv_image_dsc_t * images;                    // one per entry, filled for images
+    lvgl_raylib_pack_font_inst_t ** fonts;      // one per entry, created on first use
+} lvgl_raylib_pack_t;
+
+/* public functions */
+
+void lvgl_raylib_pack_init(void);
+void lvgl_raylib_pack_deinit(void);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef LVGL_RAYLIB_PACK_FORMAT_H
+#define LVGL_RAYLIB_PACK_FORMAT_H
+
+#include <stdint.h>
+
+/* Asset pack layout, shared with tools/lvgl_raylib_pack.c. All fields little endian:
+ *
+ *   header | index, sorted by name | page aligned entry data ...
+ *
+ * Images are premultiplied ARGB8888 in LVGL's byte order, rows of stride bytes.
+ * Fonts are a font header, the glyph table sorted by codepoint and A8 bitmaps. */
+
+/* public defines */
+
+#define LVGL_RAYLIB_PACK_MAGIC 0x5052564Cu      // "LVRP"
+#define LVGL_RAYLIB_PACK_VERSION 1
+#define LVGL_RAYLIB_PACK_ALIGN 4096
+#define LVGL_RAYLIB_PACK_NAME_LEN 56
+
+#define LVGL_RAYLIB_PACK_IMAGE 1
+#define LVGL_RAYLIB_PACK_FONT 2
+
+/* public types */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_cnt;
+    uint32_t reserved;
+} lvgl_raylib_pack_header_t;
+
+typedef struct {
+    char name[LVGL_RAYLIB_PACK_NAME_LEN];       // NUL terminated
+    uint32_t type;
+    uint32_t offset;                            // from the start of the pack
+    uint32_t size;
+    uint32_t w;                                 // image width, font size in pixels
+    uint32_t h;                                 // image height, font glyph count
+    uint32_t stride;                            // image row bytes
+} lvgl_raylib_pack_entry_t;
+
+typedef struct {
+    int32_t line_height;
+    int32_t base_line;
+    int32_t underline_position;
+    int32_t underline_thickness;
+    uint32_t glyph_cnt;
+    uint32_t reserved;
+} lvgl_raylib_pack_font_t;
+
+typedef struct {
+    uint32_t letter;
+    int16_t adv_w;
+    int16_t ofs_x;
+    int16_t ofs_y;
+    uint16_t box_w;
+    uint16_t box_h;
+    uint16_t reserved;
+    uint32_t bitmap;                            // from the font header, box_w bytes per row
+} lvgl_raylib_pack_glyph_t;
+
+#endif
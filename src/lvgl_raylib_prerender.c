@@ -0,0 +1,271 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_prerender.h"
+#include "lvgl_raylib_budget.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_PRERENDER_BAND_ROWS 32
+
+/* private prototypes */
+
+static lvgl_raylib_prerender_t * lvgl_raylib_prerender_find(const lv_obj_t * scr);
+static void lvgl_raylib_prerender_band(lvgl_raylib_prerender_t * entry, int32_t y1, int32_t y2);
+static void lvgl_raylib_prerender_release(lvgl_raylib_prerender_t * entry);
+static void lvgl_raylib_prerender_delete_cb(lv_event_t * e);
+static lvgl_raylib_prerender_t * lvgl_raylib_prerender_oldest(void);
+static uint32_t lvgl_raylib_prerender_budget_size_cb(void);
+static bool lvgl_raylib_prerender_budget_oldest_cb(uint32_t * last_used);
+static void lvgl_raylib_prerender_budget_evict_cb(void);
+
+/* static variables */
+
+static lvgl_raylib_display_t * _display = NULL;
+static lv_ll_t _prerenders;
+
+// After presenting cached pixels, the loaded screen is handed back to LVGL band by band
+static lv_obj_t * _resume_scr = NULL;
+static int32_t _resume_row = 0;
+
+// An evicted screen simply loads the regular way
+static lvgl_raylib_budget_cache_t _budget = {
+    .name = "pre-rendered screens",
+    .cost = LVGL_RAYLIB_BUDGET_COST_RENDER,
+    .get_size_cb = &lvgl_raylib_prerender_budget_size_cb,
+    .get_oldest_cb = &lvgl_raylib_prerender_budget_oldest_cb,
+    .evict_oldest_cb = &lvgl_raylib_prerender_budget_evict_cb,
+};
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_prerender_init(lvgl_raylib_display_t * display)
+{
+    _display = display;
+    lv_ll_init(&_prerenders, sizeof(lvgl_raylib_prerender_t));
+    lvgl_raylib_budget_register(&_budget);
+}
+
+void lvgl_raylib_prerender_start(lv_obj_t * scr, uint32_t budget_ms)
+{
+    lvgl_raylib_prerender_t * entry = lvgl_raylib_prerender_find(scr);
+    if (entry == NULL) {
+        entry = lv_ll_ins_tail(&_prerenders);
+        if (entry == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate pre-render entry");
+            return;
+        }
+
+        entry->scr = scr;
+        entry->draw_buf = lv_draw_buf_create((uint32_t)_display->raylib_img.width, (uint32_t)_display->raylib_img.height,
+                                             LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+        if (entry->draw_buf == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate pre-render buffer");
+            lv_ll_remove(&_prerenders, entry);
+            lv_free(entry);
+            return;
+        }
+        lv_obj_add_event_cb(scr, &lvgl_raylib_prerender_delete_cb, LV_EVENT_DELETE, NULL);
+    }
+
+    entry->next_row = 0;
+    entry->budget = budget_ms / 1000.0f;
+    entry->last_used = lvgl_raylib_budget_touch();
+}
+
+void lvgl_raylib_prerender_invalidate(lv_obj_t * scr)
+{
+    lvgl_raylib_prerender_t * entry = lvgl_raylib_prerender_find(scr);
+    if (entry != NULL) {
+        entry->next_row = 0;
+        entry->last_used = lvgl_raylib_budget_touch();
+    }
+}
+
+bool lvgl_raylib_prerender_is_ready(lv_obj_t * scr)
+{
+    lvgl_raylib_prerender_t * entry = lvgl_raylib_prerender_find(scr);
+    return entry != NULL && entry->next_row >= (int32_t)entry->draw_buf->header.h;
+}
+
+void lvgl_raylib_screen_load_prerendered(lv_obj_t * scr, bool auto_del)
+{
+    lvgl_raylib_prerender_t * entry = lvgl_raylib_prerender_find(scr);
+    bool ready = lvgl_raylib_prerender_is_ready(scr);
+
+    lv_screen_load_anim(scr, LV_SCR_LOAD_ANIM_NONE, 0, 0, auto_del);
+    if (!ready) {
+        if (entry != NULL) {
+            lvgl_raylib_prerender_release(entry);
+        }
+        return;
+    }
+
+    // Present the cached pixels this very frame
+    lvgl_raylib_display_convert_argb8888(_display->raylib_img.data, (uint32_t)_display->raylib_img.width * 4,
+                                         entry->draw_buf->data, entry->draw_buf->header.stride,
+                                         entry->draw_buf->header.w, entry->draw_buf->header.h);
+    _display->texture_updated = true;
+    lvgl_raylib_prerender_release(entry);
+
+    // Drop LVGL's full screen redraw; it is re-issued in bands from the next frames on
+    // so any change made since the pre-render shows up without a one frame stall
+    lv_display_t * disp = _display->disp;
+    lv_memzero(disp->inv_area_joined, sizeof(disp->inv_area_joined));
+    disp->inv_p = 0;
+    _resume_scr = scr;
+    _resume_row = 0;
+
+    // The cache doesn't contain the top and system layers
+    uint32_t cnt = lv_obj_get_child_count(lv_layer_top());
+    for (uint32_t i = 0; i < cnt; i++) {
+        lv_obj_invalidate(lv_obj_get_child(lv_layer_top(), (int32_t)i));
+    }
+    cnt = lv_obj_get_child_count(lv_layer_sys());
+    for (uint32_t i = 0; i < cnt; i++) {
+        lv_obj_invalidate(lv_obj_get_child(lv_layer_sys(), (int32_t)i));
+    }
+}
+
+void lvgl_raylib_prerender_update(void)
+{
+    int32_t width = _display->raylib_img.width;
+    int32_t height = _display->raylib_img.height;
+
+    if (_resume_scr != NULL) {
+        if (_resume_scr != lv_screen_active() || _resume_row >= height) {
+            _resume_scr = NULL;
+        } else {
+            lv_area_t band = { 0, _resume_row, width - 1, LV_MIN(_resume_row + LVGL_RAYLIB_PRERENDER_BAND_ROWS * 4, height) - 1 };
+            lv_obj_invalidate_area(_resume_scr, &band);
+            _resume_row = band.y2 + 1;
+        }
+    }
+
+    // Pre-render in the time left over by the frame, each screen within its own budget
+    lvgl_raylib_prerender_t * entry;
+    LV_LL_READ(&_prerenders, entry) {
+        double start = GetTime();
+        while (entry->next_row < height && GetTime() - start < entry->budget) {
+            int32_t y2 = LV_MIN(entry->next_row + LVGL_RAYLIB_PRERENDER_BAND_ROWS, height) - 1;
+            lvgl_raylib_prerender_band(entry, entry->next_row, y2);
+            entry->next_row = y2 + 1;
+        }
+    }
+}
+
+void lvgl_raylib_prerender_deinit(void)
+{
+    lvgl_raylib_budget_unregister(&_budget);
+    lvgl_raylib_prerender_t * entry;
+    LV_LL_READ(&_prerenders, entry) {
+        lv_draw_buf_destroy(entry->draw_buf);
+    }
+    lv_ll_clear(&_prerenders);
+    _resume_scr = NULL;
+    _display = NULL;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_prerender_t * lvgl_raylib_prerender_find(const lv_obj_t * scr)
+{
+    lvgl_raylib_prerender_t * entry;
+    LV_LL_READ(&_prerenders, entry) {
+        if (entry->scr == scr) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void lvgl_raylib_prerender_band(lvgl_raylib_prerender_t * entry, int32_t y1, int32_t y2)
+{
+    lv_area_t band = { 0, y1, (int32_t)entry->draw_buf->header.w - 1, y2 };
+    lv_draw_buf_clear(entry->draw_buf, &band);
+
+    // Same as lv_snapshot, restricted to one band of the screen
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+    layer.draw_buf = entry->draw_buf;
+    layer.buf_area = (lv_area_t){ 0, 0, (int32_t)entry->draw_buf->header.w - 1, (int32_t)entry->draw_buf->header.h - 1 };
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer._clip_area = band;
+    layer.phy_clip_area = band;
+
+    lv_display_t * disp = lv_obj_get_display(entry->scr);
+    lv_display_t * disp_old = lv_refr_get_disp_refreshing();
+    lv_layer_t * layer_old = disp->layer_head;
+    disp->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp);
+
+    lv_obj_update_layout(entry->scr);
+    lv_obj_redraw(&layer, entry->scr);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp->layer_head = layer_old;
+    lv_refr_set_disp_refreshing(disp_old);
+}
+
+static void lvgl_raylib_prerender_release(lvgl_raylib_prerender_t * entry)
+{
+    lv_obj_remove_event_cb_with_user_data(entry->scr, &lvgl_raylib_prerender_delete_cb, NULL);
+    lv_draw_buf_destroy(entry->draw_buf);
+    lv_ll_remove(&_prerenders, entry);
+    lv_free(entry);
+}
+
+static void lvgl_raylib_prerender_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_prerender_t * entry = lvgl_raylib_prerender_find(lv_event_get_target(e));
+    if (entry != NULL) {
+        lv_draw_buf_destroy(entry->draw_buf);
+        lv_ll_remove(&_prerenders, entry);
+        lv_free(entry);
+    }
+}
+
+static lvgl_raylib_prerender_t * lvgl_raylib_prerender_oldest(void)
+{
+    uint32_t now = lvgl_raylib_budget_now();
+    lvgl_raylib_prerender_t * oldest = NULL;
+    lvgl_raylib_prerender_t * entry;
+    LV_LL_READ(&_prerenders, entry) {
+        if (oldest == NULL || now - entry->last_used > now - oldest->last_used) {
+            oldest = entry;
+        }
+    }
+    return oldest;
+}
+
+static uint32_t lvgl_raylib_prerender_budget_size_cb(void)
+{
+    uint32_t size = 0;
+    lvgl_raylib_prerender_t * entry;
+    LV_LL_READ(&_prerenders, entry) {
+        size += entry->draw_buf->data_size;
+    }
+    return size;
+}
+
+static bool lvgl_raylib_prerender_budget_oldest_cb(uint32_t * last_used)
+{
+    lvgl_raylib_prerender_t * oldest = lvgl_raylib_prerender_oldest();
+    if (oldest == NULL) {
+        return false;
+    }
+    *last_used = oldest->last_used;
+    return true;
+}
+
+static void lvgl_raylib_prerender_budget_evict_cb(void)
+{
+    lvgl_raylib_prerender_t * oldest = lvgl_raylib_prerender_oldest();
+    if (oldest != NULL) {
+        lvgl_raylib_prerender_release(oldest);
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef LVGL_RAYLIB_PRERENDER_H
+#define LVGL_RAYLIB_PRERENDER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "lvgl_raylib_display.h"
+
+/* public types */
+
+typedef struct {
+    lv_obj_t * scr;
+    lv_draw_buf_t * draw_buf;
+    int32_t next_row;           // first row not rendered yet
+    float budget;               // seconds per frame
+    uint32_t last_used;
+} lvgl_raylib_prerender_t;
+
+/* public functions */
+
+void lvgl_raylib_prerender_init(lvgl_raylib_display_t * display);
+void lvgl_raylib_prerender_update(void);
+void lvgl_raylib_prerender_deinit(void);
+
+#endif
@@ -0,0 +1,289 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_compose.h"
+#include "lvgl_raylib_scroll.h"
+
+/* private prototypes */
+
+static lvgl_raylib_scroll_t * lvgl_raylib_scroll_find(const lv_obj_t * obj);
+static bool lvgl_raylib_scroll_is_safe(lv_obj_t * obj, const lv_area_t * region);
+static bool lvgl_raylib_scroll_has_pending_inv(const lv_area_t * region);
+static void lvgl_raylib_scroll_shift(const lv_area_t * region, int32_t dx, int32_t dy);
+static void lvgl_raylib_scroll_invalidate_extras(lv_obj_t * obj);
+static void lvgl_raylib_scroll_event_cb(lv_event_t * e);
+static void lvgl_raylib_scroll_delete_cb(lv_event_t * e);
+static void lvgl_raylib_scroll_invalidate_area_cb(lv_event_t * e);
+
+/* static variables */
+
+static lvgl_raylib_display_t * _display = NULL;
+static lv_ll_t _scrollables;
+
+// Set between a shifted scroll step and LVGL's own invalidation of the container
+static lv_obj_t * _pending_obj = NULL;
+static lv_area_t _pending_region;
+static lv_area_t _pending_strip;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_scroll_init(lvgl_raylib_display_t * display)
+{
+    _display = display;
+    lv_ll_init(&_scrollables, sizeof(lvgl_raylib_scroll_t));
+    lv_display_add_event_cb(display->disp, &lvgl_raylib_scroll_invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+}
+
+void lvgl_raylib_scroll_accelerate(lv_obj_t * obj)
+{
+    if (lvgl_raylib_scroll_find(obj) != NULL) {
+        return;
+    }
+
+    lvgl_raylib_scroll_t * scroll = lv_ll_ins_tail(&_scrollables);
+    if (scroll == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate accelerated scroll entry");
+        return;
+    }
+
+    scroll->obj = obj;
+    scroll->scroll_x = lv_obj_get_scroll_x(obj);
+    scroll->scroll_y = lv_obj_get_scroll_y(obj);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_scroll_event_cb, LV_EVENT_SCROLL, NULL);
+    lv_obj_add_event_cb(obj, &lvgl_raylib_scroll_delete_cb, LV_EVENT_DELETE, NULL);
+}
+
+void lvgl_raylib_scroll_frame_end(void)
+{
+    // LVGL consumes the pending replacement right after the scroll event,
+    // never let a stale one rewrite an unrelated invalidation
+    _pending_obj = NULL;
+}
+
+void lvgl_raylib_scroll_deinit(void)
+{
+    if (_display != NULL && _display->disp != NULL) {
+        lv_display_remove_event_cb_with_user_data(_display->disp, &lvgl_raylib_scroll_invalidate_area_cb, NULL);
+    }
+    lv_ll_clear(&_scrollables);
+    _pending_obj = NULL;
+    _display = NULL;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_scroll_t * lvgl_raylib_scroll_find(const lv_obj_t * obj)
+{
+    lvgl_raylib_scroll_t * scroll;
+    LV_LL_READ(&_scrollables, scroll) {
+        if (scroll->obj == obj) {
+            return scroll;
+        }
+    }
+    return NULL;
+}
+
+static bool lvgl_raylib_scroll_is_safe(lv_obj_t * obj, const lv_area_t * region)
+{
+    // The background must hide everything behind the container and must not
+    // change along the scroll direction
+    if (lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) != LV_OPA_COVER ||
+        lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN) != LV_OPA_COVER ||
+        lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE ||
+        lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN) != NULL ||
+        lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) != LV_BLEND_MODE_NORMAL ||
+        lv_obj_get_style_transform_rotation(obj, LV_PART_MAIN) != 0 ||
+        lv_obj_get_style_transform_scale_x(obj, LV_PART_MAIN) != LV_SCALE_NONE ||
+        lv_obj_get_style_transform_scale_y(obj, LV_PART_MAIN) != LV_SCALE_NONE) {
+        return false;
+    }
+
+    // Floating children stay in place while the rest of the content moves
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < child_cnt; i++) {
+        if (lv_obj_has_flag(lv_obj_get_child(obj, (int32_t)i), LV_OBJ_FLAG_FLOATING)) {
+            return false;
+        }
+    }
+
+    // Overlays would be dragged along with the content
+    if (lvgl_raylib_compose_is_covered(obj, region)) {
+        return false;
+    }
+
+    // The staging image must hold exactly what is on screen in the region
+    return !lvgl_raylib_scroll_has_pending_inv(region);
+}
+
+static bool lvgl_raylib_scroll_has_pending_inv(const lv_area_t * region)
+{
+    lv_display_t * disp = _display->disp;
+    for (uint32_t i = 0; i < disp->inv_p; i++) {
+        if (disp->inv_area_joined[i]) {
+            continue;
+        }
+        if (lv_area_is_on(&disp->inv_areas[i], region)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void lvgl_raylib_scroll_shift(const lv_area_t * region, int32_t dx, int32_t dy)
+{
+    uint8_t * data = (uint8_t *)_display->raylib_img.data;
+    int32_t stride = _display->raylib_img.width * 4;
+
+    // Destination is the part of the region that still shows old content
+    lv_area_t dst = *region;
+    if (dy > 0) dst.y1 += dy; else dst.y2 += dy;
+    if (dx > 0) dst.x1 += dx; else dst.x2 += dx;
+
+    size_t row_bytes = (size_t)lv_area_get_width(&dst) * 4;
+    int32_t row_cnt = lv_area_get_height(&dst);
+
+    // Walk rows against the shift direction so sources are read before being overwritten
+    for (int32_t i = 0; i < row_cnt; i++) {
+        int32_t y = dy > 0 ? dst.y2 - i : dst.y1 + i;
+        uint8_t * dst_row = data + y * stride + dst.x1 * 4;
+        const uint8_t * src_row = data + (y - dy) * stride + (dst.x1 - dx) * 4;
+        memmove(dst_row, src_row, row_bytes);
+    }
+
+    _display->texture_updated = true;
+}
+
+static void lvgl_raylib_scroll_invalidate_extras(lv_obj_t * obj)
+{
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    // Scrollbars move independently of the content, redraw their whole track
+    lv_area_t hor;
+    lv_area_t ver;
+    lv_obj_get_scrollbar_area(obj, &hor, &ver);
+    if (lv_area_get_size(&ver) > 0) {
+        ver.y1 = coords.y1;
+        ver.y2 = coords.y2;
+        lv_obj_invalidate_area(obj, &ver);
+    }
+    if (lv_area_get_size(&hor) > 0) {
+        hor.x1 = coords.x1;
+        hor.x2 = coords.x2;
+        lv_obj_invalidate_area(obj, &hor);
+    }
+
+    // The border is drawn by the container and doesn't scroll, content slides under it
+    int32_t border = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    if (border > 0) {
+        lv_area_t edge = coords;
+        edge.y2 = coords.y1 + border - 1;
+        lv_obj_invalidate_area(obj, &edge);
+        edge = coords;
+        edge.y1 = coords.y2 - border + 1;
+        lv_obj_invalidate_area(obj, &edge);
+        edge = coords;
+        edge.x2 = coords.x1 + border - 1;
+        lv_obj_invalidate_area(obj, &edge);
+        edge = coords;
+        edge.x1 = coords.x2 - border + 1;
+        lv_obj_invalidate_area(obj, &edge);
+    }
+
+    // Rounded corners show the parent through them, which doesn't scroll either
+    int32_t radius = LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN),
+                            LV_MIN(lv_area_get_width(&coords), lv_area_get_height(&coords)) / 2);
+    if (radius > 0) {
+        lv_area_t corner = { coords.x1, coords.y1, coords.x1 + radius - 1, coords.y1 + radius - 1 };
+        lv_obj_invalidate_area(obj, &corner);
+        lv_area_move(&corner, lv_area_get_width(&coords) - radius, 0);
+        lv_obj_invalidate_area(obj, &corner);
+        lv_area_move(&corner, 0, lv_area_get_height(&coords) - radius);
+        lv_obj_invalidate_area(obj, &corner);
+        lv_area_move(&corner, -(lv_area_get_width(&coords) - radius), 0);
+        lv_obj_invalidate_area(obj, &corner);
+    }
+}
+
+static void lvgl_raylib_scroll_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lvgl_raylib_scroll_t * scroll = lvgl_raylib_scroll_find(obj);
+    if (scroll == NULL || _display == NULL || !_display->texture_created) {
+        return;
+    }
+
+    // Children moved by the opposite of the scroll offset change
+    int32_t scroll_x = lv_obj_get_scroll_x(obj);
+    int32_t scroll_y = lv_obj_get_scroll_y(obj);
+    int32_t dx = scroll->scroll_x - scroll_x;
+    int32_t dy = scroll->scroll_y - scroll_y;
+    scroll->scroll_x = scroll_x;
+    scroll->scroll_y = scroll_y;
+    _pending_obj = NULL;
+
+    // Only straight scrolls leave a single exposed strip
+    if ((dx != 0) == (dy != 0)) {
+        return;
+    }
+
+    lv_area_t region;
+    if (!lvgl_raylib_compose_get_clip(obj, &region)) {
+        return;
+    }
+    if (LV_ABS(dx) >= lv_area_get_width(&region) || LV_ABS(dy) >= lv_area_get_height(&region)) {
+        return;
+    }
+    if (!lvgl_raylib_scroll_is_safe(obj, &region)) {
+        return;
+    }
+
+    lvgl_raylib_scroll_shift(&region, dx, dy);
+
+    // The strip the content moved away from is all LVGL has to render
+    _pending_strip = region;
+    if (dy > 0) _pending_strip.y2 = region.y1 + dy - 1;
+    else if (dy < 0) _pending_strip.y1 = region.y2 + dy + 1;
+    else if (dx > 0) _pending_strip.x2 = region.x1 + dx - 1;
+    else _pending_strip.x1 = region.x2 + dx + 1;
+
+    lvgl_raylib_scroll_invalidate_extras(obj);
+
+    _pending_obj = obj;
+    _pending_region = region;
+}
+
+static void lvgl_raylib_scroll_invalidate_area_cb(lv_event_t * e)
+{
+    if (_pending_obj == NULL) {
+        return;
+    }
+
+    // Replace LVGL's invalidation of the whole container (the one following the
+    // scroll event) with the exposed strip
+    lv_area_t * area = lv_event_get_invalidated_area(e);
+    lv_area_t obj_area;
+    lv_obj_get_coords(_pending_obj, &obj_area);
+    int32_t ext = lv_obj_get_ext_draw_size(_pending_obj);
+    lv_area_increase(&obj_area, ext, ext);
+
+    if (lv_area_is_in(&_pending_region, area, 0) && lv_area_is_in(area, &obj_area, 0)) {
+        *area = _pending_strip;
+        _pending_obj = NULL;
+    }
+}
+
+static void lvgl_raylib_scroll_delete_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lvgl_raylib_scroll_t * scroll = lvgl_raylib_scroll_find(obj);
+    if (scroll != NULL) {
+        lv_ll_remove(&_scrollables, scroll);
+        lv_free(scroll);
+    }
+    if (_pending_obj == obj) {
+        _pending_obj = NULL;
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef LVGL_RAYLIB_SCROLL_H
+#define LVGL_RAYLIB_SCROLL_H
+
+#include <stdbool.h>
+#include "lvgl.h"
+#include "lvgl_raylib_display.h"
+
+/* public types */
+
+typedef struct {
+    lv_obj_t * obj;
+    int32_t scroll_x;
+    int32_t scroll_y;
+} lvgl_raylib_scroll_t;
+
+/* public functions */
+
+void lvgl_raylib_scroll_init(lvgl_raylib_display_t * display);
+void lvgl_raylib_scroll_frame_end(void);
+void lvgl_raylib_scroll_deinit(void);
+
+#endif
@@ -0,0 +1,212 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_transition.h"
+#include "lvgl_raylib_layer.h"
+
+/* private prototypes */
+
+static bool lvgl_raylib_transition_start(lv_obj_t * scr, uint32_t time, bool auto_del);
+static bool lvgl_raylib_transition_snapshot(lv_obj_t * scr, Texture2D * texture);
+static void lvgl_raylib_transition_finish(void);
+static void lvgl_raylib_transition_draw_at(Texture2D texture, float x, float y, float scale, float alpha);
+
+/* static variables */
+
+static lvgl_raylib_display_t * _display = NULL;
+static lvgl_raylib_transition_t _transition = {0};
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_transition_init(lvgl_raylib_display_t * display)
+{
+    _display = display;
+}
+
+void lvgl_raylib_screen_load_anim(lv_obj_t * scr, lvgl_raylib_transition_type_t type, uint32_t time, bool auto_del)
+{
+    if (type == LVGL_RAYLIB_TRANSITION_SHADER) {
+        TraceLog(LOG_WARNING, "Use lvgl_raylib_screen_load_shader() for shader transitions");
+        type = LVGL_RAYLIB_TRANSITION_FADE;
+    }
+
+    _transition.type = type;
+    lvgl_raylib_transition_start(scr, time, auto_del);
+}
+
+void lvgl_raylib_screen_load_shader(lv_obj_t * scr, Shader shader, uint32_t time, bool auto_del)
+{
+    _transition.type = LVGL_RAYLIB_TRANSITION_SHADER;
+    _transition.shader = shader;
+    _transition.progress_loc = GetShaderLocation(shader, "progress");
+    _transition.texture_in_loc = GetShaderLocation(shader, "textureIn");
+    lvgl_raylib_transition_start(scr, time, auto_del);
+}
+
+bool lvgl_raylib_transition_is_running(void)
+{
+    return _transition.running;
+}
+
+bool lvgl_raylib_transition_render(void)
+{
+    if (!_transition.running) {
+        return false;
+    }
+
+    float t = (float)((GetTime() - _transition.start_time) / _transition.duration);
+    if (t >= 1.0f) {
+        // LVGL has been rendering the new screen behind the transition all along
+        lvgl_raylib_transition_finish();
+        return false;
+    }
+
+    // Ease out cubic
+    float p = 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t);
+    float w = (float)_display->raylib_img.width;
+    float h = (float)_display->raylib_img.height;
+
+    switch (_transition.type) {
+        case LVGL_RAYLIB_TRANSITION_FADE:
+            lvgl_raylib_transition_draw_at(_transition.texture_out, 0, 0, 1.0f, 1.0f);
+            lvgl_raylib_transition_draw_at(_transition.texture_in, 0, 0, 1.0f, p);
+            break;
+        case LVGL_RAYLIB_TRANSITION_SLIDE_LEFT:
+            lvgl_raylib_transition_draw_at(_transition.texture_out, -w * p, 0, 1.0f, 1.0f);
+            lvgl_raylib_transition_draw_at(_transition.texture_in, w * (1.0f - p), 0, 1.0f, 1.0f);
+            break;
+        case LVGL_RAYLIB_TRANSITION_SLIDE_RIGHT:
+            lvgl_raylib_transition_draw_at(_transition.texture_out, w * p, 0, 1.0f, 1.0f);
+            lvgl_raylib_transition_draw_at(_transition.texture_in, -w * (1.0f - p), 0, 1.0f, 1.0f);
+            break;
+        case LVGL_RAYLIB_TRANSITION_SLIDE_UP:
+            lvgl_raylib_transition_draw_at(_transition.texture_out, 0, -h * p, 1.0f, 1.0f);
+            lvgl_raylib_transition_draw_at(_transition.texture_in, 0, h * (1.0f - p), 1.0f, 1.0f);
+            break;
+        case LVGL_RAYLIB_TRANSITION_SLIDE_DOWN:
+            lvgl_raylib_transition_draw_at(_transition.texture_out, 0, h * p, 1.0f, 1.0f);
+            lvgl_raylib_transition_draw_at(_transition.texture_in, 0, -h * (1.0f - p), 1.0f, 1.0f);
+            break;
+        case LVGL_RAYLIB_TRANSITION_ZOOM:
+            lvgl_raylib_transition_draw_at(_transition.texture_out, 0, 0, 1.0f + 0.1f * p, 1.0f - p);
+            lvgl_raylib_transition_draw_at(_transition.texture_in, 0, 0, 0.8f + 0.2f * p, p);
+            break;
+        case LVGL_RAYLIB_TRANSITION_SHADER:
+            // The shader samples the outgoing screen as texture0 and the incoming one as textureIn
+            BeginShaderMode(_transition.shader);
+            SetShaderValue(_transition.shader, _transition.progress_loc, &p, SHADER_UNIFORM_FLOAT);
+            SetShaderValueTexture(_transition.shader, _transition.texture_in_loc, _transition.texture_in);
+            lvgl_raylib_transition_draw_at(_transition.texture_out, 0, 0, 1.0f, 1.0f);
+            EndShaderMode();
+            break;
+    }
+
+    // The top layer belongs to neither screen and stays in place
+    if (_transition.texture_top.id != 0) {
+        lvgl_raylib_transition_draw_at(_transition.texture_top, 0, 0, 1.0f, 1.0f);
+    }
+
+    return true;
+}
+
+void lvgl_raylib_transition_deinit(void)
+{
+    if (_transition.running) {
+        lvgl_raylib_transition_finish();
+    }
+    _display = NULL;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool lvgl_raylib_transition_start(lv_obj_t * scr, uint32_t time, bool auto_del)
+{
+    if (_transition.running) {
+        lvgl_raylib_transition_finish();
+    }
+
+    if (_display == NULL || !_display->texture_created || time == 0) {
+        lv_screen_load_anim(scr, LV_SCR_LOAD_ANIM_NONE, 0, 0, auto_del);
+        return false;
+    }
+
+    // Both screens are rendered the same way, once, before the new one becomes active. The
+    // staging image can't stand in for the outgoing one: it may lag behind pending
+    // invalidations and holds the top layer, which the incoming snapshot wouldn't.
+    bool ok = lvgl_raylib_transition_snapshot(lv_screen_active(), &_transition.texture_out);
+    ok = ok && lvgl_raylib_transition_snapshot(scr, &_transition.texture_in);
+    if (ok && lv_obj_get_child_count(lv_layer_top()) > 0) {
+        ok = lvgl_raylib_transition_snapshot(lv_layer_top(), &_transition.texture_top);
+    }
+    if (!ok) {
+        lvgl_raylib_transition_finish();
+        lv_screen_load_anim(scr, LV_SCR_LOAD_ANIM_NONE, 0, 0, auto_del);
+        return false;
+    }
+
+    _transition.start_time = GetTime();
+    _transition.duration = time / 1000.0f;
+    _transition.running = true;
+
+    // Switch immediately: input already goes to the new screen and LVGL renders it
+    // behind the transition, which is handed back when the animation ends
+    lv_screen_load_anim(scr, LV_SCR_LOAD_ANIM_NONE, 0, 0, auto_del);
+    return true;
+}
+
+static bool lvgl_raylib_transition_snapshot(lv_obj_t * scr, Texture2D * texture)
+{
+    // Promoted layers are drawn from their textures, as lvgl_raylib_render() shows them
+    lv_obj_update_layout(scr);
+    lvgl_raylib_layer_capture_begin();
+    lv_draw_buf_t * snapshot = lv_snapshot_take(scr, LV_COLOR_FORMAT_ARGB8888);
+    lvgl_raylib_layer_capture_end();
+    if (snapshot == NULL) {
+        TraceLog(LOG_ERROR, "Failed to render a screen for the transition");
+        return false;
+    }
+
+    int w = (int)snapshot->header.w;
+    int h = (int)snapshot->header.h;
+    uint8_t * pixels = malloc((size_t)w * h * 4);
+    if (pixels == NULL) {
+        lv_draw_buf_destroy(snapshot);
+        return false;
+    }
+    lvgl_raylib_display_convert_argb8888(pixels, (uint32_t)w * 4, snapshot->data, snapshot->header.stride, (uint32_t)w, (uint32_t)h);
+    lv_draw_buf_destroy(snapshot);
+
+    Image image = { pixels, w, h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    *texture = LoadTextureFromImage(image);
+    free(pixels);
+    return texture->id != 0;
+}
+
+static void lvgl_raylib_transition_finish(void)
+{
+    // Also cleans up after a failed start, where some textures were never loaded
+    Texture2D * textures[] = { &_transition.texture_out, &_transition.texture_in, &_transition.texture_top };
+    for (size_t i = 0; i < sizeof(textures) / sizeof(textures[0]); i++) {
+        if (textures[i]->id != 0) {
+            UnloadTexture(*textures[i]);
+            textures[i]->id = 0;
+        }
+    }
+    _transition.running = false;
+}
+
+static void lvgl_raylib_transition_draw_at(Texture2D texture, float x, float y, float scale, float alpha)
+{
+    // Scale around the screen center
+    float w = (float)texture.width * scale;
+    float h = (float)texture.height * scale;
+    Rectangle src = { 0, 0, (float)texture.width, (float)texture.height };
+    Rectangle dst = {
+        x + ((float)texture.width - w) / 2.0f,
+        y + ((float)texture.height - h) / 2.0f,
+        w, h
+    };
+    DrawTexturePro(texture, src, dst, (Vector2){ 0, 0 }, 0.0f, Fade(WHITE, alpha));
+}
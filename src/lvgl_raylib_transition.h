@@ -0,0 +1,31 @@
+#ifndef LVGL_RAYLIB_TRANSITION_H
+#define LVGL_RAYLIB_TRANSITION_H
+
+#include <stdbool.h>
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_display.h"
+
+/* public types */
+
+typedef struct {
+    bool running;
+    lvgl_raylib_transition_type_t type;
+    Shader shader;
+    int progress_loc;
+    int texture_in_loc;
+    Texture2D texture_out;
+    Texture2D texture_in;
+    Texture2D texture_top;      // lv_layer_top(), drawn over both screens; id 0 when empty
+    double start_time;
+    float duration;
+} lvgl_raylib_transition_t;
+
+/* public functions */
+
+void lvgl_raylib_transition_init(lvgl_raylib_display_t * display);
+bool lvgl_raylib_transition_render(void);
+void lvgl_raylib_transition_deinit(void);
+
+#endif
@@ -0,0 +1,399 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl_private.h"
+#include "rlgl.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_video.h"
+
+/* private prototypes */
+
+static lvgl_raylib_video_t * lvgl_raylib_video_find(const lv_obj_t * obj);
+static bool lvgl_raylib_video_open_file(lvgl_raylib_video_t * video, const char * path);
+static bool lvgl_raylib_video_parse_y4m_header(lvgl_raylib_video_t * video);
+static bool lvgl_raylib_video_read_frame(lvgl_raylib_video_t * video);
+static void lvgl_raylib_video_close_file(lvgl_raylib_video_t * video);
+static bool lvgl_raylib_video_setup_planes(lvgl_raylib_video_t * video, int width, int height);
+static void lvgl_raylib_video_upload(lvgl_raylib_video_t * video, const uint8_t * y, const uint8_t * u, const uint8_t * v);
+static void lvgl_raylib_video_unload_planes(lvgl_raylib_video_t * video);
+static bool lvgl_raylib_video_load_shader(void);
+static void lvgl_raylib_video_draw_cb(lv_obj_t * obj, Rectangle dst, void * user_data);
+static void lvgl_raylib_video_delete_cb(lv_event_t * e);
+
+/* static variables */
+
+static lv_ll_t _videos;
+
+// 8 bit 4:2:0 in its chroma siting variants, the only ones matching our planes.
+// High bit depth (C420p10, C420p12...) has two bytes per sample.
+static const char * const _y4m_colorspaces[] = { "420", "420jpeg", "420paldv", "420mpeg2" };
+static Shader _yuv_shader = {0};
+static int _yuv_loc_u = -1;
+static int _yuv_loc_v = -1;
+
+// BT.601 limited range, the colorspace of Y4M files and most webcams
+static const char * _yuv_fs_330 =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform sampler2D textureU;\n"
+    "uniform sampler2D textureV;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float y = 1.1643 * (texture(texture0, fragTexCoord).r - 0.0625);\n"
+    "    float u = texture(textureU, fragTexCoord).r - 0.5;\n"
+    "    float v = texture(textureV, fragTexCoord).r - 0.5;\n"
+    "    vec3 rgb = vec3(y + 1.5958 * v, y - 0.39173 * u - 0.81290 * v, y + 2.017 * u);\n"
+    "    finalColor = vec4(clamp(rgb, 0.0, 1.0), 1.0) * fragColor;\n"
+    "}\n";
+
+static const char * _yuv_fs_100 =
+    "#version 100\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform sampler2D textureU;\n"
+    "uniform sampler2D textureV;\n"
+    "void main() {\n"
+    "    float y = 1.1643 * (texture2D(texture0, fragTexCoord).r - 0.0625);\n"
+    "    float u = texture2D(textureU, fragTexCoord).r - 0.5;\n"
+    "    float v = texture2D(textureV, fragTexCoord).r - 0.5;\n"
+    "    vec3 rgb = vec3(y + 1.5958 * v, y - 0.39173 * u - 0.81290 * v, y + 2.017 * u);\n"
+    "    gl_FragColor = vec4(clamp(rgb, 0.0, 1.0), 1.0) * fragColor;\n"
+    "}\n";
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_video_init(void)
+{
+    lv_ll_init(&_videos, sizeof(lvgl_raylib_video_t));
+}
+
+lv_obj_t * lvgl_raylib_video_create(lv_obj_t * parent)
+{
+    if (!lvgl_raylib_video_load_shader()) {
+        return NULL;
+    }
+
+    lvgl_raylib_video_t * video = lv_ll_ins_tail(&_videos);
+    if (video == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate LVGL Raylib video");
+        return NULL;
+    }
+    memset(video, 0, sizeof(*video));
+
+    // The video is a viewport: LVGL only reserves its rectangle, the frames are
+    // converted and composited on the GPU by lvgl_raylib_render()
+    video->obj = lvgl_raylib_viewport_create(parent);
+    if (video->obj == NULL) {
+        lv_ll_remove(&_videos, video);
+        lv_free(video);
+        return NULL;
+    }
+    lvgl_raylib_viewport_set_draw_cb(video->obj, &lvgl_raylib_video_draw_cb, video);
+    lv_obj_add_event_cb(video->obj, &lvgl_raylib_video_delete_cb, LV_EVENT_DELETE, NULL);
+
+    return video->obj;
+}
+
+bool lvgl_raylib_video_open_y4m(lv_obj_t * obj, const char * path)
+{
+    lvgl_raylib_video_t * video = lvgl_raylib_video_find(obj);
+    if (video == NULL || !lvgl_raylib_video_open_file(video, path)) {
+        return false;
+    }
+
+    video->y4m = true;
+    if (!lvgl_raylib_video_parse_y4m_header(video)) {
+        TraceLog(LOG_ERROR, "Unsupported Y4M file: %s", path);
+        lvgl_raylib_video_close_file(video);
+        return false;
+    }
+
+    return lvgl_raylib_video_setup_planes(video, video->width, video->height);
+}
+
+bool lvgl_raylib_video_open_raw(lv_obj_t * obj, const char * path, int width, int height, float fps)
+{
+    lvgl_raylib_video_t * video = lvgl_raylib_video_find(obj);
+    if (video == NULL || !lvgl_raylib_video_open_file(video, path)) {
+        return false;
+    }
+
+    video->y4m = false;
+    video->fps = fps;
+    return lvgl_raylib_video_setup_planes(video, width, height);
+}
+
+void lvgl_raylib_video_push_frame(lv_obj_t * obj, int width, int height, const uint8_t * y, const uint8_t * u, const uint8_t * v)
+{
+    lvgl_raylib_video_t * video = lvgl_raylib_video_find(obj);
+    if (video == NULL) {
+        TraceLog(LOG_WARNING, "Object is not an LVGL Raylib video");
+        return;
+    }
+
+    lvgl_raylib_video_close_file(video);
+    if (video->width != width || video->height != height) {
+        if (!lvgl_raylib_video_setup_planes(video, width, height)) {
+            return;
+        }
+    }
+    lvgl_raylib_video_upload(video, y, u, v);
+}
+
+void lvgl_raylib_video_update(void)
+{
+    double now = GetTime();
+
+    lvgl_raylib_video_t * video;
+    LV_LL_READ(&_videos, video) {
+        if (video->file == NULL || video->fps <= 0.0f) {
+            continue;
+        }
+
+        // frame_index counts the frames read so far; frame N is due at N / fps.
+        // Late frames are read and dropped instead of letting playback drift.
+        int64_t due = (int64_t)((now - video->start_time) * video->fps);
+        bool read = false;
+        while (video->frame_index <= due) {
+            if (!lvgl_raylib_video_read_frame(video)) {
+                // Loop the file
+                fseek(video->file, video->data_start, SEEK_SET);
+                video->start_time = now;
+                video->frame_index = 0;
+                due = 0;
+                if (!lvgl_raylib_video_read_frame(video)) {
+                    break;
+                }
+            }
+            video->frame_index++;
+            read = true;
+        }
+
+        if (read) {
+            size_t y_size = (size_t)video->width * video->height;
+            size_t c_size = (size_t)(video->width / 2) * (video->height / 2);
+            lvgl_raylib_video_upload(video, video->frame_buf, video->frame_buf + y_size, video->frame_buf + y_size + c_size);
+        }
+    }
+}
+
+void lvgl_raylib_video_deinit(void)
+{
+    lvgl_raylib_video_t * video;
+    LV_LL_READ(&_videos, video) {
+        lvgl_raylib_video_close_file(video);
+        lvgl_raylib_video_unload_planes(video);
+    }
+    lv_ll_clear(&_videos);
+
+    if (_yuv_shader.id != 0) {
+        UnloadShader(_yuv_shader);
+        _yuv_shader.id = 0;
+    }
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_video_t * lvgl_raylib_video_find(const lv_obj_t * obj)
+{
+    lvgl_raylib_video_t * video;
+    LV_LL_READ(&_videos, video) {
+        if (video->obj == obj) {
+            return video;
+        }
+    }
+    return NULL;
+}
+
+static bool lvgl_raylib_video_open_file(lvgl_raylib_video_t * video, const char * path)
+{
+    lvgl_raylib_video_close_file(video);
+
+    video->file = fopen(path, "rb");
+    if (video->file == NULL) {
+        TraceLog(LOG_ERROR, "Failed to open video file: %s", path);
+        return false;
+    }
+
+    video->data_start = 0;
+    video->start_time = GetTime();
+    video->frame_index = 0;
+    video->has_frame = false;
+    return true;
+}
+
+static bool lvgl_raylib_video_parse_y4m_header(lvgl_raylib_video_t * video)
+{
+    char header[256];
+    if (fgets(header, sizeof(header), video->file) == NULL || strncmp(header, "YUV4MPEG2 ", 10) != 0) {
+        return false;
+    }
+
+    int width = 0;
+    int height = 0;
+    int fps_num = 25;
+    int fps_den = 1;
+
+    char * token = strtok(header + 10, " \n");
+    while (token != NULL) {
+        switch (token[0]) {
+            case 'W': width = atoi(token + 1); break;
+            case 'H': height = atoi(token + 1); break;
+            case 'F': sscanf(token + 1, "%d:%d", &fps_num, &fps_den); break;
+            case 'C': {
+                bool supported = false;
+                for (size_t i = 0; i < sizeof(_y4m_colorspaces) / sizeof(_y4m_colorspaces[0]); i++) {
+                    supported |= strcmp(token + 1, _y4m_colorspaces[i]) == 0;
+                }
+                if (!supported) {
+                    TraceLog(LOG_WARNING, "Unsupported Y4M colorspace %s, only 8 bit 4:2:0 plays", token);
+                    return false;
+                }
+                break;
+            }
+            default: break;
+        }
+        token = strtok(NULL, " \n");
+    }
+
+    if (width <= 0 || height <= 0 || fps_num <= 0 || fps_den <= 0) {
+        return false;
+    }
+
+    video->width = width;
+    video->height = height;
+    video->fps = (float)fps_num / (float)fps_den;
+    video->data_start = ftell(video->file);
+    return true;
+}
+
+static bool lvgl_raylib_video_read_frame(lvgl_raylib_video_t * video)
+{
+    if (video->y4m) {
+        char line[128];
+        if (fgets(line, sizeof(line), video->file) == NULL || strncmp(line, "FRAME", 5) != 0) {
+            return false;
+        }
+    }
+
+    size_t frame_size = (size_t)video->width * video->height + 2 * (size_t)(video->width / 2) * (video->height / 2);
+    return fread(video->frame_buf, 1, frame_size, video->file) == frame_size;
+}
+
+static void lvgl_raylib_video_close_file(lvgl_raylib_video_t * video)
+{
+    if (video->file != NULL) {
+        fclose(video->file);
+        video->file = NULL;
+    }
+}
+
+static bool lvgl_raylib_video_setup_planes(lvgl_raylib_video_t * video, int width, int height)
+{
+    lvgl_raylib_video_unload_planes(video);
+
+    if (width <= 0 || height <= 0 || (width % 2) != 0 || (height % 2) != 0) {
+        TraceLog(LOG_ERROR, "Unsupported video size %dx%d, 4:2:0 needs even dimensions", width, height);
+        return false;
+    }
+
+    video->width = width;
+    video->height = height;
+
+    for (int i = 0; i < 3; i++) {
+        int plane_w = i == 0 ? width : width / 2;
+        int plane_h = i == 0 ? height : height / 2;
+        video->planes[i].id = rlLoadTexture(NULL, plane_w, plane_h, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE, 1);
+        video->planes[i].width = plane_w;
+        video->planes[i].height = plane_h;
+        video->planes[i].mipmaps = 1;
+        video->planes[i].format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+        SetTextureFilter(video->planes[i], TEXTURE_FILTER_BILINEAR);
+    }
+
+    if (video->file != NULL) {
+        video->frame_buf = malloc((size_t)width * height * 3 / 2);
+        if (video->frame_buf == NULL) {
+            TraceLog(LOG_ERROR, "Failed to allocate video frame buffer");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void lvgl_raylib_video_upload(lvgl_raylib_video_t * video, const uint8_t * y, const uint8_t * u, const uint8_t * v)
+{
+    UpdateTexture(video->planes[0], y);
+    UpdateTexture(video->planes[1], u);
+    UpdateTexture(video->planes[2], v);
+    video->has_frame = true;
+}
+
+static void lvgl_raylib_video_unload_planes(lvgl_raylib_video_t * video)
+{
+    for (int i = 0; i < 3; i++) {
+        if (video->planes[i].id != 0) {
+            UnloadTexture(video->planes[i]);
+            video->planes[i].id = 0;
+        }
+    }
+    free(video->frame_buf);
+    video->frame_buf = NULL;
+    video->width = 0;
+    video->height = 0;
+    video->has_frame = false;
+}
+
+static bool lvgl_raylib_video_load_shader(void)
+{
+    if (_yuv_shader.id != 0) {
+        return true;
+    }
+
+    const char * fs = rlGetVersion() == RL_OPENGL_ES_20 ? _yuv_fs_100 : _yuv_fs_330;
+    _yuv_shader = LoadShaderFromMemory(NULL, fs);
+    if (!IsShaderValid(_yuv_shader)) {
+        TraceLog(LOG_ERROR, "Failed to compile YUV video shader");
+        _yuv_shader.id = 0;
+        return false;
+    }
+
+    _yuv_loc_u = GetShaderLocation(_yuv_shader, "textureU");
+    _yuv_loc_v = GetShaderLocation(_yuv_shader, "textureV");
+    return true;
+}
+
+static void lvgl_raylib_video_draw_cb(lv_obj_t * obj, Rectangle dst, void * user_data)
+{
+    LV_UNUSED(obj);
+    lvgl_raylib_video_t * video = (lvgl_raylib_video_t *)user_data;
+    if (!video->has_frame) {
+        return;
+    }
+
+    // The Y plane is drawn as the main texture, chroma planes are bound as extra samplers
+    BeginShaderMode(_yuv_shader);
+    SetShaderValueTexture(_yuv_shader, _yuv_loc_u, video->planes[1]);
+    SetShaderValueTexture(_yuv_shader, _yuv_loc_v, video->planes[2]);
+    Rectangle src = { 0, 0, (float)video->width, (float)video->height };
+    DrawTexturePro(video->planes[0], src, dst, (Vector2){ 0, 0 }, 0.0f, WHITE);
+    EndShaderMode();
+}
+
+static void lvgl_raylib_video_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_video_t * video = lvgl_raylib_video_find(lv_event_get_target(e));
+    if (video != NULL) {
+        lvgl_raylib_video_close_file(video);
+        lvgl_raylib_video_unload_planes(video);
+        lv_ll_remove(&_videos, video);
+        lv_free(video);
+    }
+}
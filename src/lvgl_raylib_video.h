@@ -0,0 +1,35 @@
+#ifndef LVGL_RAYLIB_VIDEO_H
+#define LVGL_RAYLIB_VIDEO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "lvgl.h"
+#include "raylib.h"
+
+/* public types */
+
+typedef struct {
+    lv_obj_t * obj;
+    int width;
+    int height;
+    Texture2D planes[3];        // Y, U and V, one byte per texel
+    bool has_frame;
+
+    // file playback, NULL when frames are pushed by the application
+    FILE * file;
+    long data_start;
+    bool y4m;                   // frames are preceded by a "FRAME" line
+    float fps;
+    double start_time;
+    int64_t frame_index;
+    uint8_t * frame_buf;
+} lvgl_raylib_video_t;
+
+/* public functions */
+
+void lvgl_raylib_video_init(void);
+void lvgl_raylib_video_update(void);
+void lvgl_raylib_video_deinit(void);
+
+#endif
@@ -0,0 +1,154 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl_private.h"
+#include "lvgl_raylib.h"
+#include "lvgl_raylib_compose.h"
+#include "lvgl_raylib_viewport.h"
+
+/* private prototypes */
+
+static lvgl_raylib_viewport_t * lvgl_raylib_viewport_find(const lv_obj_t * obj);
+static bool lvgl_raylib_viewport_has_content(const lvgl_raylib_viewport_t * viewport);
+static void lvgl_raylib_viewport_draw_main_cb(lv_event_t * e);
+static void lvgl_raylib_viewport_delete_cb(lv_event_t * e);
+
+/* static variables */
+
+static lv_ll_t _viewports;
+
+/* PUBLIC IMPLEMENTATION */
+
+void lvgl_raylib_viewport_init(void)
+{
+    lv_ll_init(&_viewports, sizeof(lvgl_raylib_viewport_t));
+}
+
+lv_obj_t * lvgl_raylib_viewport_create(lv_obj_t * parent)
+{
+    lvgl_raylib_viewport_t * viewport = lv_ll_ins_tail(&_viewports);
+    if (viewport == NULL) {
+        TraceLog(LOG_ERROR, "Failed to allocate LVGL Raylib viewport");
+        return NULL;
+    }
+
+    // A bare object: it only takes part in layout, scrolling and clipping and cuts a
+    // hole into what LVGL draws, the pixels are composited under it by lvgl_raylib_render()
+    viewport->obj = lv_obj_create(parent);
+    viewport->target = NULL;
+    viewport->draw_cb = NULL;
+    viewport->user_data = NULL;
+    lv_obj_remove_style_all(viewport->obj);
+    lv_obj_remove_flag(viewport->obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(viewport->obj, &lvgl_raylib_viewport_draw_main_cb, LV_EVENT_DRAW_MAIN, NULL);
+    lv_obj_add_event_cb(viewport->obj, &lvgl_raylib_viewport_delete_cb, LV_EVENT_DELETE, NULL);
+
+    return viewport->obj;
+}
+
+void lvgl_raylib_viewport_set_texture(lv_obj_t * obj, const RenderTexture2D * target)
+{
+    lvgl_raylib_viewport_t * viewport = lvgl_raylib_viewport_find(obj);
+    if (viewport == NULL) {
+        TraceLog(LOG_WARNING, "Object is not an LVGL Raylib viewport");
+        return;
+    }
+
+    viewport->target = target;
+    lv_obj_invalidate(obj);
+}
+
+void lvgl_raylib_viewport_set_draw_cb(lv_obj_t * obj, lvgl_raylib_viewport_draw_cb_t draw_cb, void * user_data)
+{
+    lvgl_raylib_viewport_t * viewport = lvgl_raylib_viewport_find(obj);
+    if (viewport == NULL) {
+        TraceLog(LOG_WARNING, "Object is not an LVGL Raylib viewport");
+        return;
+    }
+
+    viewport->draw_cb = draw_cb;
+    viewport->user_data = user_data;
+    lv_obj_invalidate(obj);
+}
+
+void lvgl_raylib_viewport_render(void)
+{
+    // Drawn before the LVGL texture, which is transparent in the viewports' holes. Objects
+    // above a viewport blend over its content, with their exact shape and antialiased edges.
+    lvgl_raylib_viewport_t * viewport;
+    LV_LL_READ(&_viewports, viewport) {
+        if (!lvgl_raylib_viewport_has_content(viewport)) {
+            continue;
+        }
+
+        lv_area_t clip;
+        if (!lvgl_raylib_compose_get_clip(viewport->obj, &clip)) {
+            continue;
+        }
+
+        lv_area_t coords;
+        lv_obj_get_coords(viewport->obj, &coords);
+
+        Rectangle dst = {
+            (float)coords.x1, (float)coords.y1,
+            (float)lv_area_get_width(&coords), (float)lv_area_get_height(&coords)
+        };
+
+        BeginScissorMode(clip.x1, clip.y1, lv_area_get_width(&clip), lv_area_get_height(&clip));
+        if (viewport->draw_cb != NULL) {
+            viewport->draw_cb(viewport->obj, dst, viewport->user_data);
+        } else {
+            // Render textures are stored bottom-up, flip them while sampling
+            const Texture2D * texture = &viewport->target->texture;
+            Rectangle src = { 0, 0, (float)texture->width, -(float)texture->height };
+            DrawTexturePro(*texture, src, dst, (Vector2){ 0, 0 }, 0.0f, WHITE);
+        }
+        EndScissorMode();
+    }
+}
+
+void lvgl_raylib_viewport_deinit(void)
+{
+    lv_ll_clear(&_viewports);
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lvgl_raylib_viewport_t * lvgl_raylib_viewport_find(const lv_obj_t * obj)
+{
+    lvgl_raylib_viewport_t * viewport;
+    LV_LL_READ(&_viewports, viewport) {
+        if (viewport->obj == obj) {
+            return viewport;
+        }
+    }
+    return NULL;
+}
+
+static bool lvgl_raylib_viewport_has_content(const lvgl_raylib_viewport_t * viewport)
+{
+    bool has_texture = viewport->target != NULL && viewport->target->texture.id != 0;
+    return has_texture || viewport->draw_cb != NULL;
+}
+
+static void lvgl_raylib_viewport_draw_main_cb(lv_event_t * e)
+{
+    // Without content the area keeps what LVGL drew under the viewport
+    lv_obj_t * obj = lv_event_get_target(e);
+    lvgl_raylib_viewport_t * viewport = lvgl_raylib_viewport_find(obj);
+    if (viewport == NULL || !lvgl_raylib_viewport_has_content(viewport)) {
+        return;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lvgl_raylib_compose_draw_hole(lv_event_get_layer(e), obj, &coords);
+}
+
+static void lvgl_raylib_viewport_delete_cb(lv_event_t * e)
+{
+    lvgl_raylib_viewport_t * viewport = lvgl_raylib_viewport_find(lv_event_get_target(e));
+    if (viewport != NULL) {
+        lv_ll_remove(&_viewports, viewport);
+        lv_free(viewport);
+    }
+}
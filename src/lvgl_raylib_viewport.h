@@ -0,0 +1,23 @@
+#ifndef LVGL_RAYLIB_VIEWPORT_H
+#define LVGL_RAYLIB_VIEWPORT_H
+
+#include "lvgl.h"
+#include "raylib.h"
+#include "lvgl_raylib.h"
+
+/* public types */
+
+typedef struct {
+    lv_obj_t * obj;
+    const RenderTexture2D * target;
+    lvgl_raylib_viewport_draw_cb_t draw_cb;
+    void * user_data;
+} lvgl_raylib_viewport_t;
+
+/* public functions */
+
+void lvgl_raylib_viewport_init(void);
+void lvgl_raylib_viewport_render(void);
+void lvgl_raylib_viewport_deinit(void);
+
+#endif
@@ -0,0 +1,402 @@
+/* Renders the same scenes with the GPU draw unit on and off and compares the pixels.
+ *
+ *   lvgl_raylib_draw_gpu_test
+ *
+ * The GPU output is not bit exact: anti-aliased edges come from distance functions instead
+ * of LVGL's masks. Every channel of every pixel has to be within the scene's max delta and
+ * the scene on average within LVGL_RAYLIB_TEST_MAX_MEAN. The unit's stats have to show that
+ * it drew the scene's tasks when enabled and none of them when disabled. Vector paths are
+ * drawn by the unit either way, that scene is checked against the colors it should have.
+ * Run with LIBGL_ALWAYS_SOFTWARE=1 to get the same results from Mesa on any machine. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+
+/* private defines */
+
+#define LVGL_RAYLIB_TEST_WIDTH     480
+#define LVGL_RAYLIB_TEST_HEIGHT    320
+#define LVGL_RAYLIB_TEST_MAX_DELTA 16
+#define LVGL_RAYLIB_TEST_SOFT_DELTA 32        // shadows: a closed form blur against LVGL's box blur
+#define LVGL_RAYLIB_TEST_MAX_MEAN  0.5
+#define LVGL_RAYLIB_TEST_IMAGE     128
+
+/* private types */
+
+typedef struct {
+    const char * name;
+    void (*create)(lv_obj_t * scr);
+    size_t stat;                // offset of the task counter in lvgl_raylib_draw_gpu_stats_t
+    int32_t max_delta;
+    bool (*check)(const lv_draw_buf_t * buf);   // for scenes without a software reference
+} scene_t;
+
+/* private prototypes */
+
+static lv_obj_t * box_create(lv_obj_t * parent, int32_t x, int32_t y, int32_t w, int32_t h);
+static void scene_fill(lv_obj_t * scr);
+static void scene_radius(lv_obj_t * scr);
+static void scene_border(lv_obj_t * scr);
+static void scene_outline(lv_obj_t * scr);
+static void scene_translucent(lv_obj_t * scr);
+static void scene_shadow(lv_obj_t * scr);
+static void scene_label(lv_obj_t * scr);
+static void scene_image(lv_obj_t * scr);
+static void scene_vector(lv_obj_t * scr);
+static void vector_draw_cb(lv_event_t * e);
+static bool vector_check(const lv_draw_buf_t * buf);
+static bool probe(const lv_draw_buf_t * buf, int32_t x, int32_t y, uint32_t color);
+static void image_init(void);
+static lv_draw_buf_t * render(const scene_t * scene, bool gpu, uint32_t * drawn);
+static bool compare(const scene_t * scene, const lv_draw_buf_t * sw, const lv_draw_buf_t * gpu);
+
+/* static variables */
+
+static const scene_t _scenes[] = {
+    { "fill", scene_fill, offsetof(lvgl_raylib_draw_gpu_stats_t, fills), LVGL_RAYLIB_TEST_MAX_DELTA, NULL },
+    { "radius", scene_radius, offsetof(lvgl_raylib_draw_gpu_stats_t, fills), LVGL_RAYLIB_TEST_MAX_DELTA, NULL },
+    { "border", scene_border, offsetof(lvgl_raylib_draw_gpu_stats_t, borders), LVGL_RAYLIB_TEST_MAX_DELTA, NULL },
+    { "outline", scene_outline, offsetof(lvgl_raylib_draw_gpu_stats_t, borders), LVGL_RAYLIB_TEST_MAX_DELTA, NULL },
+    { "translucent", scene_translucent, offsetof(lvgl_raylib_draw_gpu_stats_t, fills), LVGL_RAYLIB_TEST_MAX_DELTA, NULL },
+    { "shadow", scene_shadow, offsetof(lvgl_raylib_draw_gpu_stats_t, shadows), LVGL_RAYLIB_TEST_SOFT_DELTA, NULL },
+    { "label", scene_label, offsetof(lvgl_raylib_draw_gpu_stats_t, labels), LVGL_RAYLIB_TEST_MAX_DELTA, NULL },
+    { "image", scene_image, offsetof(lvgl_raylib_draw_gpu_stats_t, images), LVGL_RAYLIB_TEST_MAX_DELTA, NULL },
+    { "vector", scene_vector, offsetof(lvgl_raylib_draw_gpu_stats_t, vectors), LVGL_RAYLIB_TEST_MAX_DELTA, vector_check },
+};
+
+static uint32_t _pixels[LVGL_RAYLIB_TEST_IMAGE * LVGL_RAYLIB_TEST_IMAGE];
+static lv_image_dsc_t _image;
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(void)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(LVGL_RAYLIB_TEST_WIDTH, LVGL_RAYLIB_TEST_HEIGHT, "lvgl_raylib_draw_gpu_test");
+    lvgl_raylib_init(LVGL_RAYLIB_TEST_WIDTH, LVGL_RAYLIB_TEST_HEIGHT);
+    image_init();
+
+    int failed = 0;
+    for (size_t i = 0; i < sizeof(_scenes) / sizeof(_scenes[0]); i++) {
+        const scene_t * scene = &_scenes[i];
+        uint32_t sw_drawn = 0;
+        uint32_t gpu_drawn = 0;
+        lv_draw_buf_t * sw = render(scene, false, &sw_drawn);
+        lv_draw_buf_t * gpu = render(scene, true, &gpu_drawn);
+
+        // Without a software reference both renders come from the unit
+        bool reference = scene->check == NULL;
+        if ((reference && sw_drawn != 0) || gpu_drawn == 0) {
+            printf("%-12s %u tasks drawn by the unit while disabled, %u while enabled: FAILED\n",
+                   scene->name, (unsigned)sw_drawn, (unsigned)gpu_drawn);
+            failed++;
+        }
+        if (sw == NULL || gpu == NULL) {
+            printf("%-12s snapshot failed\n", scene->name);
+            failed++;
+        } else if (!compare(scene, sw, gpu)) {
+            failed++;
+        } else if (!reference && !scene->check(gpu)) {
+            failed++;
+        }
+        if (sw != NULL) {
+            lv_draw_buf_destroy(sw);
+        }
+        if (gpu != NULL) {
+            lv_draw_buf_destroy(gpu);
+        }
+    }
+
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return failed == 0 ? 0 : 1;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static lv_obj_t * box_create(lv_obj_t * parent, int32_t x, int32_t y, int32_t w, int32_t h)
+{
+    // No theme styles, every scene sets exactly what it draws
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+static void scene_fill(lv_obj_t * scr)
+{
+    lv_obj_t * obj = box_create(scr, 40, 30, 300, 200);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xd04020), 0);
+
+    obj = box_create(scr, 200, 120, 240, 160);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_60, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x2060c0), 0);
+}
+
+static void scene_radius(lv_obj_t * scr)
+{
+    lv_obj_t * obj = box_create(scr, 20, 20, 260, 180);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x30a050), 0);
+    lv_obj_set_style_radius(obj, 36, 0);
+
+    obj = box_create(scr, 300, 100, 160, 160);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_80, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x8030c0), 0);
+    lv_obj_set_style_radius(obj, LV_RADIUS_CIRCLE, 0);
+}
+
+static void scene_border(lv_obj_t * scr)
+{
+    lv_obj_t * obj = box_create(scr, 30, 30, 280, 200);
+    lv_obj_set_style_border_width(obj, 8, 0);
+    lv_obj_set_style_border_color(obj, lv_color_hex(0x202020), 0);
+    lv_obj_set_style_border_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_radius(obj, 20, 0);
+
+    obj = box_create(scr, 240, 140, 200, 150);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xf0e0a0), 0);
+    lv_obj_set_style_border_width(obj, 3, 0);
+    lv_obj_set_style_border_color(obj, lv_color_hex(0xc02060), 0);
+    lv_obj_set_style_border_opa(obj, LV_OPA_70, 0);
+}
+
+static void scene_outline(lv_obj_t * scr)
+{
+    lv_obj_t * obj = box_create(scr, 60, 50, 300, 180);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xe0e0e0), 0);
+    lv_obj_set_style_radius(obj, 12, 0);
+    lv_obj_set_style_outline_width(obj, 5, 0);
+    lv_obj_set_style_outline_pad(obj, 4, 0);
+    lv_obj_set_style_outline_color(obj, lv_color_hex(0x2080f0), 0);
+    lv_obj_set_style_outline_opa(obj, LV_OPA_COVER, 0);
+}
+
+static void scene_translucent(lv_obj_t * scr)
+{
+    // Nothing opaque below, the layer keeps translucent pixels
+    lv_obj_set_style_bg_opa(scr, LV_OPA_TRANSP, 0);
+
+    lv_obj_t * obj = box_create(scr, 40, 40, 280, 200);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xff8000), 0);
+    lv_obj_set_style_radius(obj, 24, 0);
+
+    obj = box_create(scr, 160, 100, 280, 180);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_40, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x0040ff), 0);
+    lv_obj_set_style_border_width(obj, 6, 0);
+    lv_obj_set_style_border_color(obj, lv_color_hex(0xffffff), 0);
+    lv_obj_set_style_border_opa(obj, LV_OPA_60, 0);
+    lv_obj_set_style_radius(obj, 16, 0);
+}
+
+static void scene_shadow(lv_obj_t * scr)
+{
+    lv_obj_t * obj = box_create(scr, 50, 40, 220, 160);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xf0f0f0), 0);
+    lv_obj_set_style_radius(obj, 16, 0);
+    lv_obj_set_style_shadow_width(obj, 30, 0);
+    lv_obj_set_style_shadow_offset_x(obj, 8, 0);
+    lv_obj_set_style_shadow_offset_y(obj, 12, 0);
+    lv_obj_set_style_shadow_color(obj, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_60, 0);
+
+    obj = box_create(scr, 320, 150, 120, 120);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x40a0e0), 0);
+    lv_obj_set_style_radius(obj, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_shadow_width(obj, 16, 0);
+    lv_obj_set_style_shadow_spread(obj, 6, 0);
+    lv_obj_set_style_shadow_color(obj, lv_color_hex(0xc02060), 0);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_COVER, 0);
+}
+
+static void scene_label(lv_obj_t * scr)
+{
+    // Long enough to be above the unit's minimum area, wrapped to a few lines
+    lv_obj_t * label = lv_label_create(scr);
+    lv_obj_set_pos(label, 20, 20);
+    lv_obj_set_width(label, 420);
+    lv_obj_set_style_text_color(label, lv_color_hex(0x202020), 0);
+    lv_label_set_text(label, "The quick brown fox jumps over the lazy dog. 0123456789 "
+                             "Sphinx of black quartz, judge my vow! {}[]()<>@#%&*");
+
+    label = lv_label_create(scr);
+    lv_obj_set_pos(label, 40, 160);
+    lv_obj_set_width(label, 360);
+    lv_obj_set_style_text_color(label, lv_color_hex(0xc02060), 0);
+    lv_obj_set_style_text_opa(label, LV_OPA_60, 0);
+    lv_obj_set_style_text_letter_space(label, 2, 0);
+    lv_label_set_text(label, "Translucent text over a white background, with wider letter spacing");
+}
+
+static void scene_image(lv_obj_t * scr)
+{
+    lv_obj_t * img = lv_image_create(scr);
+    lv_obj_set_pos(img, 20, 20);
+    lv_image_set_src(img, &_image);
+
+    img = lv_image_create(scr);
+    lv_obj_set_pos(img, 180, 20);
+    lv_image_set_src(img, &_image);
+    lv_obj_set_style_image_opa(img, LV_OPA_50, 0);
+
+    // Smooth content, so filtering differences stay small when scaled
+    img = lv_image_create(scr);
+    lv_obj_set_pos(img, 320, 160);
+    lv_image_set_src(img, &_image);
+    lv_image_set_scale(img, LV_SCALE_NONE * 3 / 2);
+}
+
+static void scene_vector(lv_obj_t * scr)
+{
+    lv_obj_t * obj = box_create(scr, 40, 40, 400, 240);
+    lv_obj_add_event_cb(obj, vector_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+}
+
+static void vector_draw_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_current_target(e);
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+
+    lv_vector_dsc_t * dsc = lv_vector_dsc_create(lv_event_get_layer(e));
+    lv_vector_path_t * path = lv_vector_path_create(LV_VECTOR_PATH_QUALITY_MEDIUM);
+
+    lv_fpoint_t center = { (float)coords.x1 + 100.0f, (float)coords.y1 + 100.0f };
+    lv_vector_path_append_circle(path, &center, 80.0f, 80.0f);
+    lv_vector_dsc_set_fill_color(dsc, lv_color_hex(0x2080f0));
+    lv_vector_dsc_set_fill_opa(dsc, LV_OPA_COVER);
+    lv_vector_dsc_set_stroke_opa(dsc, LV_OPA_TRANSP);
+    lv_vector_dsc_add_path(dsc, path);
+
+    lv_vector_path_clear(path);
+    lv_area_t rect = { coords.x1 + 220, coords.y1 + 40, coords.x1 + 379, coords.y1 + 199 };
+    lv_vector_path_append_rect(path, &rect, 16.0f, 16.0f);
+    lv_vector_dsc_set_fill_color(dsc, lv_color_hex(0x30a050));
+    lv_vector_dsc_set_stroke_color(dsc, lv_color_hex(0x202020));
+    lv_vector_dsc_set_stroke_opa(dsc, LV_OPA_COVER);
+    lv_vector_dsc_set_stroke_width(dsc, 6.0f);
+    lv_vector_dsc_add_path(dsc, path);
+
+    lv_draw_vector(dsc);
+    lv_vector_path_delete(path);
+    lv_vector_dsc_delete(dsc);
+}
+
+static bool vector_check(const lv_draw_buf_t * buf)
+{
+    // Inside the circle, inside the rectangle, on its stroke and on the background between them
+    bool ok = probe(buf, 140, 140, 0x2080f0) && probe(buf, 340, 160, 0x30a050)
+              && probe(buf, 340, 80, 0x202020) && probe(buf, 250, 260, 0xffffff);
+    printf("%-12s colors %s\n", "vector", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+static bool probe(const lv_draw_buf_t * buf, int32_t x, int32_t y, uint32_t color)
+{
+    // ARGB8888 is stored as B, G, R, A
+    const uint8_t * px = buf->data + y * buf->header.stride + x * 4;
+    for (int32_t c = 0; c < 3; c++) {
+        int32_t expected = (int32_t)((color >> (c * 8)) & 0xff);
+        if (abs((int32_t)px[c] - expected) > LVGL_RAYLIB_TEST_MAX_DELTA) {
+            printf("%-12s pixel (%d, %d) is %02x%02x%02x, expected %06x\n", "vector", x, y, px[2], px[1], px[0], (unsigned)color);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void image_init(void)
+{
+    // Hue across, alpha down: smooth in both directions
+    for (uint32_t y = 0; y < LVGL_RAYLIB_TEST_IMAGE; y++) {
+        for (uint32_t x = 0; x < LVGL_RAYLIB_TEST_IMAGE; x++) {
+            uint32_t a = 255 - y;
+            uint32_t r = x * 2;
+            uint32_t g = 255 - x * 2;
+            uint32_t b = x + y;
+            _pixels[y * LVGL_RAYLIB_TEST_IMAGE + x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+
+    _image.header.magic = LV_IMAGE_HEADER_MAGIC;
+    _image.header.cf = LV_COLOR_FORMAT_ARGB8888;
+    _image.header.w = LVGL_RAYLIB_TEST_IMAGE;
+    _image.header.h = LVGL_RAYLIB_TEST_IMAGE;
+    _image.header.stride = LVGL_RAYLIB_TEST_IMAGE * 4;
+    _image.data_size = sizeof(_pixels);
+    _image.data = (const uint8_t *)_pixels;
+}
+
+static lv_draw_buf_t * render(const scene_t * scene, bool gpu, uint32_t * drawn)
+{
+    lvgl_raylib_draw_gpu_stats_t before;
+    lvgl_raylib_draw_gpu_stats_t after;
+    lvgl_raylib_draw_gpu_get_stats(&before);
+    lvgl_raylib_draw_gpu_set_enabled(gpu);
+
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_size(scr, LVGL_RAYLIB_TEST_WIDTH, LVGL_RAYLIB_TEST_HEIGHT);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+    scene->create(scr);
+    lv_obj_update_layout(scr);
+
+    lv_draw_buf_t * buf = lv_snapshot_take(scr, LV_COLOR_FORMAT_ARGB8888);
+    lv_obj_delete(scr);
+
+    lvgl_raylib_draw_gpu_get_stats(&after);
+    *drawn = *(const uint32_t *)((const uint8_t *)&after + scene->stat)
+             - *(const uint32_t *)((const uint8_t *)&before + scene->stat);
+    return buf;
+}
+
+static bool compare(const scene_t * scene, const lv_draw_buf_t * sw, const lv_draw_buf_t * gpu)
+{
+    if (sw->header.w != gpu->header.w || sw->header.h != gpu->header.h) {
+        printf("%-12s size differs\n", scene->name);
+        return false;
+    }
+
+    int32_t max_delta = 0;
+    int32_t max_x = 0;
+    int32_t max_y = 0;
+    uint64_t sum = 0;
+    for (uint32_t y = 0; y < sw->header.h; y++) {
+        const uint8_t * a = sw->data + y * sw->header.stride;
+        const uint8_t * b = gpu->data + y * gpu->header.stride;
+        for (uint32_t x = 0; x < sw->header.w; x++, a += 4, b += 4) {
+            // The color of fully transparent pixels is meaningless
+            int32_t channels = a[3] == 0 && b[3] == 0 ? 0 : 4;
+            for (int32_t c = 0; c < channels; c++) {
+                int32_t delta = abs((int32_t)a[c] - (int32_t)b[c]);
+                sum += (uint64_t)delta;
+                if (delta > max_delta) {
+                    max_delta = delta;
+                    max_x = (int32_t)x;
+                    max_y = (int32_t)y;
+                }
+            }
+        }
+    }
+
+    double mean = (double)sum / ((double)sw->header.w * sw->header.h * 4);
+    bool ok = max_delta <= scene->max_delta && mean <= LVGL_RAYLIB_TEST_MAX_MEAN;
+    printf("%-12s max delta %3d at (%d, %d), mean %.3f: %s\n", scene->name, max_delta, max_x, max_y, mean, ok ? "ok" : "FAILED");
+    return ok;
+}
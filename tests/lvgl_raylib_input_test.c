@@ -0,0 +1,143 @@
+/* Queues keys and characters through the GLFW callbacks and checks that one frame delivers
+ * all of them, in order.
+ *
+ *   lvgl_raylib_input_test
+ *
+ * The callbacks lvgl_raylib installed are fetched back from GLFW and called directly, as
+ * GLFW would when the keys arrive during a frame. Desktop (GLFW) builds only. */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "raylib.h"
+#include "lvgl.h"
+#include "lvgl_raylib.h"
+#include <GLFW/glfw3.h>
+
+/* private defines */
+
+#define LVGL_RAYLIB_TEST_WIDTH  320
+#define LVGL_RAYLIB_TEST_HEIGHT 240
+#define LVGL_RAYLIB_TEST_KEYS   8
+
+/* private prototypes */
+
+static bool test_keys(void);
+static bool test_text(void);
+static void key(int glfw_key);
+static void text(unsigned int codepoint);
+static void key_cb(lv_event_t * e);
+
+/* static variables */
+
+static GLFWwindow * _window;
+static GLFWkeyfun _key_fn;
+static GLFWcharfun _char_fn;
+static uint32_t _keys[LVGL_RAYLIB_TEST_KEYS * 2];
+static uint32_t _key_cnt;
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(void)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(LVGL_RAYLIB_TEST_WIDTH, LVGL_RAYLIB_TEST_HEIGHT, "lvgl_raylib_input_test");
+    lvgl_raylib_init(LVGL_RAYLIB_TEST_WIDTH, LVGL_RAYLIB_TEST_HEIGHT);
+
+    // Setting a callback returns the one it replaces, put lvgl_raylib's straight back
+    _window = (GLFWwindow *)GetWindowHandle();
+    _key_fn = glfwSetKeyCallback(_window, NULL);
+    glfwSetKeyCallback(_window, _key_fn);
+    _char_fn = glfwSetCharCallback(_window, NULL);
+    glfwSetCharCallback(_window, _char_fn);
+
+    int failed = 0;
+    if (_key_fn == NULL || _char_fn == NULL) {
+        printf("input callbacks not installed\n");
+        failed++;
+    } else {
+        failed += test_keys() ? 0 : 1;
+        failed += test_text() ? 0 : 1;
+    }
+
+    lvgl_raylib_deinit();
+    CloseWindow();
+    return failed == 0 ? 0 : 1;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool test_keys(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_add_event_cb(obj, key_cb, LV_EVENT_KEY, NULL);
+    lv_group_add_obj(lv_group_get_default(), obj);
+    lv_group_focus_obj(obj);
+    lvgl_raylib_process_events();
+
+    static const int keys[] = { GLFW_KEY_RIGHT, GLFW_KEY_LEFT, GLFW_KEY_UP, GLFW_KEY_DOWN };
+    static const uint32_t expected[] = { LV_KEY_RIGHT, LV_KEY_LEFT, LV_KEY_UP, LV_KEY_DOWN };
+    _key_cnt = 0;
+    for (int i = 0; i < LVGL_RAYLIB_TEST_KEYS; i++) {
+        key(keys[i % 4]);
+    }
+    lvgl_raylib_process_events();
+
+    bool ok = _key_cnt == LVGL_RAYLIB_TEST_KEYS;
+    for (uint32_t i = 0; ok && i < _key_cnt; i++) {
+        ok = _keys[i] == expected[i % 4];
+    }
+    printf("%-6s %u of %d keys in one frame %s\n", "keys", (unsigned)_key_cnt, LVGL_RAYLIB_TEST_KEYS, ok ? "ok" : "FAILED");
+
+    lv_obj_delete(obj);
+    return ok;
+}
+
+static bool test_text(void)
+{
+#if LV_USE_TEXTAREA
+    lv_obj_t * ta = lv_textarea_create(lv_screen_active());
+    lv_group_add_obj(lv_group_get_default(), ta);
+    lv_group_focus_obj(ta);
+    lvgl_raylib_process_events();
+
+    // Characters go in as runs, the keys between them still move the cursor in order
+    text('a');
+    key(GLFW_KEY_LEFT);
+    text('b');
+    key(GLFW_KEY_LEFT);
+    text('c');
+    text('d');
+    lvgl_raylib_process_events();
+
+    const char * result = lv_textarea_get_text(ta);
+    bool ok = strcmp(result, "cdba") == 0;
+    printf("%-6s \"%s\" %s\n", "text", result, ok ? "ok" : "FAILED");
+
+    lv_obj_delete(ta);
+    return ok;
+#else
+    return true;
+#endif
+}
+
+static void key(int glfw_key)
+{
+    _key_fn(_window, glfw_key, glfwGetKeyScancode(glfw_key), GLFW_PRESS, 0);
+    _key_fn(_window, glfw_key, glfwGetKeyScancode(glfw_key), GLFW_RELEASE, 0);
+}
+
+static void text(unsigned int codepoint)
+{
+    _char_fn(_window, codepoint);
+}
+
+static void key_cb(lv_event_t * e)
+{
+    if (_key_cnt < sizeof(_keys) / sizeof(_keys[0])) {
+        _keys[_key_cnt] = lv_event_get_key(e);
+    }
+    _key_cnt++;
+}
@@ -0,0 +1,335 @@
+/* Builds an asset pack for lvgl_raylib_pack_open().
+ *
+ *   lvgl_raylib_pack <out.pack> <asset>...
+ *
+ * An asset is an image file (any format raylib loads) or a TrueType font as
+ * font.ttf@size with an optional list of codepoint ranges, printable ASCII by default:
+ *
+ *   lvgl_raylib_pack ui.pack icons/home.png fonts/ui.ttf@18 fonts/ui.ttf@24:0x20-0x7e,0xb0
+ *
+ * Entries are named after the argument without its range list, e.g. "fonts/ui.ttf@24". */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "raylib.h"
+#include "src/lvgl_raylib_pack_format.h"
+
+// Same metrics as the runtime TTF fonts, see src/lvgl_raylib_font.c
+#define STB_TRUETYPE_IMPLEMENTATION
+#define STBTT_STATIC
+#include "external/stb_truetype.h"
+
+/* private types */
+
+typedef struct {
+    lvgl_raylib_pack_entry_t entry;
+    uint8_t * data;
+} asset_t;
+
+/* private prototypes */
+
+static bool pack_image(asset_t * asset, const char * path);
+static bool pack_font(asset_t * asset, const char * arg);
+static int parse_ranges(const char * ranges, int ** codepoints);
+static int compare_assets(const void * a, const void * b);
+static int compare_glyphs(const void * a, const void * b);
+static uint32_t align(uint32_t offset);
+
+/* PUBLIC IMPLEMENTATION */
+
+int main(int argc, char ** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <out.pack> <image | font.ttf@size[:ranges]>...\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    int asset_cnt = argc - 2;
+    asset_t * assets = calloc((size_t)asset_cnt, sizeof(asset_t));
+    if (assets == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    for (int i = 0; i < asset_cnt; i++) {
+        const char * arg = argv[i + 2];
+        bool ok = strchr(arg, '@') != NULL ? pack_font(&assets[i], arg) : pack_image(&assets[i], arg);
+        if (!ok) {
+            return 1;
+        }
+    }
+
+    // The runtime binary searches the index
+    qsort(assets, (size_t)asset_cnt, sizeof(asset_t), &compare_assets);
+    for (int i = 1; i < asset_cnt; i++) {
+        if (strcmp(assets[i - 1].entry.name, assets[i].entry.name) == 0) {
+            fprintf(stderr, "%s: listed twice\n", assets[i].entry.name);
+            return 1;
+        }
+    }
+
+    // Every entry starts on a page so it can be used straight from the mapping
+    uint32_t offset = align(sizeof(lvgl_raylib_pack_header_t) + (uint32_t)asset_cnt * sizeof(lvgl_raylib_pack_entry_t));
+    for (int i = 0; i < asset_cnt; i++) {
+        assets[i].entry.offset = offset;
+        offset = align(offset + assets[i].entry.size);
+    }
+
+    FILE * out = fopen(argv[1], "wb");
+    if (out == NULL) {
+        fprintf(stderr, "%s: cannot create\n", argv[1]);
+        return 1;
+    }
+    lvgl_raylib_pack_header_t header = { LVGL_RAYLIB_PACK_MAGIC, LVGL_RAYLIB_PACK_VERSION, (uint32_t)asset_cnt, 0 };
+    fwrite(&header, sizeof(header), 1, out);
+    for (int i = 0; i < asset_cnt; i++) {
+        fwrite(&assets[i].entry, sizeof(assets[i].entry), 1, out);
+    }
+    for (int i = 0; i < asset_cnt; i++) {
+        fseek(out, (long)assets[i].entry.offset, SEEK_SET);
+        fwrite(assets[i].data, 1, assets[i].entry.size, out);
+        free(assets[i].data);
+    }
+    // Pad the tail so the last entry ends on a page too
+    if (offset > 0) {
+        fseek(out, (long)offset - 1, SEEK_SET);
+        fputc(0, out);
+    }
+    bool failed = ferror(out) != 0;
+    failed |= fclose(out) != 0;
+    free(assets);
+    if (failed) {
+        fprintf(stderr, "%s: write failed\n", argv[1]);
+        return 1;
+    }
+
+    printf("%s: %d assets, %u bytes\n", argv[1], asset_cnt, offset);
+    return 0;
+}
+
+/* PRIVATE IMPLEMENTATION */
+
+static bool pack_image(asset_t * asset, const char * path)
+{
+    if (strlen(path) >= LVGL_RAYLIB_PACK_NAME_LEN) {
+        fprintf(stderr, "%s: name longer than %d characters\n", path, LVGL_RAYLIB_PACK_NAME_LEN - 1);
+        return false;
+    }
+    Image image = LoadImage(path);
+    if (!IsImageValid(image)) {
+        fprintf(stderr, "%s: cannot load image\n", path);
+        return false;
+    }
+
+    // Premultiplied B,G,R,A, what the runtime decoder produces too
+    ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    uint32_t size = (uint32_t)image.width * (uint32_t)image.height * 4;
+    uint8_t * data = malloc(size);
+    if (data == NULL) {
+        fprintf(stderr, "out of memory\n");
+        UnloadImage(image);
+        return false;
+    }
+    const uint8_t * src = image.data;
+    for (uint32_t i = 0; i < size; i += 4) {
+        uint8_t a = src[i + 3];
+        data[i + 0] = (uint8_t)((src[i + 2] * a) / 255);
+        data[i + 1] = (uint8_t)((src[i + 1] * a) / 255);
+        data[i + 2] = (uint8_t)((src[i + 0] * a) / 255);
+        data[i + 3] = a;
+    }
+
+    strcpy(asset->entry.name, path);
+    asset->entry.type = LVGL_RAYLIB_PACK_IMAGE;
+    asset->entry.size = size;
+    asset->entry.w = (uint32_t)image.width;
+    asset->entry.h = (uint32_t)image.height;
+    asset->entry.stride = (uint32_t)image.width * 4;
+    asset->data = data;
+    UnloadImage(image);
+    return true;
+}
+
+static bool pack_font(asset_t * asset, const char * arg)
+{
+    const char * at = strrchr(arg, '@');
+    const char * colon = strchr(at, ':');
+    size_t name_len = colon != NULL ? (size_t)(colon - arg) : strlen(arg);
+    if (name_len >= LVGL_RAYLIB_PACK_NAME_LEN) {
+        fprintf(stderr, "%s: name longer than %d characters\n", arg, LVGL_RAYLIB_PACK_NAME_LEN - 1);
+        return false;
+    }
+    char path[1024];
+    size_t path_len = (size_t)(at - arg);
+    if (path_len >= sizeof(path)) {
+        fprintf(stderr, "%s: path too long\n", arg);
+        return false;
+    }
+    memcpy(path, arg, path_len);
+    path[path_len] = '\0';
+    int font_size = atoi(at + 1);
+    if (font_size <= 0) {
+        fprintf(stderr, "%s: invalid font size\n", arg);
+        return false;
+    }
+
+    int * codepoints = NULL;
+    int codepoint_cnt = parse_ranges(colon != NULL ? colon + 1 : "0x20-0x7e", &codepoints);
+    if (codepoint_cnt <= 0) {
+        fprintf(stderr, "%s: invalid codepoint ranges\n", arg);
+        return false;
+    }
+
+    int data_size = 0;
+    unsigned char * file_data = LoadFileData(path, &data_size);
+    stbtt_fontinfo info;
+    if (file_data == NULL || !stbtt_InitFont(&info, file_data, stbtt_GetFontOffsetForIndex(file_data, 0))) {
+        fprintf(stderr, "%s: cannot load font\n", path);
+        free(codepoints);
+        return false;
+    }
+
+    // Codepoints the font lacks are left out so LVGL falls back for them
+    int kept = 0;
+    for (int i = 0; i < codepoint_cnt; i++) {
+        if (stbtt_FindGlyphIndex(&info, codepoints[i]) != 0) {
+            codepoints[kept++] = codepoints[i];
+        }
+    }
+    GlyphInfo * glyphs = kept > 0 ? LoadFontData(file_data, data_size, font_size, codepoints, kept, FONT_DEFAULT) : NULL;
+    if (glyphs == NULL) {
+        fprintf(stderr, "%s: no glyphs rasterized\n", arg);
+        UnloadFileData(file_data);
+        free(codepoints);
+        return false;
+    }
+
+    int ascent, descent, line_gap;
+    stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
+    float scale = stbtt_ScaleForPixelHeight(&info, (float)font_size);
+    int32_t ascent_px = (int32_t)((float)ascent * scale);
+
+    uint32_t table_size = sizeof(lvgl_raylib_pack_font_t) + (uint32_t)kept * sizeof(lvgl_raylib_pack_glyph_t);
+    uint32_t size = table_size;
+    for (int i = 0; i < kept; i++) {
+        if (glyphs[i].value != ' ') {
+            size += (uint32_t)glyphs[i].image.width * (uint32_t)glyphs[i].image.height;
+        }
+    }
+    uint8_t * data = calloc(1, size);
+    if (data == NULL) {
+        fprintf(stderr, "out of memory\n");
+        UnloadFontData(glyphs, kept);
+        UnloadFileData(file_data);
+        free(codepoints);
+        return false;
+    }
+
+    lvgl_raylib_pack_font_t * font = (lvgl_raylib_pack_font_t *)data;
+    font->line_height = (int32_t)((float)(ascent - descent + line_gap) * scale + 0.5f);
+    font->base_line = (int32_t)((float)-descent * scale + 0.5f);
+    font->underline_position = -(font->base_line / 2);
+    font->underline_thickness = font_size / 14 > 1 ? font_size / 14 : 1;
+    font->glyph_cnt = (uint32_t)kept;
+
+    lvgl_raylib_pack_glyph_t * table = (lvgl_raylib_pack_glyph_t *)(font + 1);
+    uint32_t bitmap = table_size;
+    for (int i = 0; i < kept; i++) {
+        const GlyphInfo * g = &glyphs[i];
+        int32_t box_w = g->value == ' ' ? 0 : g->image.width;
+        int32_t box_h = g->value == ' ' ? 0 : g->image.height;
+        table[i].letter = (uint32_t)g->value;
+        table[i].adv_w = (int16_t)g->advanceX;
+        table[i].ofs_x = (int16_t)g->offsetX;
+        table[i].ofs_y = (int16_t)-(g->offsetY - ascent_px + box_h);
+        table[i].box_w = (uint16_t)box_w;
+        table[i].box_h = (uint16_t)box_h;
+        table[i].bitmap = bitmap;
+        if (box_w > 0 && box_h > 0) {
+            memcpy(data + bitmap, g->image.data, (size_t)box_w * box_h);
+        }
+        bitmap += (uint32_t)box_w * box_h;
+    }
+    qsort(table, (size_t)kept, sizeof(*table), &compare_glyphs);
+
+    memcpy(asset->entry.name, arg, name_len);
+    asset->entry.name[name_len] = '\0';
+    asset->entry.type = LVGL_RAYLIB_PACK_FONT;
+    asset->entry.size = size;
+    asset->entry.w = (uint32_t)font_size;
+    asset->entry.h = (uint32_t)kept;
+    asset->data = data;
+
+    UnloadFontData(glyphs, kept);
+    UnloadFileData(file_data);
+    free(codepoints);
+    return true;
+}
+
+static int parse_ranges(const char * ranges, int ** codepoints)
+{
+    int cnt = 0;
+    int cap = 0;
+    const char * p = ranges;
+    while (*p != '\0') {
+        char * end;
+        long first = strtol(p, &end, 0);
+        long last = first;
+        if (end == p) {
+            break;
+        }
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 0);
+            if (end == p + 1) {
+                break;
+            }
+            p = end;
+        }
+        if (first < 0 || last < first || last > 0x10FFFF) {
+            break;
+        }
+        for (long c = first; c <= last; c++) {
+            if (cnt == cap) {
+                cap = cap == 0 ? 128 : cap * 2;
+                int * grown = realloc(*codepoints, (size_t)cap * sizeof(int));
+                if (grown == NULL) {
+                    free(*codepoints);
+                    *codepoints = NULL;
+                    return -1;
+                }
+                *codepoints = grown;
+            }
+            (*codepoints)[cnt++] = (int)c;
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+    if (*p != '\0') {
+        free(*codepoints);
+        *codepoints = NULL;
+        return -1;
+    }
+    return cnt;
+}
+
+static int compare_assets(const void * a, const void * b)
+{
+    return strcmp(((const asset_t *)a)->entry.name, ((const asset_t *)b)->entry.name);
+}
+
+static int compare_glyphs(const void * a, const void * b)
+{
+    uint32_t la = ((const lvgl_raylib_pack_glyph_t *)a)->letter;
+    uint32_t lb = ((const lvgl_raylib_pack_glyph_t *)b)->letter;
+    return la < lb ? -1 : la > lb;
+}
+
+static uint32_t align(uint32_t offset)
+{
+    return (offset + LVGL_RAYLIB_PACK_ALIGN - 1) & ~(uint32_t)(LVGL_RAYLIB_PACK_ALIGN - 1);
+}